@@ -0,0 +1,113 @@
+# pragma once
+
+/**
+ * @file routing_cache.h
+ * @brief The on-disk cache of the shortest path tables of graph topologies.
+ */
+
+# ifndef _ROUTING_CACHE_H_
+# define _ROUTING_CACHE_H_ 1
+
+# include <cstdint>
+# include <string>
+
+# include "alg/shortest_path_routing.h"
+
+/**
+ * @brief The header of a routing cache file
+ * @note The header is followed by the delay and energy tables, the link delays, the routing table,
+ *  the offsets of the ports of every router and the neighbour ports and neighbours of the links,
+ *  each a flat array in the byte order of the machine that wrote the file.
+ */
+struct RoutingCacheHeader {
+
+    char magic[8];
+
+    std::uint32_t version;
+
+    std::uint32_t vertex_count;
+
+    /**
+     * @brief The number of ports of all routers, the local ports included
+     */
+    std::uint32_t link_count;
+
+    std::uint32_t reserved;
+
+    /**
+     * @brief The key the tables were stored under
+     */
+    std::uint64_t key;
+
+};
+
+/**
+ * @brief A directory of shortest path tables, one file per key, named after the key
+ * @note Keys are hashes of the contents of the files the tables are computed from, so editing a topology
+ *  only misses the cache. Files are written to a temporary name and renamed, so runs sharing
+ *  the directory never read a partial file.
+ */
+class RoutingCache {
+
+private:
+
+    std::string dir_;
+
+    std::string getFname(std::uint64_t key) const;
+
+public:
+
+    /**
+     * @brief Open a cache directory, created on the first store
+     * @param dir The directory, empty to disable the cache
+     */
+    explicit RoutingCache(const std::string& dir);
+
+    bool isEnabled() const;
+
+    /**
+     * @brief The hash of nothing, the FNV-1a offset basis
+     */
+    static constexpr std::uint64_t HASH_SEED = 0xcbf29ce484222325ULL;
+
+    /**
+     * @brief Continue a hash with the contents of a file, with FNV-1a
+     * @param fname The file
+     * @param seed The hash to continue
+     */
+    static std::uint64_t hashFile(const std::string& fname, std::uint64_t seed);
+
+    /**
+     * @brief Continue a hash with a value, with FNV-1a
+     * @param value The value
+     * @param seed The hash to continue
+     */
+    static std::uint64_t hashValue(std::uint64_t value, std::uint64_t seed);
+
+    /**
+     * @brief Get the key of the tables of a topology file
+     * @note The key covers the format of the cache and the constants the tables depend on.
+     */
+    static std::uint64_t getTopologyKey(const std::string& topo_file_path);
+
+    /**
+     * @brief Load the tables stored under a key
+     * @param key The key
+     * @param vertex_count The number of vertices the tables should have
+     * @return Whether the tables were found, the arguments are left untouched otherwise
+     */
+    bool load(std::uint64_t key, std::size_t vertex_count,
+        ShortestPath::TMatrix& delayTable, ShortestPath::TMatrix& energyTable,
+        ShortestPath::TIntMatrix& routingTable, ShortestPath::TPortMap& portMap) const;
+
+    /**
+     * @brief Store the tables under a key, replacing those stored before
+     * @note Failures are logged, a run never stops because its tables could not be cached.
+     */
+    void store(std::uint64_t key, std::size_t vertex_count,
+        const ShortestPath::TMatrix& delayTable, const ShortestPath::TMatrix& energyTable,
+        const ShortestPath::TIntMatrix& routingTable, const ShortestPath::TPortMap& portMap) const;
+
+};
+
+# endif
@@ -12,6 +12,8 @@
 # include <boost/multi_array.hpp>
 # include <cmath>
 # include <limits>
+# include <memory>
+# include <vector>
 
 
 # include "graph.h"
@@ -23,6 +25,11 @@
 # define ROUTING_DELAY_0 (PIPELINE_STAGE_DELAY_0 * PIPELINE_STAGE_NUMBER)
 # define LINK_DELAY_0 WIRE_DELAY_
 
+/**
+ * @brief The fewest rows of the tables a worker relaxes, smaller tables take fewer workers
+ */
+# define SHORTEST_PATH_PARALLEL_ROWS 64
+
 
 
 namespace ShortestPath {
@@ -32,6 +39,27 @@ using TDelayMatrix = TMatrix;
 using TIntMatrix = boost::multi_array<int, 2>;
 using TNextHopTable = TIntMatrix;
 
+/**
+ * @brief A port of a router in a graph topology
+ */
+struct SLinkInfo {
+
+    /**
+     * @brief The port of the neighbour the link arrives at
+     */
+    TAddressNumber neighbourPort;
+
+    TimeType linkDelay;
+
+    TAddressNumber neighbour;
+
+};
+
+/**
+ * @brief The ports of every router, the local port 0 first
+ */
+using TPortMap = std::unique_ptr<std::vector<SLinkInfo>[]>;
+
 /**
  * @brief Reset the matrix with integer elements.
  * @param table The matrix to be reset.
@@ -56,8 +84,27 @@ void resetMatrix(TMatrix& matrix, size_t n, double value);
  * @param delayTable The delay table.
  * @param energyTable The energy table.
  * @param nextHop The next hop table.
+ * @param thread_num The number of threads the rows are split among, 0 for one per core.
+ * @note The tables do not depend on the number of threads.
+ */
+void calculateShortestPathTables(GraphLib::graph_t& g, TMatrix& delayTable, TMatrix& energyTable, TNextHopTable& nextHop,
+    std::size_t thread_num = 0);
+
+
+/**
+ * @brief Update the shortest path tables of a graph for edges added to it.
+ * @param g The graph, the edges added included.
+ * @param edges The edges added, in the order they were added.
+ * @param delayTable The delay table of the graph without the edges.
+ * @param energyTable The energy table of the graph without the edges.
+ * @param nextHop The next hop table of the graph without the edges.
+ * @return Whether the tables were updated. An edge making a loop, or linking two routers linked already,
+ *  is not added incrementally; the tables are left untouched and should be calculated again.
+ * @note Only the rows of the routers some path of which is shortened are updated. The paths are as short
+ *  as those calculated from scratch, though another one of two paths as short may be taken.
  */
-void calculateShortestPathTables(GraphLib::graph_t& g, TMatrix& delayTable, TMatrix& energyTable, TNextHopTable& nextHop);
+bool addShortestPathEdges(GraphLib::graph_t& g, const std::vector<GraphLib::edge_t>& edges,
+    TMatrix& delayTable, TMatrix& energyTable, TNextHopTable& nextHop);
 
 };
 
@@ -6,9 +6,12 @@
 # include "global_defines/defines.h"
 # include "global_defines/packet_defines.h"
 # include "global_defines/RGen.h"
+# include "global_defines/address_table.h"
 # include "global_defines/proto_engine.h"
 # include "global_defines/message_define.h"
+# include "global_defines/flit_pool.h"
 # include "global_defines/input_trace.h"
+# include "global_defines/delay_sink.h"
 # include "global_defines/SStd.h"
 
 # include "logger/logger.hpp"
@@ -16,44 +19,115 @@
 namespace Global {
 
 /**
- * @brief The Random number generator
+ * @brief The state of one simulation
+ * @note Each thread runs the simulation its `context` points to,
+ *  so that one process can run several simulations side by side.
  */
-inline RGen RandomGen;
+struct Context {
+
+    /**
+     * @brief The Random number generator
+     */
+    RGen RandomGen;
+
+    /**
+     * @brief The addresses of the routers, held by the simulation and its trace
+     */
+    const AddressTable* addressTable = nullptr;
+
+    /**
+     * @brief Inputtrace
+     */
+    InputTrace* inputTrace = nullptr;
+
+    /**
+     * @brief The writer of the delay file, owned by the simulation
+     */
+    DelaySink* delaySink = nullptr;
+
+    /**
+     * @brief The message queue
+     */
+    MessQueue messageQueue;
+
+    /**
+     * @brief The arena of the flits in flight
+     */
+    FlitPool flitPool;
+
+    /**
+     * @brief The total fin number of packets
+     */
+    std::size_t TotalFin = 0;
+
+    /**
+     * @brief Routing period set.
+     */
+    std::unordered_set<TimeType> RoutingPeriods;
+
+    /**
+     * @brief Abandoned packet IDs.
+     */
+    std::unordered_set<TPacketId> AbandonedPackets;
+
+    /**
+     * @brief The vc mask
+     */
+    std::vector<u_int64_t> VC_MASK;
+
+};
 
 /**
- * @brief Inputtrace
+ * @brief The context of a process running a single simulation
  */
-inline InputTrace* inputTrace = nullptr;
+inline Context MainContext;
 
 /**
- * @brief The message queue
+ * @brief The context of the simulation run by this thread
  */
-inline MessQueue messageQueue;
+inline thread_local Context* context = &MainContext;
 
 /**
  * @brief The simulation current time
+ * @note Thread local, so that every partition of the parallel engine keeps its own clock.
  */
-inline TimeType CurrTime = 0;
+inline thread_local TimeType CurrTime = 0;
 
-/**
- * @brief The total fin number of packets
- */
-inline std::size_t TotalFin = 0;
+inline RGen& RandomGen() {
+    return Global::context->RandomGen;
+}
 
-/**
- * @brief Routing period set.
- */
-inline std::unordered_set<TimeType> RoutingPeriods;
+inline const AddressTable*& addressTable() {
+    return Global::context->addressTable;
+}
 
-/**
- * @brief Abandoned packet IDs.
- */
-inline std::unordered_set<TPacketId> AbandonedPackets;
+inline InputTrace*& inputTrace() {
+    return Global::context->inputTrace;
+}
 
-/**
- * @brief The vc mask
- */
-inline std::vector<u_int64_t> VC_MASK;
+inline DelaySink*& delaySink() {
+    return Global::context->delaySink;
+}
+
+inline MessQueue& messageQueue() {
+    return Global::context->messageQueue;
+}
+
+inline FlitPool& flitPool() {
+    return Global::context->flitPool;
+}
+
+inline std::unordered_set<TimeType>& RoutingPeriods() {
+    return Global::context->RoutingPeriods;
+}
+
+inline std::unordered_set<TPacketId>& AbandonedPackets() {
+    return Global::context->AbandonedPackets;
+}
+
+inline std::vector<u_int64_t>& VC_MASK() {
+    return Global::context->VC_MASK;
+}
 
 /**
  * @brief Get the current time of the simulation
@@ -79,14 +153,14 @@ inline void setCurrTime(TimeType time) {
  * @return The total fin number of packets
  */
 inline std::size_t getTotalFin() {
-    return Global::TotalFin;
+    return Global::context->TotalFin;
 }
 
 /**
  * @brief Increase the total fin number of packets
  */
 inline void incTotalFin() {
-    Global::TotalFin += 1;
+    Global::context->TotalFin += 1;
 }
 
 /**
@@ -10,6 +10,7 @@
 
 # include <random>
 # include <cassert>
+# include <cstdlib>
 # include <iostream>
 # include <memory>
 
@@ -24,7 +25,21 @@ private:
     
     std::random_device rd;
 
-    std::unique_ptr<long> seed_;
+    /**
+     * @brief The state of the seeded sequence, the same as `srandom`/`random` draw
+     *  from the process-wide state, but owned by this generator
+     */
+    struct SeededState {
+        random_data data;
+        char buffer[RGEN_STATE_SIZE_];
+    };
+
+    std::unique_ptr<SeededState> seeded_;
+
+    /**
+     * @brief A private stream, used instead of the process-wide `random()` state when set
+     */
+    std::unique_ptr<std::mt19937_64> stream_;
 
 public:
     
@@ -53,6 +68,13 @@ public:
      */
     void reset_seed();
 
+    /**
+     * @brief Switch to a private stream, so that draws from this generator
+     *  never touch the state shared by other generators.
+     * @param seed The seed of the stream
+     */
+    void reset_stream(unsigned long long seed);
+
     /**
      * @brief Get a random double number in [0, 1).
      * @return Random double number in [0, 1).
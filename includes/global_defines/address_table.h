@@ -0,0 +1,68 @@
+# pragma once
+
+/**
+ * @file address_table.h
+ * @brief The addresses of the routers, indexed by their dense IDs.
+ */
+
+# ifndef _ADDRESS_TABLE_H_
+# define _ADDRESS_TABLE_H_ 1
+
+# include <cstddef>
+# include <vector>
+
+# include "global_defines/defines.h"
+
+/**
+ * @brief The addresses of the routers of a network, in row-major order
+ * @note The simulation refers to routers by `RouterId` only, addresses are looked up here when
+ *  the routing algorithms need coordinates and converted back at the trace and delay file boundary.
+ */
+class AddressTable {
+
+private:
+
+    std::size_t dimension_;
+
+    long ary_;
+
+    std::vector<AddrType> addresses_;
+
+public:
+
+    /**
+     * @brief Enumerate the addresses of a network
+     * @param dimension The number of coordinates of an address
+     * @param ary The number of routers along each dimension
+     */
+    AddressTable(std::size_t dimension, long ary);
+
+    /**
+     * @brief Get the number of routers
+     */
+    std::size_t size() const {
+        return this->addresses_.size();
+    }
+
+    std::size_t getDimension() const;
+
+    long getAryNumber() const;
+
+    /**
+     * @brief Get the address of a router
+     * @param id The ID of the router
+     */
+    const AddrType& getAddress(RouterId id) const {
+        return this->addresses_[id];
+    }
+
+    /**
+     * @brief Get the ID of the router at an address
+     * @param address The address
+     * @return The ID, or `INVALID_ROUTER_ID_` if the address is not in the network
+     */
+    RouterId getId(const AddrType& address) const;
+
+};
+
+# endif
@@ -0,0 +1,134 @@
+# pragma once
+
+/**
+ * @file binary_trace.h
+ * @brief The binary, columnar trace format.
+ */
+
+# ifndef _BINARY_TRACE_H_
+# define _BINARY_TRACE_H_ 1
+
+# include <cstdint>
+# include <string>
+
+# include "global_defines/defines.h"
+# include "global_defines/mapped_file.h"
+
+/**
+ * @brief The header of a binary trace
+ * @note The header is followed by one column per field, each holding a value per record:
+ *  start_time (double), des_time (double, protocol traces only), src_addr and des_addr
+ *  (`dimension` int32 each), packet_size (int32) and proto_dsc (int32, protocol traces only).
+ *  Values are stored in the byte order of the machine that wrote the file.
+ */
+struct BinaryTraceHeader {
+
+    char magic[8];
+
+    std::uint32_t version;
+
+    std::uint32_t dimension;
+
+    std::uint64_t record_count;
+
+    /**
+     * @brief `BINARY_TRACE_PROTOCOL_` for traces of the sync protocol
+     */
+    std::uint32_t flags;
+
+    std::uint32_t reserved;
+
+};
+
+/**
+ * @brief A binary trace mapped into memory
+ */
+class BinaryTrace {
+
+private:
+
+    MappedFile file_;
+
+    const BinaryTraceHeader* header_;
+
+    const double* start_time_;
+
+    const double* des_time_;
+
+    const std::int32_t* src_addr_;
+
+    const std::int32_t* des_addr_;
+
+    const std::int32_t* packet_size_;
+
+    const std::int32_t* proto_dsc_;
+
+public:
+
+    /**
+     * @brief Map a binary trace
+     * @param fname The trace file
+     */
+    explicit BinaryTrace(const std::string& fname);
+
+    /**
+     * @brief Take over a mapped binary trace
+     * @param file The mapped trace
+     * @param fname The trace file, for errors
+     */
+    BinaryTrace(MappedFile&& file, const std::string& fname);
+
+    /**
+     * @brief Get the number of records
+     */
+    std::size_t size() const;
+
+    std::size_t getDimension() const;
+
+    bool isProtocol() const;
+
+    TimeType getStartTime(std::size_t index) const;
+
+    /**
+     * @brief Get the destination time of a record of a protocol trace
+     */
+    TimeType getDesTime(std::size_t index) const;
+
+    void getSrcAddr(std::size_t index, AddrType& address) const;
+
+    void getDesAddr(std::size_t index, AddrType& address) const;
+
+    long getPacketSize(std::size_t index) const;
+
+    /**
+     * @brief Get the protocol description of a record of a protocol trace
+     */
+    long getProtoDsc(std::size_t index) const;
+
+    /**
+     * @brief Whether a file is a binary trace
+     * @param fname The file
+     */
+    static bool isBinary(const std::string& fname);
+
+    /**
+     * @brief Whether the contents of a file are a binary trace
+     * @param data The contents
+     * @param size The size of the contents
+     */
+    static bool isBinary(const char* data, std::size_t size);
+
+    /**
+     * @brief Convert a text trace to a binary trace
+     * @param text_fname The text trace, in the format read by `InputTrace`
+     * @param binary_fname The binary trace
+     * @param dimension The dimension of the addresses
+     * @param sync_protocol Whether the text trace holds the transactions of the sync protocol
+     * @return The number of records
+     */
+    static std::size_t convert(const std::string& text_fname, const std::string& binary_fname,
+        std::size_t dimension, bool sync_protocol);
+
+};
+
+# endif
@@ -13,6 +13,9 @@
 # include <unordered_set>
 # include <limits>
 # include <sstream>
+# include <cstdint>
+
+# include "global_defines/inline_vector.h"
 
 // # define REPORT_PERIOD_ 1e10
 // # define FILTERING
@@ -43,6 +46,32 @@
 # define VC_NULL                                (VCType(-1, -1))
 # define LOCAL_INPUT_TIME_0                     (std::numeric_limits<TimeType>::infinity())
 # define VIRTUAL_CHANNEL_COUNT_0                (2)
+# define MESS_TYPE_NUMBER                       5
+# define MAX_DIMENSION_                         4
+# define CALENDAR_BUCKET_NUMBER                 4096
+# define INVALID_FLIT_HANDLE_                   (std::numeric_limits<FlitHandle>::max())
+# define INVALID_ROUTER_ID_                     (std::numeric_limits<RouterId>::max())
+# define PIPELINE_MIN_ROUTERS_                  16
+# define RGEN_STATE_SIZE_                       128
+# define BINARY_TRACE_MAGIC_                    "POPTRACE"
+# define BINARY_TRACE_VERSION_                  1
+# define BINARY_TRACE_PROTOCOL_                 0x1
+# define TRACE_PARSE_CHUNK_                     (1 << 20)
+# define TRACE_READ_AHEAD_                      (1 << 20)
+# define LIVE_TRACE_READ_SIZE_                  (1 << 16)
+# define LIVE_TRACE_REPOLL_MS_                  1000
+# define DELAY_SINK_BUFFER_                     (1 << 20)
+# define DELAY_SINK_MAGIC_                      "POPDELAY"
+# define DELAY_SINK_VERSION_                    1
+# define DELAY_SINK_SLOTS_                      64
+# define DELAY_SINK_PROGRESS_BITS_              40
+# define EVENT_TRACE_BUFFER_                    (1 << 16)
+# define EVENT_TRACE_MAGIC_                     "POPEVENT"
+# define EVENT_TRACE_VERSION_                   1
+# define TELEMETRY_MAGIC_                       "POPTELEM"
+# define TELEMETRY_VERSION_                     1
+# define ROUTING_CACHE_MAGIC_                   "POPROUTE"
+# define ROUTING_CACHE_VERSION_                 2
 
 # define SPD_LAUNCH                             0x10000
 # define SPD_BARRIER                            0x20000
@@ -74,7 +103,7 @@ using TimeType = double;
 
 using TAddressNumber = long;
 
-using AddrType = std::vector<long>;
+using AddrType = InlineVector<long, MAX_DIMENSION_>;
 
 using VCType = std::pair<long, long>;
 
@@ -88,6 +117,13 @@ using TFlitId = long;
 
 using TPacketId = std::size_t;
 
+using FlitHandle = std::uint32_t;
+
+/**
+ * @brief The dense index of a router, its position in the row-major order of the addresses.
+ */
+using RouterId = std::uint32_t;
+
 /**
  * @brief Message type.
  */
@@ -104,6 +140,72 @@ enum class MessType: unsigned char {
  */
 std::ostream& operator<<(std::ostream& os, const MessType& MessType_);
 
+/**
+ * @brief Event queue engine type.
+ */
+enum class EventQueueType {
+    HEAP = 0,
+    CALENDAR = 1
+};
+
+/**
+ * @brief operator<< overload for `EventQueueType`.
+ */
+std::ostream& operator<<(std::ostream& os, const EventQueueType& EventQueueType_);
+
+/**
+ * @brief Layout of the per-VC router state.
+ */
+enum class StateLayoutType {
+    PER_ROUTER = 0,
+    NETWORK = 1
+};
+
+/**
+ * @brief operator<< overload for `StateLayoutType`.
+ */
+std::ostream& operator<<(std::ostream& os, const StateLayoutType& StateLayoutType_);
+
+/**
+ * @brief The record format of the delay file.
+ */
+enum class DelayFormatType {
+    TEXT = 0,
+    BINARY = 1
+};
+
+/**
+ * @brief operator<< overload for `DelayFormatType`.
+ */
+std::ostream& operator<<(std::ostream& os, const DelayFormatType& DelayFormatType_);
+
+/**
+ * @brief Which routers a ROUTER event ticks.
+ */
+enum class RouterScheduleType {
+    FULL = 0,
+    ACTIVE = 1
+};
+
+/**
+ * @brief operator<< overload for `RouterScheduleType`.
+ */
+std::ostream& operator<<(std::ostream& os, const RouterScheduleType& RouterScheduleType_);
+
+/**
+ * @brief How the power of the routers and links is modelled.
+ */
+enum class PowerModeType {
+    FULL = 0,
+    ACTIVITY = 1,
+    OFF = 2
+};
+
+/**
+ * @brief operator<< overload for `PowerModeType`.
+ */
+std::ostream& operator<<(std::ostream& os, const PowerModeType& PowerModeType_);
+
 /**
  * @brief Routing type.
  */
@@ -0,0 +1,254 @@
+# pragma once
+
+/**
+ * @file delay_sink.h
+ * @brief The buffered writer of the delay file.
+ */
+
+# ifndef _DELAY_SINK_H_
+# define _DELAY_SINK_H_ 1
+
+# include <atomic>
+# include <condition_variable>
+# include <csignal>
+# include <cstdint>
+# include <mutex>
+# include <string>
+# include <thread>
+# include <vector>
+
+# include "global_defines/defines.h"
+
+/**
+ * @brief The header of a binary delay file
+ * @note The header is followed by records, each starting with a `DelayRecordKind` (uint32):
+ *  a packet holds start_time (int64), src_addr and des_addr (`dimension` int32 each) and delay (double);
+ *  a transaction holds src_time (int64), src_addr and des_addr, proto_desc (int64), a count (uint32)
+ *  and as many delays (int64). Values are stored in the byte order of the machine that wrote the file.
+ */
+struct DelayFileHeader {
+
+    char magic[8];
+
+    std::uint32_t version;
+
+    std::uint32_t dimension;
+
+};
+
+/**
+ * @brief The kind of a record of a binary delay file
+ */
+enum class DelayRecordKind : std::uint32_t {
+    PACKET = 0,
+    TRANSACTION = 1,
+    /**
+     * @brief A transaction whose last packet was injected, written with a trailing -1 as text
+     */
+    TRANSACTION_INJECTED = 2
+};
+
+/**
+ * @brief The writer of the delay file of a simulation, opened once and written through a large buffer
+ * @note A full buffer is written by the calling thread, or handed to a writer thread in asynchronous mode.
+ *  Everything is written when the sink is flushed or destroyed, and what is buffered or still being written
+ *  is also written when the process crashes (SIGSEGV, SIGBUS, SIGFPE or SIGABRT).
+ */
+class DelaySink {
+
+private:
+
+    std::string fname_;
+
+    int fd_;
+
+    DelayFormatType format_;
+
+    std::size_t dimension_;
+
+    /**
+     * @brief The buffer records are appended to
+     * @note Never reallocated, so that a signal handler may write it.
+     */
+    std::vector<char> buffer_;
+
+    /**
+     * @brief The bytes of whole records in `buffer_`
+     */
+    std::size_t size_;
+
+    /**
+     * @brief What the crash handler writes: the records being written out, then the records buffered
+     */
+    struct CrashView {
+
+        std::atomic<const char*> data;
+
+        std::atomic<std::size_t> size;
+
+        std::atomic<const char*> pending;
+
+        std::atomic<std::size_t> pending_size;
+
+        /**
+         * @brief The drain `pending` was handed out by
+         */
+        std::atomic<std::uint64_t> drain;
+
+    };
+
+    /**
+     * @brief Two views, the one of `crash_generation_` published and the other one being filled
+     */
+    CrashView crash_views_[2];
+
+    /**
+     * @brief The number of views published, incremented by a release store once the next view is filled
+     */
+    std::atomic<std::uint64_t> crash_generation_;
+
+    /**
+     * @brief The drain being written out, shifted by `DELAY_SINK_PROGRESS_BITS_`, and how many of its bytes are in the file
+     * @note Tagged with the drain, so that the progress of a drain is never taken for that of the next one.
+     */
+    std::atomic<std::uint64_t> pending_written_;
+
+    /**
+     * @brief The number of buffers written out or handed to the writer thread
+     */
+    std::uint64_t drain_count_;
+
+    /**
+     * @brief A record being formatted
+     */
+    std::vector<char> record_;
+
+    bool async_;
+
+    std::mutex mutex_;
+
+    std::condition_variable cv_;
+
+    /**
+     * @brief The buffer handed to the writer thread
+     */
+    std::vector<char> pending_;
+
+    /**
+     * @brief The bytes of `pending_` left to write, 0 once the writer is done with it
+     */
+    std::size_t pending_size_;
+
+    bool stop_;
+
+    /**
+     * @brief The first error of the writer thread
+     */
+    std::string error_;
+
+    std::thread writer_;
+
+    /**
+     * @brief The slot of the sink in the registry of the crash handler, or -1
+     */
+    long slot_;
+
+    void writeAll(const char* data, std::size_t size);
+
+    /**
+     * @brief Write the records of a drain to the file, storing the progress into `pending_written_`
+     * @param drain The drain
+     */
+    void writeAll(const char* data, std::size_t size, std::uint64_t drain);
+
+    /**
+     * @brief Publish what the crash handler writes
+     * @param size The bytes of whole records in `buffer_`
+     * @param pending The records being written out, or null
+     * @param pending_size The bytes of `pending`
+     * @param drain The drain `pending` was handed out by
+     * @note Called by the simulating thread only.
+     */
+    void publishCrashView(std::size_t size, const char* pending, std::size_t pending_size, std::uint64_t drain);
+
+    /**
+     * @brief Publish the bytes of whole records in `buffer_`, with the records being written out unchanged
+     */
+    void publishCrashView(std::size_t size);
+
+    /**
+     * @brief Write out what a sink has buffered or is writing out, with async-signal-safe calls only
+     */
+    void writeOnCrash();
+
+    void writerLoop();
+
+    /**
+     * @brief Move the formatted record into the buffer, writing the buffer out first if it is full
+     */
+    void commitRecord();
+
+    void appendAddress(const AddrType& address);
+
+    template<typename T>
+    void appendValue(const T& value) {
+        const char* bytes = reinterpret_cast<const char*>(&value);
+        this->record_.insert(this->record_.end(), bytes, bytes + sizeof(T));
+    }
+
+    /**
+     * @brief Write the buffer out, or hand it to the writer thread
+     */
+    void drain();
+
+    static void crashHandler(int signal, siginfo_t* info, void* context);
+
+public:
+
+    /**
+     * @brief Open the delay file for appending
+     * @param fname The delay file
+     * @param format The record format
+     * @param dimension The dimension of the addresses
+     * @param async Whether full buffers are written by a writer thread
+     */
+    DelaySink(const std::string& fname, DelayFormatType format, std::size_t dimension, bool async);
+
+    DelaySink(const DelaySink&) = delete;
+
+    DelaySink& operator=(const DelaySink&) = delete;
+
+    /**
+     * @brief Flush and close the delay file
+     */
+    ~DelaySink();
+
+    /**
+     * @brief Record a packet delivered to its destination
+     * @param start_time The start time of the packet
+     * @param src_addr The source address
+     * @param des_addr The destination address
+     * @param delay The delay of the packet
+     */
+    void writePacket(TimeType start_time, const AddrType& src_addr, const AddrType& des_addr, TimeType delay);
+
+    /**
+     * @brief Record a transaction of the sync protocol
+     * @param src_time The start time of the transaction
+     * @param src_addr The source address
+     * @param des_addr The destination address
+     * @param proto_desc The protocol description
+     * @param delays The delays of the packets of the transaction
+     * @param injected Whether the record is written when the last packet is injected
+     */
+    void writeTransaction(TimeType src_time, const AddrType& src_addr, const AddrType& des_addr,
+        long proto_desc, const std::vector<TimeType>& delays, bool injected);
+
+    /**
+     * @brief Write everything recorded so far to the file
+     */
+    void flush();
+
+};
+
+# endif
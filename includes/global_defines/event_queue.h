@@ -0,0 +1,241 @@
+# pragma once
+
+/**
+ * @file event_queue.h
+ * @brief The event queue engines behind `MessQueue`.
+ */
+
+# ifndef _EVENT_QUEUE_H_
+# define _EVENT_QUEUE_H_ 1
+
+# include <array>
+# include <cstdint>
+# include <vector>
+# include <unordered_map>
+
+# include "global_defines/defines.h"
+# include "global_defines/message_define.h"
+
+/**
+ * @brief The interface of an event queue engine.
+ * @note Every engine pops events in the order given by `MessEvent::operator<`.
+ */
+class EventQueueEngine {
+
+public:
+
+    virtual ~EventQueueEngine() = default;
+
+    /**
+     * @brief Add an event.
+     * @param event The event, moved into the queue
+     */
+    virtual void push(MessEvent&& event) = 0;
+
+    /**
+     * @brief Get the earliest event.
+     */
+    virtual const MessEvent& top() const = 0;
+
+    /**
+     * @brief Remove the earliest event and return it.
+     */
+    virtual MessEvent take() = 0;
+
+    /**
+     * @brief Get the earliest event with the specified message type.
+     * @param mess_type The message type
+     */
+    virtual const MessEvent& top(MessType mess_type) const = 0;
+
+    /**
+     * @brief Remove the earliest event with the specified message type and return it.
+     * @param mess_type The message type
+     */
+    virtual MessEvent take(MessType mess_type) = 0;
+
+    /**
+     * @brief Remove all events.
+     */
+    virtual void clear() = 0;
+
+    /**
+     * @brief Remove all events with the specified message type.
+     * @param mess_type The message type
+     */
+    virtual void clear(MessType mess_type) = 0;
+
+    /**
+     * @brief Get the number of events.
+     */
+    virtual std::size_t size() const = 0;
+
+    /**
+     * @brief Get the number of events with the specified message type.
+     * @param mess_type The message type
+     */
+    virtual std::size_t size(MessType mess_type) const = 0;
+
+};
+
+/**
+ * @brief One binary heap per message type.
+ * @note `top()` compares the heads of all heaps.
+ * @note The heaps are plain vectors, so that the earliest event can be moved out.
+ */
+class HeapEventQueue: public EventQueueEngine {
+
+private:
+
+    using HeapType = std::vector<MessEvent>;
+
+    std::size_t size_;
+
+    std::unordered_map<MessType, HeapType, MessTypeHash> m_q_;
+
+public:
+
+    HeapEventQueue();
+
+    void push(MessEvent&& event) override;
+
+    const MessEvent& top() const override;
+
+    MessEvent take() override;
+
+    const MessEvent& top(MessType mess_type) const override;
+
+    MessEvent take(MessType mess_type) override;
+
+    void clear() override;
+
+    void clear(MessType mess_type) override;
+
+    std::size_t size() const override;
+
+    std::size_t size(MessType mess_type) const override;
+
+};
+
+/**
+ * @brief A calendar queue (timing wheel) of fixed-width buckets.
+ * @note The bucket width is the largest quantum dividing `WIRE_DELAY_`, `PIPE_DELAY_`
+ *  and `CREDIT_DELAY_`, so that most buckets hold events of a single time stamp.
+ * @note Events beyond the wheel horizon are kept in an overflow heap,
+ *  and moved into the wheel when the wheel reaches them.
+ */
+class CalendarEventQueue: public EventQueueEngine {
+
+private:
+
+    /**
+     * @brief A bucket, sorted in ascending order, with the popped prefix skipped.
+     */
+    struct Bucket {
+        std::size_t head = 0;
+        std::vector<MessEvent> events;
+        /**
+         * @brief The number of events of each type from `head` on
+         */
+        std::array<std::uint32_t, MESS_TYPE_NUMBER> type_count = {};
+    };
+
+    TimeType width_;
+
+    long long cur_;
+
+    std::size_t size_;
+
+    std::array<std::size_t, MESS_TYPE_NUMBER> type_size_;
+
+    std::vector<Bucket> wheel_;
+
+    /**
+     * @brief Min-heap (by `std::greater`) of the events beyond the wheel horizon.
+     */
+    std::vector<MessEvent> overflow_;
+
+    /**
+     * @brief The storage of the drained buckets, handed to the next bucket filled.
+     * @note Only a few buckets hold events at a time, so a handful of vectors grows to the largest bucket
+     *  and the wheel stops allocating once warmed up, instead of every bucket growing on its own.
+     */
+    std::vector<std::vector<MessEvent>> spare_;
+
+    /**
+     * @brief One bit per bucket of the wheel and message type, set while the bucket holds events of the type
+     * @note So that the earliest event of a type is found by scanning `CALENDAR_BUCKET_NUMBER / 64` words
+     *  from `cur_`, instead of the events of every bucket.
+     */
+    std::array<std::vector<std::uint64_t>, MESS_TYPE_NUMBER> type_bits_;
+
+    long long bucketIndex(TimeType time) const;
+
+    Bucket& bucket(long long index);
+
+    void insertIntoWheel(MessEvent&& event, long long index);
+
+    /**
+     * @brief Count an event added to a bucket of the wheel
+     */
+    void countEvent(long long index, MessType mess_type);
+
+    /**
+     * @brief Count an event removed from a bucket of the wheel
+     */
+    void uncountEvent(long long index, MessType mess_type);
+
+    /**
+     * @brief Find the earliest bucket holding events of a type
+     * @return The bucket index, or `cur_ - 1` if the wheel holds none
+     */
+    long long findBucket(MessType mess_type) const;
+
+    std::size_t find(MessType mess_type, long long& index) const;
+
+    /**
+     * @brief Move the events of the overflow heap that fall into the wheel horizon.
+     */
+    void refillFromOverflow();
+
+    /**
+     * @brief Advance `cur_` to the first non-empty bucket.
+     */
+    void advance();
+
+public:
+
+    /**
+     * @brief Construct a new CalendarEventQueue object
+     * @param width The bucket width
+     * @param bucket_number The number of buckets, should be a power of two
+     */
+    CalendarEventQueue(TimeType width, std::size_t bucket_number = CALENDAR_BUCKET_NUMBER);
+
+    void push(MessEvent&& event) override;
+
+    const MessEvent& top() const override;
+
+    MessEvent take() override;
+
+    const MessEvent& top(MessType mess_type) const override;
+
+    MessEvent take(MessType mess_type) override;
+
+    void clear() override;
+
+    void clear(MessType mess_type) override;
+
+    std::size_t size() const override;
+
+    std::size_t size(MessType mess_type) const override;
+
+    /**
+     * @brief Get the default bucket width.
+     * @return The largest quantum of which `WIRE_DELAY_`, `PIPE_DELAY_` and `CREDIT_DELAY_` are multiples
+     */
+    static TimeType defaultWidth();
+
+};
+
+# endif
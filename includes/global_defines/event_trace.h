@@ -0,0 +1,133 @@
+# pragma once
+
+/**
+ * @file event_trace.h
+ * @brief The binary record of the events of a simulation.
+ */
+
+# ifndef _EVENT_TRACE_H_
+# define _EVENT_TRACE_H_ 1
+
+# include <cstdint>
+# include <string>
+# include <vector>
+
+# include "global_defines/defines.h"
+
+/**
+ * @brief The header of an event trace
+ * @note The header is followed by `EventRecord`s, stored in the byte order of the machine that wrote the file.
+ */
+struct EventTraceHeader {
+
+    char magic[8];
+
+    std::uint32_t version;
+
+    /**
+     * @brief The number of routers, indexed by the records
+     */
+    std::uint32_t router_count;
+
+};
+
+/**
+ * @brief An event handled by the simulation
+ */
+struct EventRecord {
+
+    double time;
+
+    /**
+     * @brief The packet of the flit carried by a WIRE event, or -1
+     */
+    std::int64_t packet_id;
+
+    /**
+     * @brief The index of the router sending a WIRE or CREDIT event, or -1
+     */
+    std::int32_t src;
+
+    /**
+     * @brief The index of the router receiving a WIRE or CREDIT event, or -1
+     */
+    std::int32_t des;
+
+    std::int32_t pc;
+
+    std::int32_t vc;
+
+    /**
+     * @brief The `MessType` of the event
+     */
+    std::uint8_t type;
+
+    std::uint8_t reserved[7];
+
+};
+
+/**
+ * @brief The writer of an event trace, which can be filtered and converted with `popnet-trace events`
+ */
+class EventTrace {
+
+private:
+
+    std::string fname_;
+
+    int fd_;
+
+    std::vector<EventRecord> buffer_;
+
+    std::size_t count_;
+
+    void writeAll(const char* data, std::size_t size);
+
+public:
+
+    /**
+     * @brief Create the event trace, replacing an existing one
+     * @param fname The event trace
+     * @param router_count The number of routers
+     */
+    EventTrace(const std::string& fname, std::size_t router_count);
+
+    EventTrace(const EventTrace&) = delete;
+
+    EventTrace& operator=(const EventTrace&) = delete;
+
+    /**
+     * @brief Flush and close the event trace
+     */
+    ~EventTrace();
+
+    /**
+     * @brief Record an event
+     */
+    void record(const EventRecord& record) {
+        this->buffer_.push_back(record);
+        if (this->buffer_.size() == EVENT_TRACE_BUFFER_) {
+            this->flush();
+        }
+    }
+
+    /**
+     * @brief Record events, e.g. those buffered by a partition
+     */
+    void record(const std::vector<EventRecord>& records);
+
+    /**
+     * @brief Write everything recorded so far to the file
+     */
+    void flush();
+
+    /**
+     * @brief Get the number of events recorded
+     */
+    std::size_t getCount() const;
+
+    const std::string& getFname() const;
+
+};
+
+# endif
@@ -0,0 +1,88 @@
+# pragma once
+
+/**
+ * @file flit_pool.h
+ * @brief The arena holding every flit in flight.
+ */
+
+# ifndef _FLIT_POOL_H_
+# define _FLIT_POOL_H_ 1
+
+# include <vector>
+
+# include "global_defines/defines.h"
+# include "global_defines/packet_defines.h"
+
+/**
+ * @brief An arena of flits addressed by 32-bit handles.
+ * @note Buffers and events pass handles around, the flit itself never moves.
+ * @note A released slot keeps the storage of its payload, so that
+ *  injecting a flit into a recycled slot does not allocate.
+ * @note References returned by `get()` are invalidated by `allocate()`.
+ */
+class FlitPool {
+
+private:
+
+    std::vector<Flit> slots_;
+
+    std::vector<FlitHandle> free_;
+
+    std::size_t peak_;
+
+public:
+
+    FlitPool();
+
+    /**
+     * @brief Allocate a flit with an empty payload
+     * @param flit_id the flit ID
+     * @param flit_type the flit type
+     * @param src the source router
+     * @param des the destination router
+     * @param start_time the start time
+     * @param packet_id the packet ID
+     * @return The handle of the flit
+     */
+    FlitHandle allocate(long flit_id, FlitType flit_type,
+        RouterId src, RouterId des,
+        TimeType start_time, TPacketId packet_id);
+
+    /**
+     * @brief Return a flit to the pool
+     * @param handle The handle of the flit
+     */
+    void release(FlitHandle handle);
+
+    /**
+     * @brief Get the flit
+     * @param handle The handle of the flit
+     * @return The flit
+     */
+    Flit& get(FlitHandle handle);
+
+    /**
+     * @brief Get the flit (const)
+     * @param handle The handle of the flit
+     * @return The flit (const)
+     */
+    const Flit& get(FlitHandle handle) const;
+
+    /**
+     * @brief Get the number of flits in flight
+     */
+    std::size_t size() const;
+
+    /**
+     * @brief Get the largest number of flits in flight at the same time
+     */
+    std::size_t getPeakSize() const;
+
+    /**
+     * @brief Release every flit and the storage of the pool
+     */
+    void clear();
+
+};
+
+# endif
@@ -0,0 +1,149 @@
+# pragma once
+
+/**
+ * @file inline_vector.h
+ * @brief A vector with inline, fixed-capacity storage.
+ */
+
+# ifndef _INLINE_VECTOR_H_
+# define _INLINE_VECTOR_H_ 1
+
+# include <algorithm>
+# include <cstddef>
+# include <initializer_list>
+# include <stdexcept>
+
+/**
+ * @brief A vector whose elements live inside the object, so copying it never allocates.
+ * @tparam T The element type
+ * @tparam N The capacity
+ * @note Only the part of the `std::vector` interface used by the simulator is provided.
+ */
+template<typename T, std::size_t N>
+class InlineVector {
+
+private:
+
+    T data_[N];
+
+    std::size_t size_;
+
+public:
+
+    using value_type = T;
+    using size_type = std::size_t;
+    using iterator = T*;
+    using const_iterator = const T*;
+
+    InlineVector()
+    :   data_(),
+        size_(0)
+    {}
+
+    InlineVector(std::initializer_list<T> init)
+    :   data_(),
+        size_(0)
+    {
+        for (const T& value : init) {
+            this->push_back(value);
+        }
+    }
+
+    InlineVector& operator=(std::initializer_list<T> init) {
+        this->clear();
+        for (const T& value : init) {
+            this->push_back(value);
+        }
+        return *this;
+    }
+
+    size_type size() const {
+        return this->size_;
+    }
+
+    static constexpr size_type capacity() {
+        return N;
+    }
+
+    bool empty() const {
+        return this->size_ == 0;
+    }
+
+    /**
+     * @brief Check the capacity, the storage is never reallocated
+     * @param n The expected number of elements
+     */
+    void reserve(size_type n) {
+        if (n > N) {
+            throw std::length_error("InlineVector capacity exceeded.");
+        }
+    }
+
+    void resize(size_type n, const T& value = T()) {
+        this->reserve(n);
+        for (size_type i = this->size_; i < n; i++) {
+            this->data_[i] = value;
+        }
+        this->size_ = n;
+    }
+
+    void push_back(const T& value) {
+        this->reserve(this->size_ + 1);
+        this->data_[this->size_++] = value;
+    }
+
+    void clear() {
+        this->size_ = 0;
+    }
+
+    T& operator[](size_type i) {
+        return this->data_[i];
+    }
+
+    const T& operator[](size_type i) const {
+        return this->data_[i];
+    }
+
+    T& front() {
+        return this->data_[0];
+    }
+
+    const T& front() const {
+        return this->data_[0];
+    }
+
+    T& back() {
+        return this->data_[this->size_ - 1];
+    }
+
+    const T& back() const {
+        return this->data_[this->size_ - 1];
+    }
+
+    iterator begin() {
+        return this->data_;
+    }
+
+    iterator end() {
+        return this->data_ + this->size_;
+    }
+
+    const_iterator begin() const {
+        return this->data_;
+    }
+
+    const_iterator end() const {
+        return this->data_ + this->size_;
+    }
+
+    bool operator==(const InlineVector& another) const {
+        return this->size_ == another.size_ && std::equal(this->begin(), this->end(), another.begin());
+    }
+
+    bool operator!=(const InlineVector& another) const {
+        return !(*this == another);
+    }
+
+};
+
+# endif
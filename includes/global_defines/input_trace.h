@@ -5,15 +5,19 @@
 
 # include <filesystem>
 # include <fstream>
+# include <memory>
+# include <optional>
 # include <queue>
-# include <unordered_map>
 
 # include "global_defines/packet_defines.h"
 # include "global_defines/proto_engine.h"
 # include "global_defines/defines.h"
+# include "global_defines/address_table.h"
+# include "global_defines/binary_trace.h"
+# include "global_defines/live_trace_feed.h"
+# include "global_defines/trace_source.h"
 # include "logger/logger.hpp"
 
-using FileSizeType = decltype(std::filesystem::file_size(std::declval<const std::filesystem::path&>()));
 
 class InputTrace {
 
@@ -21,48 +25,166 @@ private:
 
     std::string trace_file_name_;
 
-    FileSizeType has_read_;
-
     bool sync_protocol_enable_;
 
     bool read_end;
 
     std::size_t count_;
 
-    std::unordered_map<
-        AddrType,
-        std::priority_queue<SPacket, std::vector<SPacket>, std::greater<SPacket>>,
-        AddrTypeHash
-    > router_traces_;
+    /**
+     * @brief The routers of the network, packets are queued by the ID of their source router
+     */
+    std::shared_ptr<const AddressTable> addresses_;
+
+    /**
+     * @brief The packets of every router, indexed by `RouterId`
+     */
+    std::vector<std::priority_queue<SPacket, std::vector<SPacket>, std::greater<SPacket>>> router_traces_;
     std::priority_queue<SPacket, std::vector<SPacket>, std::greater<SPacket>> input_traces_;
 
     std::size_t dimension_;
 
-    FileSizeType getFileSize(const std::string& trace_file_name);
-
     void readAddress(AddrType& address, std::ifstream& trace_file);
 
+    /**
+     * @brief Copy an address parsed by `TextTraceParser`
+     */
+    void copyAddress(AddrType& address, const long* values);
+
+    /**
+     * @brief How far ahead of the current time packets are read, or 0 to read the whole trace at once
+     */
+    TimeType window_;
+
+    /**
+     * @brief The text trace being streamed
+     */
+    std::shared_ptr<std::ifstream> stream_;
+
+    /**
+     * @brief The binary trace being streamed
+     */
+    std::shared_ptr<BinaryTrace> binary_;
+
+    /**
+     * @brief The index of the next record of `binary_`
+     */
+    std::size_t binary_next_;
+
+    /**
+     * @brief The next packet of the stream, read but not queued yet
+     */
+    std::optional<SPacket> next_;
+
+    /**
+     * @brief Whether a router ran out of packets with `TRACE_READ_AHEAD_` packets queued
+     */
+    bool read_ahead_full_;
+
+    /**
+     * @brief Queue the next packet of the stream, checking that the stream is sorted
+     */
+    void queueNextPacket();
+
+    /**
+     * @brief Open the stream and read its first packet
+     */
+    void openStream();
+
+    /**
+     * @brief Read the next packet of the stream into `next_`
+     */
+    void readNextPacket();
+
+    /**
+     * @brief The source of a trace read whole, kept open between reads
+     */
+    std::shared_ptr<TraceSource> source_;
+
+    /**
+     * @brief Queue the records of the source
+     * @param wait Whether to block until the source has records or ends
+     */
+    void takeSource(bool wait);
+
+    /**
+     * @brief Queue parsed records as packets, numbered after the packets read so far
+     */
+    void addRecords(const TraceRecords& records);
+
 public:
 
-    InputTrace(const std::string& trace_file_name, bool sync_protocol_enable, std::size_t dimension);
+    /**
+     * @brief Construct a new InputTrace object
+     * @param trace_file_name The trace
+     * @param sync_protocol_enable Whether the trace holds transactions of the sync protocol
+     * @param addresses The routers of the network
+     */
+    InputTrace(const std::string& trace_file_name, bool sync_protocol_enable,
+        std::shared_ptr<const AddressTable> addresses);
 
     void readTraceFile();
 
+    /**
+     * @brief Stream the trace instead of reading it at once
+     * @param window Packets starting before the current time plus this window are queued
+     * @note The trace should be sorted by start time. A router out of packets reads ahead to its next packet,
+     *  as it would find it in the whole trace, up to `TRACE_READ_AHEAD_` queued packets.
+     */
+    void setStreamWindow(TimeType window);
+
+    /**
+     * @brief Queue the packets of the stream up to the window ahead of a time
+     * @param now The current time
+     */
+    void advance(TimeType now);
+
+    /**
+     * @brief Follow a trace still being written, up to its -1, on a reader thread
+     * @param poll_interval How long to wait without a write notification before reading again, in ms,
+     *  or 0 to only read on notifications
+     * @note The trace may be a named pipe.
+     */
+    void setLive(long poll_interval);
+
+    /**
+     * @brief Read the trace, blocking until a live trace has a packet queued or ends
+     */
+    void waitForPackets();
+
+    /**
+     * @brief Get the system calls made on the trace, by the reader thread too
+     * @note A streamed trace is read through a buffered stream and is not counted.
+     */
+    std::size_t getSyscallCount() const;
+
+    /**
+     * @brief Get the routers of the network
+     */
+    const std::shared_ptr<const AddressTable>& getAddressTable() const;
+
+    /**
+     * @brief Queue a packet, setting the IDs of its routers
+     * @note An address outside the network is an error.
+     */
     void addTrace(const SPacket& packet);
 
     bool isEmpty();
 
-    bool isEmpty(const AddrType& address);
+    /**
+     * @brief Whether a router has no packet left, reading a streamed trace ahead to its next packet
+     */
+    bool isEmpty(RouterId router);
 
     bool isReadFin();
 
     void popFront();
 
-    void popFront(const AddrType& address);
+    void popFront(RouterId router);
 
     const SPacket& front() const;
 
-    const SPacket& front(const AddrType& address) const;
+    const SPacket& front(RouterId router) const;
 
 };
 
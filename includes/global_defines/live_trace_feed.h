@@ -0,0 +1,111 @@
+# pragma once
+
+/**
+ * @file live_trace_feed.h
+ * @brief The feed of a trace still being written by another process.
+ */
+
+# ifndef _LIVE_TRACE_FEED_H_
+# define _LIVE_TRACE_FEED_H_ 1
+
+# include <condition_variable>
+# include <exception>
+# include <mutex>
+# include <string>
+# include <thread>
+# include <vector>
+
+# include "global_defines/trace_source.h"
+
+/**
+ * @brief Follows a trace ending with -1 on a reader thread, handing its records over as they are written
+ * @note The trace is a regular file, watched with inotify, or a named pipe. The reader holds the
+ *  pipe open for writing too, so that writers may come and go until one writes the -1.
+ *  Records should end with a newline, since a token at the end of the data may still be growing.
+ */
+class LiveTraceFeed : public TraceSource {
+
+private:
+
+    std::string fname_;
+
+    TextTraceParser parser_;
+
+    /**
+     * @brief How long the reader waits without a write notification before reading again, in ms, or 0
+     */
+    long poll_interval_;
+
+    int fd_;
+
+    /**
+     * @brief The inotify descriptor of a regular file, or -1 for a pipe
+     */
+    int watch_fd_;
+
+    /**
+     * @brief The write end held on a pipe, or -1 for a regular file
+     */
+    int keep_fd_;
+
+    /**
+     * @brief Written to stop the reader
+     */
+    int stop_fd_[2];
+
+    /**
+     * @brief The bytes read but not parsed yet, ending inside a record
+     */
+    std::string pending_;
+
+    std::vector<char> buffer_;
+
+    std::mutex mutex_;
+
+    std::condition_variable ready_cv_;
+
+    /**
+     * @brief The records parsed but not taken yet
+     */
+    std::vector<TraceRecords> batches_;
+
+    /**
+     * @brief Whether the -1 was read
+     */
+    bool end_;
+
+    std::exception_ptr error_;
+
+    std::thread thread_;
+
+    void run();
+
+    /**
+     * @brief Read and parse what was written so far
+     * @return true once the -1 is read
+     */
+    bool readAvailable();
+
+public:
+
+    /**
+     * @brief Open a trace and start following it
+     * @param fname The trace file or named pipe
+     * @param dimension The dimension of the addresses
+     * @param sync_protocol Whether the records are transactions of the sync protocol
+     * @param poll_interval How long to wait without a write notification before reading again, in ms,
+     *  or 0 to only read on notifications
+     */
+    LiveTraceFeed(const std::string& fname, std::size_t dimension, bool sync_protocol, long poll_interval);
+
+    LiveTraceFeed(const LiveTraceFeed&) = delete;
+
+    LiveTraceFeed& operator=(const LiveTraceFeed&) = delete;
+
+    ~LiveTraceFeed();
+
+    bool read(TraceRecords& records, bool wait) override;
+
+};
+
+# endif
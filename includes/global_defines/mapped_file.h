@@ -0,0 +1,58 @@
+# pragma once
+
+/**
+ * @file mapped_file.h
+ * @brief A read-only file mapped into memory.
+ */
+
+# ifndef _MAPPED_FILE_H_
+# define _MAPPED_FILE_H_ 1
+
+# include <cstddef>
+# include <string>
+
+/**
+ * @brief A read-only file mapped into memory, unmapped on destruction
+ */
+class MappedFile {
+
+private:
+
+    void* data_;
+
+    std::size_t size_;
+
+    /**
+     * @brief The system calls made for the mapping, counting the unmapping to come
+     */
+    std::size_t syscalls_;
+
+public:
+
+    /**
+     * @brief Map a whole file
+     * @param fname The file
+     * @param sequential Whether the file is read once, front to back
+     */
+    explicit MappedFile(const std::string& fname, bool sequential = true);
+
+    MappedFile(const MappedFile&) = delete;
+
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    MappedFile(MappedFile&& other) noexcept;
+
+    ~MappedFile();
+
+    /**
+     * @brief Get the contents, or nullptr for an empty file
+     */
+    const char* data() const;
+
+    std::size_t size() const;
+
+    std::size_t getSyscallCount() const;
+
+};
+
+# endif
@@ -9,8 +9,7 @@
 # define _MESS_EVENT_H_ 1
 
 # include <vector>
-# include <queue>
-# include <unordered_map>
+# include <memory>
 # include <sstream>
 
 # include "global_defines/defines.h"
@@ -23,12 +22,13 @@ private:
 	
     TimeType start_time_;
 	MessType mess_type_;
-	AddrType src_addr_;
-	AddrType des_addr_;
+	RouterId src_;
+	RouterId des_;
     long pc_;
     long vc_;
     TimeType routing_period_;
-	Flit flit_;
+    std::uint64_t seq_;
+	FlitHandle flit_;
 
 public:
 
@@ -51,28 +51,16 @@ public:
     MessType getEventType() const;
 
     /**
-     * @brief Get the source address of the message event
-     * @return The source address of the message event
+     * @brief Get the source router of the message event
+     * @return The ID of the source router, or `INVALID_ROUTER_ID_` for EVG, ROUTER and RECONFIGURATION events
      */
-    AddrType& getSrc();
+    RouterId getSrc() const;
 
     /**
-     * @brief Get the source address of the message event (const version)
-     * @return The source address of the message event (const version)
+     * @brief Get the destination router of the message event
+     * @return The ID of the destination router, or `INVALID_ROUTER_ID_` for EVG, ROUTER and RECONFIGURATION events
      */
-    const AddrType& getSrc() const;
-    
-    /**
-     * @brief Get the destination address of the message event
-     * @return The destination address of the message event
-     */
-    AddrType& getDes();
-
-    /**
-     * @brief Get the destination address of the message event (const version)
-     * @return The destination address of the message event (const version)
-     */
-    const AddrType& getDes() const;
+    RouterId getDes() const;
 
     /**
      * @brief Get the PC of the message event
@@ -87,16 +75,16 @@ public:
     long getVC() const;
 
     /**
-     * @brief Get the flit of the message event
-     * @return The flit of the message event
+     * @brief Check if the message event carries a flit
+     * @return true for WIRE events, false otherwise
      */
-    Flit& getFlit();
+    bool hasFlit() const;
 
     /**
-     * @brief Get the flit of the message event (const version)
-     * @return The flit of the message event (const version)
+     * @brief Get the flit of the message event
+     * @return The handle of the flit in `Global::flitPool()`
      */
-    const Flit& getFlit() const;
+    FlitHandle getFlit() const;
 
     /**
      * @brief Get the routing period of the message event
@@ -104,6 +92,18 @@ public:
      */
     TimeType getRoutingPeriod() const;
 
+    /**
+     * @brief Set the sequence number of the message event
+     * @param seq The sequence number, assigned by `MessQueue` on insertion
+     */
+    void setSeq(std::uint64_t seq);
+
+    /**
+     * @brief Get the sequence number of the message event
+     * @return The sequence number of the message event
+     */
+    std::uint64_t getSeq() const;
+
     /**
      * @brief Construct a new MessEvent object
      * @param start_time The start time of the message event
@@ -116,50 +116,54 @@ public:
      * @brief Construct a new MessEvent object
      * @param start_time The start time of the message event
      * @param mess_type The type of the message event
-     * @param src_addr The source address of the message event
-     * @param des_addr The destination address of the message event
+     * @param src The source router of the message event
+     * @param des The destination router of the message event
      * @param pc The PC of the message event
      * @param vc The VC of the message event
      */
-    MessEvent(TimeType start_time, MessType mess_type, const AddrType& src_addr, const AddrType& des_addr, long pc, long vc);
+    MessEvent(TimeType start_time, MessType mess_type, RouterId src, RouterId des, long pc, long vc);
 
     /**
      * @brief Construct a new MessEvent object
      * @param start_time The start time of the message event
      * @param mess_type The type of the message event
-     * @param src_addr The source address of the message event
-     * @param des_addr The destination address of the message event
+     * @param src The source router of the message event
+     * @param des The destination router of the message event
      * @param pc The PC of the message event
      * @param vc The VC of the message event
-     * @param flit The flit of the message event
+     * @param flit The handle of the flit of the message event
      */
-    MessEvent(TimeType start_time, MessType mess_type, const AddrType& src_addr, const AddrType& des_addr, long pc, long vc, const Flit& flit);
+    MessEvent(TimeType start_time, MessType mess_type, RouterId src, RouterId des, long pc, long vc, FlitHandle flit);
 
     /**
-     * @brief Construct a new MessEvent object
-     * @param start_time The start time of the message event
-     * @param mess_type The type of the message event
-     * @param flit The flit of the message event
+     * @brief MessEvent is move-only, so that the flit handle has a single owner
      */
-    MessEvent(TimeType start_time, MessType mess_type, const Flit& flit);
+    MessEvent(const MessEvent& me) = delete;
 
-    /**
-     * @brief Construct a new MessEvent object
-     * @param me The MessEvent object to be copied
-     */
-    MessEvent(const MessEvent& me);
+    MessEvent& operator=(const MessEvent& me) = delete;
+
+    MessEvent(MessEvent&& me) = default;
+
+    MessEvent& operator=(MessEvent&& me) = default;
 
     /**
      * @brief operator<< overload for MessEvent
      */
     friend std::ostream& operator<<(std::ostream& os, const MessEvent& me);
 
+    /**
+     * @brief Compare two events by start time, then by type, then by insertion order
+     * @note Events at the same time are handled as RECONFIGURATION, WIRE, CREDIT, ROUTER, EVG,
+     *  so that flits and credits arriving at a cycle are visible to the pipeline of that cycle.
+     */
     bool operator<(const MessEvent& me) const;
 
     bool operator>(const MessEvent& me) const;
 
 };
 
+class EventQueueEngine;
+
 class MessQueue {
 
 public:
@@ -167,16 +171,20 @@ public:
     using size_type = std::vector<MessEvent>::size_type;
 
 private:
-    
-    size_type size_;
 
-    std::unordered_map<MessType,
-        std::priority_queue<MessEvent, std::vector<MessEvent>, std::greater<MessEvent>>,
-        MessTypeHash
-    > m_q_;
+    std::uint64_t seq_;
+
+    std::unique_ptr<EventQueueEngine> engine_;
 
 public:
 
+    /**
+     * @brief Select the event queue engine.
+     * @param type The engine type
+     * @note Pending events are moved to the new engine.
+     */
+    void setEngine(EventQueueType type);
+
     /**
      * @brief Clear the queue.
      */
@@ -190,12 +198,17 @@ public:
     /**
      * @brief Add a message to the queue.
      */
-    void addMessage(const MessEvent& event);
+    void addMessage(MessEvent&& event);
 
     /**
      * @brief Remove the top message from the queue.
      */
     void popFront();
+
+    /**
+     * @brief Remove the top message from the queue and return it.
+     */
+    MessEvent takeFront();
     
     /**
      * @brief Get the top message from the queue. (const version)
@@ -223,6 +236,11 @@ public:
      */
     size_type size() const;
 
+    /**
+     * @brief Get the size of the queue, with the specified message type.
+     */
+    size_type size(MessType mess_type) const;
+
     /**
      * @brief Update the start time of the samllest EVG event to the new time.
      * @param new_time The new time to be set
@@ -231,6 +249,8 @@ public:
 
     MessQueue();
 
+    ~MessQueue();
+
 };
 
 # endif
\ No newline at end of file
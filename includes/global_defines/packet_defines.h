@@ -26,6 +26,12 @@ public:
 	
     AddrType src_addr;
     AddrType des_addr;
+
+    /**
+     * @brief The routers of `src_addr` and `des_addr`, set when the packet is queued by `InputTrace`
+     */
+    RouterId src_id;
+    RouterId des_id;
 	
     long packet_size;
 	
@@ -35,6 +41,10 @@ public:
      */
     SPacket(std::size_t addr_size);
 
+    /**
+     * @brief Order packets by start time, then by their order in the trace
+     * @note The order of packets starting together does not depend on how many packets are queued.
+     */
     bool operator<(const SPacket& another) const;
 
     bool operator>(const SPacket& another) const;
@@ -78,8 +88,8 @@ private:
 	
     TFlitId flit_id_;
 	FlitType flit_type_;
-	AddrType src_addr_;
-	AddrType des_addr_;
+	RouterId src_;
+	RouterId des_;
 	TimeType start_time_;
 	TimeType send_finish_time_;
 	TimeType finish_time_;
@@ -103,28 +113,16 @@ public:
     FlitType getFlitType() const;
 	
     /**
-     * @brief Get the source address
-     * @return the source address
-     */
-    AddrType& getSrcAddr();
-	
-    /**
-     * @brief Get the source address (const)
-     * @return the source address (const)
+     * @brief Get the source router
+     * @return the ID of the source router
      */
-    const AddrType& getSrcAddr() const;
+    RouterId getSrc() const;
 	
     /**
-     * @brief Get the destination address
-     * @return the destination address
+     * @brief Get the destination router
+     * @return the ID of the destination router
      */
-    AddrType& getDesAddr();
-	
-    /**
-     * @brief Get the destination address (const)
-     * @return the destination address (const)
-     */
-    const AddrType& getDesAddr() const ;
+    RouterId getDes() const;
 
     /**
      * @brief Get the start time
@@ -193,24 +191,29 @@ public:
      * @brief Construct a new Flit object with the specified parameters
      * @param flit_id the flit ID
      * @param flit_type the flit type
-     * @param src_addr the source address
-     * @param des_addr the destination address
+     * @param src the source router
+     * @param des the destination router
      * @param start_time the start time
-     * @param data the data
+     * @param data the data, moved into the flit
      * @param packet_id the packet ID
      * @note The finish time is set to `0`.
      * @note The send finish time is set to `0`.
      */
     Flit(long flit_id_, FlitType flit_type,
-        const AddrType& sor_addr, const AddrType& des_addr,
-		TimeType start_time, const DataType& data,
+        RouterId src, RouterId des,
+		TimeType start_time, DataType data,
         TPacketId packet_id);
-	
+
     /**
-     * @brief Construct a new Flit object by copying another Flit object
-     * @param flit the flit object
+     * @brief Flits are copied and moved member-wise, moving a flit hands over its data
      */
-    Flit(const Flit& flit);
+    Flit(const Flit& flit) = default;
+
+    Flit(Flit&& flit) = default;
+
+    Flit& operator=(const Flit& flit) = default;
+
+    Flit& operator=(Flit&& flit) = default;
     
 };
 
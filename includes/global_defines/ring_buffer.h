@@ -0,0 +1,107 @@
+# pragma once
+
+/**
+ * @file ring_buffer.h
+ * @brief A FIFO over a contiguous, preallocated ring.
+ */
+
+# ifndef _RING_BUFFER_H_
+# define _RING_BUFFER_H_ 1
+
+# include <cstddef>
+# include <vector>
+
+/**
+ * @brief A FIFO queue stored in a power-of-two ring, so that push and pop never allocate.
+ * @tparam T The element type
+ * @note When the ring is full, it doubles its capacity instead of failing,
+ *  which only happens for buffers without a hard bound (the injection port).
+ */
+template<typename T>
+class RingBuffer {
+
+private:
+
+    std::vector<T> data_;
+
+    std::size_t head_;
+
+    std::size_t size_;
+
+    /**
+     * @brief Double the capacity, moving the elements to the front of the new ring
+     */
+    void grow() {
+        std::vector<T> data(this->data_.empty() ? 1 : this->data_.size() * 2);
+        for (std::size_t i = 0; i < this->size_; i++) {
+            data[i] = std::move(this->data_[(this->head_ + i) & (this->data_.size() - 1)]);
+        }
+        this->data_.swap(data);
+        this->head_ = 0;
+    }
+
+public:
+
+    /**
+     * @brief Construct a new RingBuffer object
+     * @param capacity The expected number of elements, rounded up to a power of two
+     */
+    explicit RingBuffer(std::size_t capacity = 0)
+    :   data_(),
+        head_(0),
+        size_(0)
+    {
+        this->reserve(capacity);
+    }
+
+    /**
+     * @brief Make room for at least `capacity` elements
+     * @param capacity The expected number of elements
+     */
+    void reserve(std::size_t capacity) {
+        while (this->data_.size() < capacity) {
+            this->grow();
+        }
+    }
+
+    std::size_t size() const {
+        return this->size_;
+    }
+
+    std::size_t capacity() const {
+        return this->data_.size();
+    }
+
+    bool empty() const {
+        return this->size_ == 0;
+    }
+
+    void push_back(const T& value) {
+        if (this->size_ == this->data_.size()) {
+            this->grow();
+        }
+        this->data_[(this->head_ + this->size_) & (this->data_.size() - 1)] = value;
+        this->size_ += 1;
+    }
+
+    T& front() {
+        return this->data_[this->head_];
+    }
+
+    const T& front() const {
+        return this->data_[this->head_];
+    }
+
+    void pop_front() {
+        this->head_ = (this->head_ + 1) & (this->data_.size() - 1);
+        this->size_ -= 1;
+    }
+
+    void clear() {
+        this->head_ = 0;
+        this->size_ = 0;
+    }
+
+};
+
+# endif
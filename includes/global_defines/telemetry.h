@@ -0,0 +1,156 @@
+# pragma once
+
+/**
+ * @file telemetry.h
+ * @brief The binary, columnar record of the activity of every router, report period by report period.
+ */
+
+# ifndef _TELEMETRY_H_
+# define _TELEMETRY_H_ 1
+
+# include <cstdint>
+# include <string>
+# include <vector>
+
+# include "global_defines/defines.h"
+
+/**
+ * @brief The header of a telemetry file
+ * @note The header is followed by a `TelemetryWindowHeader` and the columns of `TelemetryWindow` per window,
+ *  in the order they are declared, stored in the byte order of the machine that wrote the file.
+ */
+struct TelemetryHeader {
+
+    char magic[8];
+
+    std::uint32_t version;
+
+    std::uint32_t router_count;
+
+    /**
+     * @brief The number of ports of a router, the local port 0 included
+     */
+    std::uint32_t port_count;
+
+    std::uint32_t reserved;
+
+};
+
+/**
+ * @brief The time a window of a telemetry file covers
+ */
+struct TelemetryWindowHeader {
+
+    double start;
+
+    /**
+     * @brief The end of the window, a multiple of the report period but for the last window.
+     *  A window spans several report periods when no event happened in them.
+     */
+    double end;
+
+};
+
+/**
+ * @brief The activity of the routers during a window, one value per router unless noted
+ * @note The power is the average over the window, in the unit of the totals of the simulation.
+ */
+struct TelemetryWindow {
+
+    std::vector<double> buffer_power;
+
+    std::vector<double> crossbar_power;
+
+    std::vector<double> arbiter_power;
+
+    /**
+     * @brief The power of the link of every port, `port_count` values per router
+     */
+    std::vector<double> link_power;
+
+    /**
+     * @brief The average delay of the packets accepted in the window, or 0
+     */
+    std::vector<double> average_delay;
+
+    std::vector<std::uint32_t> injected_flits;
+
+    std::vector<std::uint32_t> accepted_flits;
+
+    std::vector<std::uint32_t> accepted_packets;
+
+    /**
+     * @brief The flits in the input buffers at the end of the window, the injection queue included
+     */
+    std::vector<std::uint32_t> input_flits;
+
+    /**
+     * @brief The flits in the output buffers at the end of the window
+     */
+    std::vector<std::uint32_t> output_flits;
+
+    /**
+     * @brief Size the columns
+     */
+    void resize(std::size_t router_count, std::size_t port_count);
+
+};
+
+/**
+ * @brief The writer of a telemetry file, which can be printed with `popnet-trace telemetry`
+ */
+class Telemetry {
+
+private:
+
+    std::string fname_;
+
+    int fd_;
+
+    std::size_t router_count_;
+
+    std::size_t port_count_;
+
+    std::size_t count_;
+
+    std::vector<char> buffer_;
+
+    void writeAll(const char* data, std::size_t size);
+
+    template<typename T>
+    void append(const std::vector<T>& column);
+
+public:
+
+    /**
+     * @brief Create the telemetry file, replacing an existing one
+     * @param fname The telemetry file
+     * @param router_count The number of routers
+     * @param port_count The number of ports of a router
+     */
+    Telemetry(const std::string& fname, std::size_t router_count, std::size_t port_count);
+
+    Telemetry(const Telemetry&) = delete;
+
+    Telemetry& operator=(const Telemetry&) = delete;
+
+    ~Telemetry();
+
+    /**
+     * @brief Write a window
+     * @param start The start of the window
+     * @param end The end of the window
+     * @param window The columns, sized by `TelemetryWindow::resize`
+     */
+    void record(TimeType start, TimeType end, const TelemetryWindow& window);
+
+    /**
+     * @brief Get the number of windows written
+     */
+    std::size_t getCount() const;
+
+    const std::string& getFname() const;
+
+};
+
+# endif
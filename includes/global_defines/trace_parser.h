@@ -0,0 +1,123 @@
+# pragma once
+
+/**
+ * @file trace_parser.h
+ * @brief A fast parser of text traces.
+ */
+
+# ifndef _TRACE_PARSER_H_
+# define _TRACE_PARSER_H_ 1
+
+# include <cstddef>
+# include <vector>
+
+# include "global_defines/defines.h"
+
+/**
+ * @brief The records of a trace, one vector per field
+ */
+struct TraceRecords {
+
+    std::vector<TimeType> start_time;
+
+    /**
+     * @brief The destination times, for traces of the sync protocol
+     */
+    std::vector<TimeType> des_time;
+
+    /**
+     * @brief The source addresses, `dimension` values per record
+     */
+    std::vector<long> src_addr;
+
+    /**
+     * @brief The destination addresses, `dimension` values per record
+     */
+    std::vector<long> des_addr;
+
+    std::vector<long> packet_size;
+
+    /**
+     * @brief The protocol descriptions, for traces of the sync protocol
+     */
+    std::vector<long> proto_dsc;
+
+    std::size_t size() const {
+        return this->start_time.size();
+    }
+
+    /**
+     * @brief Append the records of another
+     */
+    void append(const TraceRecords& other) {
+        this->start_time.insert(this->start_time.end(), other.start_time.begin(), other.start_time.end());
+        this->des_time.insert(this->des_time.end(), other.des_time.begin(), other.des_time.end());
+        this->src_addr.insert(this->src_addr.end(), other.src_addr.begin(), other.src_addr.end());
+        this->des_addr.insert(this->des_addr.end(), other.des_addr.begin(), other.des_addr.end());
+        this->packet_size.insert(this->packet_size.end(), other.packet_size.begin(), other.packet_size.end());
+        this->proto_dsc.insert(this->proto_dsc.end(), other.proto_dsc.begin(), other.proto_dsc.end());
+    }
+
+};
+
+/**
+ * @brief A parser of text traces, in the format of `tests/random_trace/bench`
+ * @note Large buffers are split at line boundaries and the pieces parsed on several threads,
+ *  which assumes one record per line. A trace with records spanning lines is parsed on one thread.
+ */
+class TextTraceParser {
+
+private:
+
+    std::size_t dimension_;
+
+    bool sync_protocol_;
+
+    std::size_t thread_num_;
+
+    /**
+     * @brief The result of parsing a piece of the buffer
+     */
+    struct Chunk {
+        TraceRecords records;
+        /**
+         * @brief Where parsing stopped
+         */
+        const char* end = nullptr;
+        /**
+         * @brief Whether the piece ends inside a record
+         */
+        bool partial = false;
+        /**
+         * @brief Whether a -1 ended the trace
+         */
+        bool end_mark = false;
+    };
+
+    void parseChunk(const char* begin, const char* end, bool complete, Chunk& chunk) const;
+
+public:
+
+    /**
+     * @brief Construct a new TextTraceParser object
+     * @param dimension The dimension of the addresses
+     * @param sync_protocol Whether the records are transactions of the sync protocol
+     * @param thread_num The number of threads, or 0 for one per core
+     */
+    TextTraceParser(std::size_t dimension, bool sync_protocol, std::size_t thread_num = 0);
+
+    /**
+     * @brief Parse a buffer, appending its records
+     * @param data The buffer
+     * @param size The size of the buffer
+     * @param records The records
+     * @param end_mark Set when a -1 ended the trace
+     * @param complete Whether the buffer ends at the end of a token, false for a trace still being written
+     * @return The number of bytes consumed, up to the -1 or up to the end of the last whole record
+     */
+    std::size_t parse(const char* data, std::size_t size, TraceRecords& records, bool& end_mark,
+        bool complete = true) const;
+
+};
+
+# endif
@@ -0,0 +1,78 @@
+# pragma once
+
+/**
+ * @file trace_source.h
+ * @brief The sources of the records of a trace read whole.
+ */
+
+# ifndef _TRACE_SOURCE_H_
+# define _TRACE_SOURCE_H_ 1
+
+# include <atomic>
+# include <cstddef>
+# include <string>
+
+# include "global_defines/trace_parser.h"
+
+/**
+ * @brief A source of trace records, keeping its file open between reads
+ */
+class TraceSource {
+
+protected:
+
+    /**
+     * @brief The system calls made on the trace so far
+     */
+    std::atomic<std::size_t> syscalls_;
+
+public:
+
+    TraceSource();
+
+    virtual ~TraceSource() = default;
+
+    /**
+     * @brief Take the records read since the last call
+     * @param records The records, appended in trace order
+     * @param wait Whether to block until there are records or the trace ends
+     * @return Whether the trace ended, after the records taken
+     */
+    virtual bool read(TraceRecords& records, bool wait) = 0;
+
+    std::size_t getSyscallCount() const;
+
+};
+
+/**
+ * @brief A complete text or binary trace, read once
+ */
+class FileTraceSource : public TraceSource {
+
+private:
+
+    std::string fname_;
+
+    std::size_t dimension_;
+
+    bool sync_protocol_;
+
+public:
+
+    /**
+     * @brief Construct a new FileTraceSource object
+     * @param fname The trace file
+     * @param dimension The dimension of the addresses
+     * @param sync_protocol Whether the records are transactions of the sync protocol
+     */
+    FileTraceSource(const std::string& fname, std::size_t dimension, bool sync_protocol);
+
+    /**
+     * @brief Read the whole trace, up to its end or to a -1
+     * @return Always true
+     */
+    bool read(TraceRecords& records, bool wait) override;
+
+};
+
+# endif
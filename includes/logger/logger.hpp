@@ -13,7 +13,18 @@
 # define _ORANGE_ fg(fmt::rgb(230, 165, 105))
 # define _RED_ fg(fmt::rgb(250, 110, 110))
 # define THREAD_SAFE // Comment this line to `disable` thread safety
+# define _LOGGER_RING_SIZE_ 4096 // The records a thread may log ahead of the writer
 
+/**
+ * @brief The lowest level compiled in: 0-debug 1-info 2-warn 3-error
+ * @note Messages logged through `LOG_DEBUG` etc. below this level are removed by the preprocessor,
+ *  arguments included. Set with `-DLOGGER_MIN_LEVEL=0` to get debug messages back.
+ */
+# ifndef LOGGER_MIN_LEVEL
+# define LOGGER_MIN_LEVEL 1
+# endif
+
+# include <atomic>
 # include <string>
 # include <iostream>
 # include <fstream>
@@ -28,8 +39,12 @@
 
 # ifdef THREAD_SAFE
 
+# include <cstdint>
+# include <cstdio>
+# include <memory>
 # include <mutex>
-# include <atomic>
+# include <thread>
+# include <vector>
 # include <linux/futex.h>
 # include <sys/syscall.h>
 # include <unistd.h>
@@ -125,15 +140,29 @@ enum class LogLevel: unsigned char {
     Error = 3
 };
 
+/**
+ * @brief What a thread does when its log ring is full
+ */
+enum class LogOverflow: unsigned char {
+    /**
+     * @brief Wait for the writer thread
+     */
+    Block = 0,
+    /**
+     * @brief Drop debug and info messages, counting them; warnings and errors still wait
+     */
+    Drop = 1
+};
+
 namespace Logger {
 
     /**
-     * @brief Get the current time in the format YYYY-MM-DD HH:MM:SS
-     * @return The current time as a std::string
+     * @brief Format a time in the format YYYY-MM-DD HH:MM:SS
+     * @param time The time
+     * @return The time as a std::string
      */
-    inline std::string getCurrentTime() {
-        auto now = std::chrono::system_clock::now();
-        auto time_t_now = std::chrono::system_clock::to_time_t(now);
+    inline std::string formatTime(std::chrono::system_clock::time_point time) {
+        auto time_t_now = std::chrono::system_clock::to_time_t(time);
         std::tm localTime{};
         localtime_r(&time_t_now, &localTime);
 
@@ -142,13 +171,24 @@ namespace Logger {
         return timeStr.str();
     }
 
-    inline LogLevel CURR_LOGLEVEL = LogLevel::Info;
+    /**
+     * @brief Get the current time in the format YYYY-MM-DD HH:MM:SS
+     * @return The current time as a std::string
+     */
+    inline std::string getCurrentTime() {
+        return Logger::formatTime(std::chrono::system_clock::now());
+    }
+
+    /**
+     * @brief The current log level
+     * @note Read without a lock, since every log call checks it.
+     */
+    inline std::atomic<LogLevel> CURR_LOGLEVEL = LogLevel::Info;
+    inline std::atomic<LogOverflow> CURR_OVERFLOW = LogOverflow::Block;
     inline std::string LOGGER_OUT = _LOGGER_OUT_DEFAULT_;
 
 # ifdef THREAD_SAFE
 
-    inline Logger::futex LOGGER_LOCK;
-    inline Logger::futex LOGLEVEL_LOCK;
     inline Logger::futex LOGGER_OUT_LOCK;
 
 # endif
@@ -159,10 +199,7 @@ namespace Logger {
      * @param level The log level
      */
     inline void setLogLevel(LogLevel level) {
-# ifdef THREAD_SAFE
-        const std::lock_guard<Logger::futex> lock(Logger::LOGLEVEL_LOCK);
-# endif
-        Logger::CURR_LOGLEVEL = level;
+        Logger::CURR_LOGLEVEL.store(level, std::memory_order_relaxed);
     }
 
     /**
@@ -170,23 +207,32 @@ namespace Logger {
      * @return The log level
      */
     inline LogLevel getLogLevel() {
-# ifdef THREAD_SAFE
-        const std::lock_guard<Logger::futex> lock(Logger::LOGLEVEL_LOCK);
-# endif
-        return Logger::CURR_LOGLEVEL;
+        return Logger::CURR_LOGLEVEL.load(std::memory_order_relaxed);
     }
 
     /**
-     * @brief Set the logger output
-     * @param out The logger output
-     * @note If the output is a file, the file will be opened in append mode
-     * @note The default output is std::cout
+     * @brief Whether messages of a level are logged
+     * @param level The log level
+     * @return false if the level is below the compiled or the current log level
      */
-    inline void setLoggerOut(const std::string& out) {
-# ifdef THREAD_SAFE
-        const std::lock_guard<Logger::futex> lock(Logger::LOGGER_OUT_LOCK);
-# endif
-        Logger::LOGGER_OUT = out;
+    inline bool isEnabled(LogLevel level) {
+        return static_cast<int>(level) >= LOGGER_MIN_LEVEL && level >= Logger::getLogLevel();
+    }
+
+    /**
+     * @brief Set what threads do when their log ring is full
+     * @param overflow The overflow policy
+     */
+    inline void setLogOverflow(LogOverflow overflow) {
+        Logger::CURR_OVERFLOW.store(overflow, std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Get what threads do when their log ring is full
+     * @return The overflow policy
+     */
+    inline LogOverflow getLogOverflow() {
+        return Logger::CURR_OVERFLOW.load(std::memory_order_relaxed);
     }
 
     /**
@@ -201,73 +247,496 @@ namespace Logger {
     }
 
     /**
-     * @brief Log a message
-     * @param level The log level
-     * @param fmtstr The format string
-     * @param args The arguments
+     * @brief Whether the logger output is the standard output
      */
-    template<typename... Args>
-    inline void log(LogLevel level, fmt::format_string<Args...> fmtstr, Args&&... args) {        
-        std::string timeStr = Logger::getCurrentTime();
+    inline bool isStdout(const std::string& out) {
+        return out == "std::cout" || out == "stdout";
+    }
+
+    /**
+     * @brief A message waiting to be written
+     * @note The message is formatted by the logging thread, the rest of the line by the writer.
+     */
+    struct Record {
+
+        LogLevel level;
+
+        std::chrono::system_clock::time_point time;
+
+        std::string message;
+
+    };
+
+    /**
+     * @brief Append a record as a line of the log
+     * @param out The line
+     * @param record The record
+     * @param time_str The formatted time of the record
+     * @param color Whether the level is colored, for a terminal
+     */
+    inline void formatRecord(std::string& out, const Record& record, const std::string& time_str, bool color) {
+        const char* name = "";
+        fmt::text_style style = _GREEN_;
+        switch (record.level) {
+            case LogLevel::Info:
+                name = "info ";
+                break;
+            case LogLevel::Debug:
+                name = "debug";
+                break;
+            case LogLevel::Warn:
+                name = "warn ";
+                style = _ORANGE_;
+                break;
+            case LogLevel::Error:
+                name = "error";
+                style = _RED_;
+                break;
+        }
+        out += "[";
+        out += time_str;
+        out += "][";
+        if (color) {
+            out += fmt::format(style, "{}", name);
+            out += "\033[0m";
+        }
+        else {
+            out += name;
+        }
+        out += "] ";
+        out += record.message;
+        out += "\n";
+    }
+
+    /**
+     * @brief Write a record on the calling thread, opening the log file for it
+     */
+    inline void writeRecord(const Record& record) {
+        std::string out = Logger::getLoggerOut();
+        std::string line;
+        if (Logger::isStdout(out)) {
+            Logger::formatRecord(line, record, Logger::formatTime(record.time), true);
+            std::fwrite(line.data(), 1, line.size(), stdout);
+            return;
+        }
+        std::ofstream logFile(out, std::ios::app);
+        if (!logFile.is_open()) {
+            fmt::print("[{}][", Logger::formatTime(record.time));
+            fmt::print(_RED_, "error");
+            fmt::print("\033[0m");
+            fmt::print("] ");
+            fmt::print("Could not open log file: {}\n", out);
+            return;
+        }
+        Logger::formatRecord(line, record, Logger::formatTime(record.time), false);
+        logFile << line;
+    }
 
-        if (Logger::getLoggerOut() == "std::cout" || Logger::getLoggerOut() == "stdout") {
 # ifdef THREAD_SAFE
-            const std::lock_guard<Logger::futex> lock(Logger::LOGGER_LOCK);
-# endif
-            fmt::print("[{}][", timeStr);
-            switch (level) {
-                case LogLevel::Info: 
-                    fmt::print(_GREEN_, "info ");
-                    break;
-                case LogLevel::Debug: 
-                    fmt::print(_GREEN_, "debug");
-                    break;
-                case LogLevel::Warn:
-                    fmt::print(_ORANGE_, "warn ");
-                    break;
-                case LogLevel::Error:
+
+    /**
+     * @brief A bounded single-producer single-consumer ring of records
+     * @note Each logging thread owns one, which only the writer thread drains.
+     */
+    class Ring {
+
+    private:
+
+        std::vector<Record> slots_;
+
+        /**
+         * @brief The records taken by the writer
+         */
+        alignas(64) std::atomic<std::size_t> head_;
+
+        /**
+         * @brief The records pushed by the owner
+         */
+        alignas(64) std::atomic<std::size_t> tail_;
+
+        /**
+         * @brief The records written out by the writer
+         */
+        alignas(64) std::atomic<std::size_t> written_;
+
+        std::atomic<std::size_t> dropped_;
+
+        std::atomic<bool> closed_;
+
+    public:
+
+        Ring()
+        :   slots_(_LOGGER_RING_SIZE_),
+            head_(0),
+            tail_(0),
+            written_(0),
+            dropped_(0),
+            closed_(false)
+        {}
+
+        /**
+         * @brief Push a record, by the owner
+         * @return false if the ring is full
+         */
+        bool push(Record& record) {
+            std::size_t tail = this->tail_.load(std::memory_order_relaxed);
+            if (tail - this->head_.load(std::memory_order_acquire) == this->slots_.size()) {
+                return false;
+            }
+            this->slots_[tail % this->slots_.size()] = std::move(record);
+            this->tail_.store(tail + 1, std::memory_order_release);
+            return true;
+        }
+
+        /**
+         * @brief Take a record, by the writer
+         * @return false if the ring is empty
+         */
+        bool pop(Record& record) {
+            std::size_t head = this->head_.load(std::memory_order_relaxed);
+            if (head == this->tail_.load(std::memory_order_acquire)) {
+                return false;
+            }
+            record = std::move(this->slots_[head % this->slots_.size()]);
+            this->head_.store(head + 1, std::memory_order_release);
+            return true;
+        }
+
+        std::size_t getTail() const {
+            return this->tail_.load(std::memory_order_acquire);
+        }
+
+        std::size_t getWritten() const {
+            return this->written_.load(std::memory_order_acquire);
+        }
+
+        /**
+         * @brief Mark what was taken as written out
+         */
+        void markWritten() {
+            this->written_.store(this->head_.load(std::memory_order_relaxed), std::memory_order_release);
+        }
+
+        void addDropped() {
+            this->dropped_.fetch_add(1, std::memory_order_relaxed);
+        }
+
+        std::size_t takeDropped() {
+            return this->dropped_.exchange(0, std::memory_order_relaxed);
+        }
+
+        /**
+         * @brief Mark the ring as left by its thread, to be removed once drained
+         */
+        void close() {
+            this->closed_.store(true, std::memory_order_release);
+        }
+
+        bool isDone() const {
+            return this->closed_.load(std::memory_order_acquire)
+                && this->getWritten() == this->getTail();
+        }
+
+    };
+
+    /**
+     * @brief The writer thread of the log and the rings it drains
+     * @note Logging threads never take a lock or touch the output: they push to their own ring and
+     *  wake the writer, which formats the lines and writes them in batches.
+     */
+    class Backend {
+
+    private:
+
+        std::mutex rings_mutex_;
+
+        std::vector<std::shared_ptr<Ring>> rings_;
+
+        /**
+         * @brief Bumped by logging threads, to wake the writer
+         */
+        std::atomic<std::uint64_t> pushed_;
+
+        /**
+         * @brief Bumped by the writer after each batch, to wake flushing and blocked threads
+         */
+        std::atomic<std::uint64_t> batches_;
+
+        std::atomic<bool> stop_;
+
+        /**
+         * @brief The output the writer has open
+         */
+        std::string out_;
+
+        std::FILE* file_;
+
+        std::thread writer_;
+
+        /**
+         * @brief Point `file_` at the current logger output
+         * @return false if the log file cannot be opened
+         */
+        bool openOut() {
+            std::string out = Logger::getLoggerOut();
+            if (out == this->out_ && this->file_ != nullptr) {
+                return true;
+            }
+            if (this->file_ != nullptr && this->file_ != stdout) {
+                std::fclose(this->file_);
+            }
+            this->out_ = out;
+            this->file_ = Logger::isStdout(out) ? stdout : std::fopen(out.c_str(), "a");
+            return this->file_ != nullptr;
+        }
+
+        /**
+         * @brief Write out everything in the rings
+         * @return Whether anything was written
+         */
+        bool drain() {
+            std::vector<std::shared_ptr<Ring>> rings;
+            {
+                std::lock_guard<std::mutex> lock(this->rings_mutex_);
+                rings = this->rings_;
+            }
+            std::string lines;
+            Record record;
+            std::time_t last_second = -1;
+            std::string time_str;
+            bool color = Logger::isStdout(Logger::getLoggerOut());
+            bool any = false;
+            for (auto& ring : rings) {
+                std::size_t dropped = ring->takeDropped();
+                if (dropped > 0) {
+                    Record note{LogLevel::Warn, std::chrono::system_clock::now(),
+                        fmt::format("Dropped {} log messages of a thread.", dropped)};
+                    Logger::formatRecord(lines, note, Logger::formatTime(note.time), color);
+                }
+                while (ring->pop(record)) {
+                    // Lines of the same second share the formatted time.
+                    std::time_t second = std::chrono::system_clock::to_time_t(record.time);
+                    if (second != last_second) {
+                        last_second = second;
+                        time_str = Logger::formatTime(record.time);
+                    }
+                    Logger::formatRecord(lines, record, time_str, color);
+                    any = true;
+                }
+            }
+            if (!lines.empty()) {
+                if (this->openOut()) {
+                    std::fwrite(lines.data(), 1, lines.size(), this->file_);
+                    std::fflush(this->file_);
+                }
+                else {
+                    fmt::print("[{}][", Logger::getCurrentTime());
                     fmt::print(_RED_, "error");
+                    fmt::print("\033[0m");
+                    fmt::print("] ");
+                    fmt::print("Could not open log file: {}\n", this->out_);
+                }
+            }
+            for (auto& ring : rings) {
+                ring->markWritten();
+            }
+            if (any) {
+                std::lock_guard<std::mutex> lock(this->rings_mutex_);
+                std::erase_if(this->rings_, [](const std::shared_ptr<Ring>& ring) {
+                    return ring->isDone();
+                });
+            }
+            return any;
+        }
+
+        void writerLoop() {
+            while (true) {
+                std::uint64_t pushed = this->pushed_.load(std::memory_order_acquire);
+                if (this->drain()) {
+                    this->batches_.fetch_add(1, std::memory_order_release);
+                    this->batches_.notify_all();
+                    continue;
+                }
+                if (this->stop_.load(std::memory_order_acquire)) {
+                    return;
+                }
+                this->pushed_.wait(pushed, std::memory_order_acquire);
+            }
+        }
+
+    public:
+
+        Backend()
+        :   rings_mutex_(),
+            rings_(),
+            pushed_(0),
+            batches_(0),
+            stop_(false),
+            out_(),
+            file_(nullptr),
+            writer_()
+        {
+            this->writer_ = std::thread(&Backend::writerLoop, this);
+        }
+
+        Backend(const Backend&) = delete;
+
+        Backend& operator=(const Backend&) = delete;
+
+        /**
+         * @brief Write out what is left and stop the writer
+         */
+        ~Backend();
+
+        /**
+         * @brief Make a ring for the calling thread
+         */
+        std::shared_ptr<Ring> addRing() {
+            auto ring = std::make_shared<Ring>();
+            std::lock_guard<std::mutex> lock(this->rings_mutex_);
+            this->rings_.push_back(ring);
+            return ring;
+        }
+
+        /**
+         * @brief Hand a record to the writer
+         * @param ring The ring of the calling thread
+         * @param record The record
+         */
+        void push(Ring& ring, Record& record) {
+            while (!ring.push(record)) {
+                if (record.level < LogLevel::Warn && Logger::getLogOverflow() == LogOverflow::Drop) {
+                    ring.addDropped();
                     break;
+                }
+                std::uint64_t batches = this->batches_.load(std::memory_order_acquire);
+                if (ring.push(record)) {
+                    break;
+                }
+                this->batches_.wait(batches, std::memory_order_acquire);
             }
+            this->pushed_.fetch_add(1, std::memory_order_release);
+            this->pushed_.notify_one();
+        }
 
-            fmt::print("\033[0m");
-            fmt::print("] ");
-            fmt::print(fmtstr, std::forward<Args>(args)...);
-            fmt::print("\n");
+        /**
+         * @brief Wait until everything logged so far is written out
+         */
+        void flush() {
+            std::vector<std::pair<std::shared_ptr<Ring>, std::size_t>> targets;
+            {
+                std::lock_guard<std::mutex> lock(this->rings_mutex_);
+                for (auto& ring : this->rings_) {
+                    targets.emplace_back(ring, ring->getTail());
+                }
+            }
+            this->pushed_.fetch_add(1, std::memory_order_release);
+            this->pushed_.notify_one();
+            for (auto& [ring, tail] : targets) {
+                while (true) {
+                    std::uint64_t batches = this->batches_.load(std::memory_order_acquire);
+                    if (ring->getWritten() >= tail) {
+                        break;
+                    }
+                    this->batches_.wait(batches, std::memory_order_acquire);
+                }
+            }
         }
-        else {
-            std::ofstream logFile(Logger::getLoggerOut(), std::ios::app);
+
+    };
+
+    /**
+     * @brief Whether the backend is gone, when logging from destructors of static objects
+     */
+    inline std::atomic<bool> BACKEND_DOWN = false;
+
+    inline Backend::~Backend() {
+        this->stop_.store(true, std::memory_order_release);
+        this->pushed_.fetch_add(1, std::memory_order_release);
+        this->pushed_.notify_one();
+        this->writer_.join();
+        Logger::BACKEND_DOWN.store(true, std::memory_order_release);
+        if (this->file_ != nullptr && this->file_ != stdout) {
+            std::fclose(this->file_);
+        }
+    }
+
+    /**
+     * @brief The backend, started by the first message
+     */
+    inline Backend& getBackend() {
+        static Backend backend;
+        return backend;
+    }
+
+    /**
+     * @brief The ring of a thread, closed when the thread exits
+     */
+    struct ThreadRing {
+
+        std::shared_ptr<Ring> ring;
+
+        ~ThreadRing() {
+            if (this->ring) {
+                this->ring->close();
+            }
+        }
+
+    };
+
+    inline thread_local ThreadRing THREAD_RING;
+
+# endif
+
+    /**
+     * @brief Wait until everything logged so far is written out
+     * @note Call before aborting, since the writer thread dies with the process.
+     */
+    inline void flush() {
 # ifdef THREAD_SAFE
-            const std::lock_guard<Logger::futex> lock(Logger::LOGGER_LOCK);
+        if (!Logger::BACKEND_DOWN.load(std::memory_order_acquire)) {
+            Logger::getBackend().flush();
+        }
 # endif
-            if (!logFile.is_open()) {
-                fmt::print("[{}][", timeStr);
-                fmt::print(_RED_, "error");
-                fmt::print("\033[0m");
-                fmt::print("] ");
-                fmt::print("Could not open log file: {}\n", Logger::getLoggerOut());
-                return;
-            }            
-            std::string out_str = "";
-            switch (level) {
-                case LogLevel::Info: 
-                    out_str += fmt::format("[{}][info ] ", timeStr);
-                    break;
-                case LogLevel::Debug: 
-                    out_str += fmt::format("[{}][debug] ", timeStr);
-                    break;
-                case LogLevel::Warn:
-                    out_str += fmt::format("[{}][warn ] ", timeStr);
-                    break;
-                case LogLevel::Error:
-                    out_str += fmt::format("[{}][error] ", timeStr);
-                    break;
+        std::fflush(stdout);
+    }
+
+    /**
+     * @brief Set the logger output
+     * @param out The logger output
+     * @note If the output is a file, the file will be opened in append mode
+     * @note The default output is std::cout
+     * @note Messages logged before are written to the previous output.
+     */
+    inline void setLoggerOut(const std::string& out) {
+        Logger::flush();
+# ifdef THREAD_SAFE
+        const std::lock_guard<Logger::futex> lock(Logger::LOGGER_OUT_LOCK);
+# endif
+        Logger::LOGGER_OUT = out;
+    }
+
+    /**
+     * @brief Log a message
+     * @param level The log level
+     * @param fmtstr The format string
+     * @param args The arguments
+     * @note The message is formatted here and written by the writer thread.
+     */
+    template<typename... Args>
+    inline void log(LogLevel level, fmt::format_string<Args...> fmtstr, Args&&... args) {
+        Record record{level, std::chrono::system_clock::now(), fmt::format(fmtstr, std::forward<Args>(args)...)};
+# ifdef THREAD_SAFE
+        if (!Logger::BACKEND_DOWN.load(std::memory_order_acquire)) {
+            Backend& backend = Logger::getBackend();
+            if (!Logger::THREAD_RING.ring) {
+                Logger::THREAD_RING.ring = backend.addRing();
             }
-            out_str += fmt::format(fmtstr, std::forward<Args>(args)...);
-            out_str += "\n";
-            logFile << out_str;
-            logFile.close();
+            backend.push(*Logger::THREAD_RING.ring, record);
+            return;
         }
+# endif
+        Logger::writeRecord(record);
     }
     
     /**
@@ -275,7 +744,7 @@ namespace Logger {
      */
     template<typename... Args>
     inline void debug(fmt::format_string<Args...> fmtstr, Args&&... args) {
-        if (Logger::getLogLevel() > LogLevel::Debug) {
+        if (!Logger::isEnabled(LogLevel::Debug)) {
             return;
         }
         Logger::log(LogLevel::Debug, fmtstr, std::forward<Args>(args)...);
@@ -286,7 +755,7 @@ namespace Logger {
      */
     template<typename... Args>
     inline void info(fmt::format_string<Args...> fmtstr, Args&&... args) {
-        if (Logger::getLogLevel() > LogLevel::Info) {
+        if (!Logger::isEnabled(LogLevel::Info)) {
             return;
         }
         Logger::log(LogLevel::Info, fmtstr, std::forward<Args>(args)...);
@@ -297,7 +766,7 @@ namespace Logger {
      */
     template<typename... Args>
     inline void warn(fmt::format_string<Args...> fmtstr, Args&&... args) {
-        if (Logger::getLogLevel() > LogLevel::Warn) {
+        if (!Logger::isEnabled(LogLevel::Warn)) {
             return;
         }
         Logger::log(LogLevel::Warn, fmtstr, std::forward<Args>(args)...);
@@ -308,7 +777,7 @@ namespace Logger {
      */
     template<typename... Args>
     inline void error(fmt::format_string<Args...> fmtstr, Args&&... args) {
-        if (Logger::getLogLevel() > LogLevel::Error) {
+        if (!Logger::isEnabled(LogLevel::Error)) {
             return;
         }
         Logger::log(LogLevel::Error, fmtstr, std::forward<Args>(args)...);
@@ -329,4 +798,72 @@ namespace Logger {
     
 };
 
+/**
+ * @brief operator<< overload for `LogOverflow`.
+ */
+inline std::ostream& operator<<(std::ostream& os, const LogOverflow& LogOverflow_) {
+    switch (LogOverflow_) {
+        case LogOverflow::Block:
+            os << "BLOCK";
+            break;
+        case LogOverflow::Drop:
+            os << "DROP";
+            break;
+    }
+    return os;
+}
+
+/**
+ * @brief operator<< overload for `LogLevel`.
+ */
+inline std::ostream& operator<<(std::ostream& os, const LogLevel& LogLevel_) {
+    switch (LogLevel_) {
+        case LogLevel::Debug:
+            os << "DEBUG";
+            break;
+        case LogLevel::Info:
+            os << "INFO";
+            break;
+        case LogLevel::Warn:
+            os << "WARN";
+            break;
+        case LogLevel::Error:
+            os << "ERROR";
+            break;
+    }
+    return os;
+}
+
+/**
+ * @brief Log a message, evaluating the arguments only if its level is logged
+ * @note Use these on hot paths, where building the arguments costs more than the check.
+ *  Levels below `LOGGER_MIN_LEVEL` compile to nothing.
+ */
+# define LOGGER_LOG_(level, ...) \
+    do { \
+        if (Logger::isEnabled(level)) { \
+            Logger::log(level, __VA_ARGS__); \
+        } \
+    } while (0)
+
+# if LOGGER_MIN_LEVEL <= 0
+# define LOG_DEBUG(...) LOGGER_LOG_(LogLevel::Debug, __VA_ARGS__)
+# else
+# define LOG_DEBUG(...) do {} while (0)
+# endif
+
+# if LOGGER_MIN_LEVEL <= 1
+# define LOG_INFO(...) LOGGER_LOG_(LogLevel::Info, __VA_ARGS__)
+# else
+# define LOG_INFO(...) do {} while (0)
+# endif
+
+# if LOGGER_MIN_LEVEL <= 2
+# define LOG_WARN(...) LOGGER_LOG_(LogLevel::Warn, __VA_ARGS__)
+# else
+# define LOG_WARN(...) do {} while (0)
+# endif
+
+# define LOG_ERROR(...) LOGGER_LOG_(LogLevel::Error, __VA_ARGS__)
+
 # endif
@@ -90,6 +90,11 @@ class Config {
      */
     std::string reconfig_file_path_;
 	
+    /**
+     * @brief The directory the routing tables of graph topologies are cached in, empty for none
+     */
+    std::string routing_cache_dir_;
+	
     /**
      * @brief Whether packet loss is enabled
      */
@@ -112,18 +117,98 @@ class Config {
      * @brief The log file name
      */
     std::string log_fname_;
+
+    /**
+     * @brief The log level
+     * @note Levels below `LOGGER_MIN_LEVEL` are not compiled in, whatever this says.
+     */
+    LogLevel log_level_;
+
+    /**
+     * @brief What threads do when they log faster than the log is written
+     */
+    LogOverflow log_overflow_;
+
+    /**
+     * @brief The file every event handled is recorded to, empty for none
+     */
+    std::string event_trace_fname_;
+
+    /**
+     * @brief The file the activity of every router is recorded to every report period, empty for none
+     */
+    std::string telemetry_fname_;
 	
     /**
      * @brief Whether the sync protocol is enabled
      */
     bool sync_protocol_enable_;
 
+    /**
+     * @brief The event queue engine
+     */
+    EventQueueType event_queue_;
+
+    /**
+     * @brief The layout of the per-VC router state
+     */
+    StateLayoutType state_layout_;
+
+    /**
+     * @brief Which routers a ROUTER event ticks
+     */
+    RouterScheduleType router_schedule_;
+
+    /**
+     * @brief How the power is modelled: from the flit payloads, from the number of events, or not at all
+     */
+    PowerModeType power_mode_;
+
+    /**
+     * @brief The number of threads running the router pipeline
+     */
+    long pipeline_threads_;
+
+    /**
+     * @brief The number of partitions of the partitioned (PDES) engine
+     */
+    long partitions_;
+
+    /**
+     * @brief How far ahead of the current time the trace is read, or 0 to read it at once
+     */
+    TimeType trace_window_;
+
+    /**
+     * @brief How often a trace ending with -1 is read again without a write notification, in ms
+     */
+    long trace_poll_interval_;
+
+    /**
+     * @brief The record format of the delay file
+     */
+    DelayFormatType delay_format_;
+
+    /**
+     * @brief Whether the delay file is written by a writer thread
+     */
+    bool delay_async_;
+
     std::unique_ptr<long> random_seed_;
 
     void fromJson(const std::string& fname);
 
+    void fromJson(const nlohmann::json& j);
+
     void fromCMD(int argc, char * const argv []);
 
+    /**
+     * @brief Check the parameters and derive the dependent ones
+     */
+    void validate();
+
+    Config();
+
 public:
 
     /**
@@ -131,6 +216,12 @@ public:
      */
     Config(int argc, char * const argv []);
 
+    /**
+     * @brief Construct a configuration from a JSON object with the keys of a config file
+     * @param j The JSON object
+     */
+    explicit Config(const nlohmann::json& j);
+
     /**
      * @brief The getter for the ary_number_ parameter
      */
@@ -200,6 +291,28 @@ public:
      * @brief The getter for the log_file_path_ parameter
      */
     const std::string& getLogFilePath() const;
+
+    /**
+     * @brief The getter for the log_level_ parameter
+     */
+    LogLevel getLogLevel() const;
+
+    /**
+     * @brief The getter for the log_overflow_ parameter
+     */
+    LogOverflow getLogOverflow() const;
+
+    /**
+     * @brief The getter for the event_trace_fname_ parameter
+     * @note Event traces can be filtered and converted with `popnet-trace events`.
+     */
+    const std::string& getEventTraceFname() const;
+
+    /**
+     * @brief The getter for the telemetry_fname_ parameter
+     * @note Telemetry files can be printed with `popnet-trace telemetry`.
+     */
+    const std::string& getTelemetryFname() const;
     
     /**
      * @brief The getter for the report_period_ parameter
@@ -211,6 +324,12 @@ public:
      */
     const std::string& getReconfigFilePath() const;
     
+    /**
+     * @brief The getter for the routing_cache_dir_ parameter
+     * @note The tables are keyed on the contents of the topology file, so a cache can be shared by any topologies.
+     */
+    const std::string& getRoutingCacheDir() const;
+    
     /**
      * @brief The getter for the packet_loss_ parameter
      */
@@ -226,6 +345,66 @@ public:
      */
     bool isSyncProtocolEnable() const;
 
+    /**
+     * @brief The getter for the event_queue_ parameter
+     */
+    EventQueueType getEventQueueType() const;
+
+    /**
+     * @brief The getter for the state_layout_ parameter
+     */
+    StateLayoutType getStateLayout() const;
+
+    /**
+     * @brief The getter for the router_schedule_ parameter
+     */
+    RouterScheduleType getRouterSchedule() const;
+
+    /**
+     * @brief The getter for the power_mode_ parameter
+     * @note Only the full power model keeps the flit payloads, the delays are the same in every mode.
+     */
+    PowerModeType getPowerMode() const;
+
+    /**
+     * @brief The getter for the pipeline_threads_ parameter
+     * @note With more than one thread, every router draws from its own random stream.
+     */
+    long getPipelineThreads() const;
+
+    /**
+     * @brief The getter for the partitions_ parameter
+     * @note With more than one partition, each partition runs on its own thread
+     *  with its own event queue, and every router draws from its own random stream.
+     */
+    long getPartitions() const;
+
+    /**
+     * @brief The getter for the trace_window_ parameter
+     * @note A positive window streams a trace sorted by start time, so that only the packets
+     *  within the window are held. A router out of packets reads ahead to its next one, so that
+     *  the delays are those of the whole trace unless `TRACE_READ_AHEAD_` packets get queued.
+     */
+    TimeType getTraceWindow() const;
+
+    /**
+     * @brief The getter for the trace_poll_interval_ parameter
+     * @note A trace ending with -1 is read again on every write notification. The interval only
+     *  covers file systems where notifications are missed; 0 disables it.
+     */
+    long getTracePollInterval() const;
+
+    /**
+     * @brief The getter for the delay_format_ parameter
+     * @note Binary delay files can be printed as text with `popnet-trace delays`.
+     */
+    DelayFormatType getDelayFormat() const;
+
+    /**
+     * @brief The getter for the delay_async_ parameter
+     */
+    bool isDelayAsync() const;
+
     /**
      * @brief The getter for the random_seed_ parameter
      */
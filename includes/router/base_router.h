@@ -6,11 +6,13 @@
 
 
 # include <functional>
+# include <memory>
 # include <vector>
 # include <unordered_map>
 
 # include "global.h"
 # include "router/modules.h"
+# include "router/router_outbox.h"
 # include "preprocess/config.h"
 
 class BaseRouter {
@@ -22,10 +24,30 @@ protected:
      */
     std::vector<BaseRouter *>& router_list_;
 
+    /**
+     * @brief the addresses of the routers of the network
+     */
+    const AddressTable& address_table_;
+
+    /**
+     * @brief the ID of the router, its index in the router list
+     */
+    RouterId id_;
+
     /**
      * @brief the address of the router
      */
     AddrType address_;
+
+    /**
+     * @brief the router at the other end of every port, set by `linkNeighbours()`
+     */
+    std::vector<RouterId> next_routers_;
+
+    /**
+     * @brief the router sending to every port, set by `linkNeighbours()`
+     */
+    std::vector<RouterId> from_routers_;
 	
     /**
      * @brief the input module of the router
@@ -41,6 +63,16 @@ protected:
      * @brief the power module of the router
      */
 	PowerModules power_module_;
+
+    /**
+     * @brief the per-vc state of the router, when it is not stored in a network-wide arena
+     */
+    std::unique_ptr<RouterStateArena> own_state_;
+
+    /**
+     * @brief the per-vc state used by the input and output modules
+     */
+    RouterStateSlice state_;
 	
     /**
      * @brief the input buffer of the router, which will be random
@@ -86,11 +118,47 @@ protected:
      * @brief the total delay of the flits
      */
 	TimeType total_delay_;
+
+    /**
+     * @brief the number of flits injected at the router
+     */
+    std::size_t injected_flits_;
+
+    /**
+     * @brief the number of flits accepted at the router
+     */
+    std::size_t accepted_flits_;
+
+    /**
+     * @brief the number of packets accepted at the router, whose delays make `total_delay_`
+     */
+    std::size_t accepted_packets_;
 	
     /**
      * @brief the routing algorithm used
      */
 	RoutingType routing_alg_;
+
+    /**
+     * @brief the input VCs requesting every output VC, indexed by port * vc_number_ + vc
+     * @note Kept between cycles, like the other requests below, so that the arbitration does not allocate.
+     */
+    std::vector<std::vector<VCType>> vc_requests_;
+
+    /**
+     * @brief the input VCs requesting every output port
+     */
+    std::vector<std::vector<VCType>> sw_requests_;
+
+    /**
+     * @brief the free output VCs `selectVC` picks from
+     */
+    std::vector<VCType> vc_candidates_;
+
+    /**
+     * @brief the VCs of an input port ready for the switch
+     */
+    std::vector<long> sw_candidates_;
 	
     /**
      * @brief the current routing algorithm
@@ -137,6 +205,27 @@ protected:
      */
     TimeType routing_time_ = 0;
 
+    /**
+     * @brief where the shared-state changes of a pipeline stage go, or nullptr to apply them at once
+     */
+    RouterOutbox* outbox_ = nullptr;
+
+    /**
+     * @brief the private random stream of the router, or nullptr to use `Global::RandomGen()`
+     */
+    std::unique_ptr<RGen> random_gen_;
+
+    /**
+     * @brief Get the random generator of the router
+     */
+    RGen& random();
+
+    /**
+     * @brief Add an event to `Global::messageQueue()`, or to the outbox
+     * @param event The event
+     */
+    void postEvent(MessEvent&& event);
+
 	/**
      * @brief the wire delay time
      * @param port The port
@@ -197,6 +286,13 @@ protected:
      */
     void getNextAddress_mesh(AddrType& nextAddress, long port);
 
+    /**
+     * @brief get the router at the other end of a port
+     * @param port The port
+     * @return The ID of the router
+     */
+    virtual RouterId getNextRouterId(long port);
+
     /**
      * @brief get the wire pc
      * @param port The port
@@ -242,6 +338,19 @@ protected:
      */
     void getFromRouter_chipletStar(AddrType& from, long port);
 
+    /**
+     * @brief get the router sending to a port
+     * @param port The port
+     * @return The ID of the router
+     */
+    virtual RouterId getFromRouterId(long port);
+
+    /**
+     * @brief Look up the routers of `getNextAddress()` and `getFromRouter()` once for every port
+     * @note Called by the constructors of the routers whose neighbours never change.
+     */
+    void linkNeighbours();
+
     /**
      * @brief get the from port
      * @param port The port
@@ -285,11 +394,11 @@ protected:
     virtual TimeType getPipeStageDelay() const;
 
     /**
-     * @brief Get a router according to the address
-     * @param addr The address of the router
+     * @brief Get a router according to its ID
+     * @param id The ID of the router
      * @return The router
      */
-    BaseRouter& getRouter(const AddrType& addr);
+    BaseRouter& getRouter(RouterId id);
 
     void updateTrans(TimeType new_time, const Flit& flit);
 
@@ -297,7 +406,7 @@ protected:
 
     void updateTransNormal(TimeType new_time, ProtoStateMachine& trans);
 
-    void injctPacket(long flit_id, const AddrType& src_addr, const AddrType& des_addr,
+    void injctPacket(long flit_id, RouterId src, RouterId des,
         TimeType start_time, long packet_size, TId packet_id);
     
     /**
@@ -330,11 +439,28 @@ protected:
 
 public:
 
+    /**
+     * @brief Get the address of the router
+     */
+    const AddrType& getAddress() const;
+
+    /**
+     * @brief Get the ID of the router
+     */
+    RouterId getId() const;
+
     TimeType getLocalTime() const;
 
     void setLocalTime(TimeType new_local_time);
 
     void acceptFlit(TimeType accept_time, const Flit& target_flt);
+
+    /**
+     * @brief Accept a flit at its destination and return it to `Global::flitPool()`
+     * @param accept_time the accept time
+     * @param target_flt the handle of the flit
+     */
+    void acceptFlit(TimeType accept_time, FlitHandle target_flt);
 	
 	/**
      * @brief Get the power of buffer
@@ -348,6 +474,13 @@ public:
      */
     double getLinkPower();
     
+    /**
+     * @brief Get the power of the link of a port
+     * @param port the output port
+     * @return the power of the link
+     */
+    double getLinkPower(long port);
+
     /**
      * @brief Get the power of crossbar
      * @return the power of crossbar
@@ -366,24 +499,78 @@ public:
      */
     TimeType getTotalDelay() const;
 
+    std::size_t getInjectedFlits() const;
+
+    std::size_t getAcceptedFlits() const;
+
+    std::size_t getAcceptedPackets() const;
+
+    /**
+     * @brief Get the number of flits in the input buffers, the injection queue included
+     */
+    std::size_t getInputFlits() const;
+
+    /**
+     * @brief Get the number of flits in the output buffers
+     */
+    std::size_t getOutputFlits() const;
+
 	void recvCredit(long phy_idx, long vc_idx);
 
 	void recvPacket();
 	
-    void recvFlit(long phy_idx, long vc_idx, Flit& flit);	
+    void recvFlit(long phy_idx, long vc_idx, FlitHandle flit);	
 
     void routingPipeStage(TimeType routing_period);
 
+    /**
+     * @brief Whether the router holds no flit, so that a pipeline stage would do nothing
+     * @return true if all input and output buffers are empty
+     */
+    bool isIdle() const;
+
+    /**
+     * @brief Get the number of ports, the local port 0 included
+     */
+    virtual long getPortNumber() const;
+
+    /**
+     * @brief Get the router at the other end of a port
+     * @param port The port, from 1 to `getPortNumber() - 1`
+     * @param neighbour The ID of the router
+     * @return The wire delay of the link
+     */
+    TimeType getLink(long port, RouterId& neighbour);
+
     /**
      * @brief Construct a new BaseRouter object
      * @param config The config of the simulation
-     * @param addr The address of the router
+     * @param id The ID of the router, its address is looked up in `Global::addressTable()`
      * @param router_list The list of routers
      */
-    BaseRouter(const Config& config, AddrType addr, std::vector<BaseRouter *>& router_list);
+    BaseRouter(const Config& config, RouterId id, std::vector<BaseRouter *>& router_list);
 
     virtual ~BaseRouter() = default;
 
+    /**
+     * @brief Move the per-vc state of the router into a network-wide arena
+     * @param arena The arena
+     * @param index The index of the router in the arena
+     */
+    void bindState(RouterStateArena& arena, std::size_t index);
+
+    /**
+     * @brief Give the router its own random stream, so that it can be ticked on any thread
+     * @param seed The seed of the stream
+     */
+    void seedRandom(unsigned long long seed);
+
+    /**
+     * @brief Hold back the shared-state changes of the following pipeline stages
+     * @param outbox The outbox, or nullptr to apply the changes at once
+     */
+    void setOutbox(RouterOutbox* outbox);
+
 };
 
 /**
@@ -4,9 +4,10 @@
 # define _MODULES_H_ 1
 
 # include <vector>
-# include <list>
 
 # include "global.h"
+# include "global_defines/ring_buffer.h"
+# include "router/router_state.h"
 extern "C" {
     # include "SIM_power.h"
     # include "SIM_router_power.h"
@@ -25,30 +26,50 @@ class InputModules {
 
 private:
 	
-    std::vector<std::vector<std::list<Flit>>> input_;
+    std::vector<std::vector<RingBuffer<FlitHandle>>> input_;
+
+    long phy_port_num_;
+
+    long vc_num_;
     
-    std::vector<std::vector<VCStateType>> states_;
+    // the vc states (`states`) and the chosen routing vcs (`crouting`), owned by a `RouterStateArena`
+    RouterStateSlice state_;
 	
     // the candidate routing vcs
 	std::vector<std::vector<std::vector<VCType>>> routing_;
-	
-    // the chosen routing vc
-	std::vector<std::vector<VCType>> crouting_;
+
+    /**
+     * @brief Get the index of a vc in the state arrays
+     * @param pc the physical port
+     * @param vc the virtual channel
+     */
+    std::size_t index(long pc, long vc) const;
 	
     // this is a flag to show that the buffer of injection is full
 	bool ibuff_full_;
 
+    // the number of flits in all input buffers
+    std::size_t flit_count_;
+
 public:
    
     /**
      * @brief Construct a new Input Modules object
      * @param phy_port_num the number of physical ports
      * @param vc_num the number of virtual channels
+     * @param buffer_size the size of input buffer
+     * @note The injection port is preallocated for `BUFF_BOUND_` flits and grows beyond that.
      */
-    InputModules(long phy_port_num, long vc_num);
+    InputModules(long phy_port_num, long vc_num, long buffer_size);
 
     ~InputModules() = default;
 
+    /**
+     * @brief Use the state arrays of a `RouterStateArena`
+     * @param state the state of the router
+     */
+    void bindState(const RouterStateSlice& state);
+
     /**
      * @brief If the input buffer is full
      */
@@ -67,6 +88,11 @@ public:
      */
     std::size_t getBufferSize(long pc, long vc) const;
 
+    /**
+     * @brief Get the number of flits in all input buffers
+     */
+    std::size_t getFlitCount() const;
+
     /**
      * @brief set the state
      * @param pc the physical port
@@ -87,17 +113,17 @@ public:
      * @brief add a flit
      * @param pc the physical port
      * @param vc the virtual channel
-     * @param flit the flit
+     * @param flit the handle of the flit
      */
-    void addFlit(long pc, long vc, const Flit& flit);
+    void addFlit(long pc, long vc, FlitHandle flit);
 
     /**
      * @brief Get the flit
      * @param pc the physical port
      * @param vc the virtual channel
-     * @return the flit
+     * @return the handle of the flit in `Global::flitPool()`
      */
-    Flit& getFlit(long pc, long vc);
+    FlitHandle getFlit(long pc, long vc) const;
 
     /**
      * @brief Remove the flit
@@ -153,23 +179,33 @@ private:
     // used for next input
 	long buffer_size_;
 	
-    std::vector<std::vector<long>> counter_;
+    long phy_port_num_;
+
+    long vc_num_;
+
+    // the credit counters (`counter`), the usages (`usage`) and the assigned inputs (`assign`)
+    // of the vcs, owned by a `RouterStateArena`
+    RouterStateSlice state_;
+
+    /**
+     * @brief Get the index of a vc in the state arrays
+     * @param phy_port the physical port
+     * @param vc the virtual channel
+     */
+    std::size_t index(long phy_port, long vc) const;
 	
     std::vector<std::vector<VCStateType>> flit_state_;
 	
-    // assigned for the input 
-	std::vector<std::vector<VCType>> assign_;
-	
-    // USED_ FREE_
-	std::vector<std::vector<VCUsageType>> usage_;
-	
     // local output buffers
-	std::vector<std::list<Flit>> outbuffers_;
+	std::vector<RingBuffer<FlitHandle>> outbuffers_;
 	
     // output address
-	std::vector<std::list<VCType>> outadd_;
+	std::vector<RingBuffer<VCType>> outadd_;
 	std::vector<long> localcounter_;
 
+    // the number of flits in all output buffers
+    std::size_t flit_count_;
+
 public:
 
     /**
@@ -183,6 +219,12 @@ public:
 
     ~OutputModules() = default;
 
+    /**
+     * @brief Use the state arrays of a `RouterStateArena`
+     * @param state the state of the router
+     */
+    void bindState(const RouterStateSlice& state);
+
     /**
      * @brief increment the counter
      * @param phy_port the physical port
@@ -241,20 +283,25 @@ public:
      * @return the out buffer size
      */
     std::size_t getOutBufferSize(long port);
+
+    /**
+     * @brief Get the number of flits in all output buffers
+     */
+    std::size_t getFlitCount() const;
     
     /**
      * @brief Add a flit
      * @param port the physical port
-     * @param flit the flit
+     * @param flit the handle of the flit
      */
-    void addFlit(long port, const Flit& flit);
+    void addFlit(long port, FlitHandle flit);
 
     /**
      * @brief Get the flit
      * @param port the port
-     * @return the flit
+     * @return the handle of the flit in `Global::flitPool()`
      */
-    Flit& getFlit(long port);
+    FlitHandle getFlit(long port) const;
 
     /**
      * @brief Remove the flit
@@ -285,11 +332,19 @@ public:
 };
 
 
+/**
+ * @brief The power of the router and its links
+ * @note The flits are not passed to Orion atom by atom, the bit switches are counted with popcount as
+ *  they happen and scaled by the Orion energies when the power is reported, which gives the same totals.
+ *  The activity mode counts the events only and records the switches expected of random payloads, and
+ *  nothing is recorded when the power model is off.
+ */
 class PowerModules {
 
 private:
     
     long flit_size_;
+	PowerModeType mode_;
 	SIM_power_router_info_t router_info_;
 	SIM_power_router_t router_power_;
 	SIM_power_arbiter_t arbiter_vc_power_;
@@ -303,6 +358,38 @@ private:
 	std::vector<std::vector<AtomType>> arbiter_vc_req_;
 	std::vector<std::vector<unsigned long>> arbiter_vc_grant_;
 
+	// the activity recorded since the last report, which is folded into the Orion counters when the power is reported
+	LIB_Type_max_uint buffer_read_count_;
+	LIB_Type_max_uint buffer_read_ones_;
+	LIB_Type_max_uint buffer_write_count_;
+	LIB_Type_max_uint buffer_write_switch_;
+	LIB_Type_max_uint crossbar_in_switch_;
+	LIB_Type_max_uint crossbar_out_switch_;
+	LIB_Type_max_uint crossbar_ctr_switch_;
+	// the link switches of every port since the start, the bus is shared by the links of the router
+	std::vector<LIB_Type_max_uint> link_switch_;
+
+	// the expected activity of a flit, which the activity mode records instead of counting the payload
+	LIB_Type_max_uint flit_read_ones_;
+	LIB_Type_max_uint flit_write_switch_;
+	LIB_Type_max_uint flit_crossbar_switch_;
+	LIB_Type_max_uint flit_link_switch_;
+
+	/**
+	 * @brief Add the buffer reads and writes since the last report to the Orion buffer counters
+	 */
+	void foldBufferActivity();
+
+	/**
+	 * @brief Add the crossbar traversals since the last report to the Orion crossbar counters
+	 */
+	void foldCrossbarActivity();
+
+	/**
+	 * @brief Set the Orion bus counters to the link traversals so far
+	 */
+	void foldLinkActivity();
+
 public:
 
     /**
@@ -311,8 +398,9 @@ public:
      * @param vc_num the number of virtual ports
      * @param flit_size the size of flit
      * @param link_length the length of link
+     * @param mode how the power is modelled
      */
-    PowerModules(long phy_port_num, long vc_num, long flit_size, long link_length);
+    PowerModules(long phy_port_num, long vc_num, long flit_size, long link_length, PowerModeType mode);
 
     ~PowerModules() = default;
 
@@ -365,6 +453,13 @@ public:
      * @return the power of link
      */
     double getLinkPower();
+
+    /**
+     * @brief Get the power of the link of a port
+     * @param port the output port
+     * @return the power of the link
+     */
+    double getLinkPower(long port);
     
     /**
      * @brief Get the power of crossbar
@@ -61,10 +61,10 @@ public:
     /**
      * @brief Construct a new CXYRouter object
      * @param config The config of the simulation
-     * @param addr The address of the router
+     * @param id The ID of the router
      * @param router_list_ The list of routers
      */
-    CXYRouter(const Config& config, AddrType addr, std::vector<BaseRouter *>& router_list_);
+    CXYRouter(const Config& config, RouterId id, std::vector<BaseRouter *>& router_list_);
 
 };
 
@@ -122,10 +122,10 @@ public:
     /**
      * @brief Construct a new CTXYRouter object
      * @param config The config of the simulation
-     * @param addr The address of the router
+     * @param id The ID of the router
      * @param router_list_ The list of routers
      */
-    CTXYRouter(const Config& config, AddrType addr, std::vector<BaseRouter *>& router_list_);
+    CTXYRouter(const Config& config, RouterId id, std::vector<BaseRouter *>& router_list_);
 
 };
 
@@ -185,10 +185,10 @@ public:
 	/**
      * @brief Construct a new CChipletMeshRouter object
      * @param config The config of the simulation
-     * @param addr The address of the router
+     * @param id The ID of the router
      * @param router_list_ The list of routers
      */
-    CChipletMeshRouter(const Config& config, AddrType addr, std::vector<BaseRouter *>& router_list_);
+    CChipletMeshRouter(const Config& config, RouterId id, std::vector<BaseRouter *>& router_list_);
 
 };
 
@@ -248,10 +248,10 @@ public:
 	/**
      * @brief Construct a new CChipletStarRouter object
      * @param config The config of the simulation
-     * @param addr The address of the router
+     * @param id The ID of the router
      * @param router_list_ The list of routers
      */
-    CChipletStarRouter(const Config& config, AddrType addr, std::vector<BaseRouter *>& router_list_);
+    CChipletStarRouter(const Config& config, RouterId id, std::vector<BaseRouter *>& router_list_);
 
 };
 
@@ -0,0 +1,64 @@
+# pragma once
+
+/**
+ * @file router_outbox.h
+ * @brief The changes a pipeline stage makes to state shared by all routers, held back.
+ */
+
+# ifndef _ROUTER_OUTBOX_H_
+# define _ROUTER_OUTBOX_H_ 1
+
+# include <vector>
+
+# include "global_defines/defines.h"
+# include "global_defines/message_define.h"
+
+class BaseRouter;
+
+/**
+ * @brief What the routers ticked by one pipeline worker would do to the shared state.
+ * @note The owner applies the outboxes, in router order, once every worker is done.
+ */
+struct RouterOutbox {
+
+    /**
+     * @brief A flit accepted at its destination
+     */
+    struct Accepted {
+        BaseRouter* router;
+        TimeType time;
+        FlitHandle flit;
+    };
+
+    /**
+     * @brief The events for `Global::messageQueue()`
+     */
+    std::vector<MessEvent> events;
+
+    /**
+     * @brief The flits to be passed to `BaseRouter::acceptFlit`
+     */
+    std::vector<Accepted> accepted;
+
+    /**
+     * @brief A router whose injection port has room again
+     */
+    struct Injection {
+        BaseRouter* router;
+        TimeType time;
+    };
+
+    /**
+     * @brief The routers to be passed to `BaseRouter::recvPacket`
+     */
+    std::vector<Injection> injections;
+
+    void clear() {
+        this->events.clear();
+        this->accepted.clear();
+        this->injections.clear();
+    }
+
+};
+
+# endif
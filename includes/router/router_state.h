@@ -0,0 +1,83 @@
+# pragma once
+
+/**
+ * @file router_state.h
+ * @brief Flat, structure-of-arrays storage of the per-VC router state.
+ */
+
+# ifndef _ROUTER_STATE_H_
+# define _ROUTER_STATE_H_ 1
+
+# include <vector>
+
+# include "global_defines/defines.h"
+
+/**
+ * @brief Pointers to the per-VC state of one router, each array is indexed by `port * vc_num + vc`.
+ */
+struct RouterStateSlice {
+    VCStateType* states = nullptr;
+    VCType* crouting = nullptr;
+    long* counter = nullptr;
+    VCUsageType* usage = nullptr;
+    VCType* assign = nullptr;
+};
+
+/**
+ * @brief The per-VC state of a number of routers, one array per field, indexed by `(router, port, vc)`.
+ * @note Every router owns an arena of its own by default.
+ *  With `StateLayoutType::NETWORK`, `Sim` allocates one arena for the whole network,
+ *  so that the per-cycle sweep over all routers walks each array contiguously.
+ */
+class RouterStateArena {
+
+private:
+
+    long phy_port_num_;
+
+    long vc_num_;
+
+    std::vector<VCStateType> states_;
+
+    std::vector<VCType> crouting_;
+
+    std::vector<long> counter_;
+
+    std::vector<VCUsageType> usage_;
+
+    std::vector<VCType> assign_;
+
+public:
+
+    /**
+     * @brief Construct a new RouterStateArena object
+     * @param router_num the number of routers
+     * @param phy_port_num the number of physical ports
+     * @param vc_num the number of virtual channels
+     * @param input_buffer_size the size of input buffer, the initial value of the credit counters
+     */
+    RouterStateArena(std::size_t router_num, long phy_port_num, long vc_num, long input_buffer_size);
+
+    /**
+     * @brief Get the state of a router
+     * @param router the index of the router
+     * @return the pointers into the arrays of the arena
+     */
+    RouterStateSlice slice(std::size_t router);
+
+    /**
+     * @brief Get the number of VCs of a router
+     */
+    std::size_t sliceSize() const;
+
+    /**
+     * @brief Copy the state of a router
+     * @param from the source
+     * @param to the destination
+     * @param size the number of VCs of the router
+     */
+    static void copy(const RouterStateSlice& from, const RouterStateSlice& to, std::size_t size);
+
+};
+
+# endif
@@ -6,6 +6,7 @@
 # include "global.h"
 # include "router/base_router.h"
 # include "alg/shortest_path_routing.h"
+# include "alg/routing_cache.h"
 
 # include "graph.h"
 
@@ -13,15 +14,7 @@ class TopoInfo {
 
 public:
 
-    struct SLinkInfo {
-		
-        TAddressNumber neighbourPort;
-		
-        TimeType linkDelay;
-		
-        TAddressNumber neighbour;
-	
-    };
+    using SLinkInfo = ShortestPath::SLinkInfo;
 
 	GraphLib::graph_t topo0;
 
@@ -33,7 +26,7 @@ public:
 
     TAddressNumber vertexCnt;
 
-    std::unique_ptr<std::vector<SLinkInfo>[]> portMap;
+    ShortestPath::TPortMap portMap;
 
     std::unique_ptr<std::unordered_map<TAddressNumber, TAddressNumber>[]> nextHop_port_map;
 
@@ -51,9 +44,19 @@ public:
 
     void setTopoVertices();
 
-    void calRoutingTable();
+    /**
+     * @brief Compute the routing tables, or load them from the cache
+     * @param cache The routing cache
+     * @param key The key of the topology in the cache
+     */
+    void calRoutingTable(const RoutingCache& cache, std::uint64_t key);
 
-    TopoInfo(const std::string& topo_file_path);
+    /**
+     * @brief Read a graph topology and compute its routing tables
+     * @param topo_file_path The topology file
+     * @param routing_cache_dir The directory the routing tables are cached in, empty for none
+     */
+    TopoInfo(const std::string& topo_file_path, const std::string& routing_cache_dir);
 
 };
 
@@ -88,6 +91,13 @@ protected:
      * @note The result will be stored in `next_addr`
      */
     void getNextAddress(AddrType& next_addr, long port);
+
+    /**
+     * @brief get the router at the other end of a port
+     * @param port The port
+     * @return The ID of the router
+     */
+    RouterId getNextRouterId(long port);
 	
     /**
      * @brief get the wire pc
@@ -103,6 +113,13 @@ protected:
      * @note The result will be stored in `from`
      */
     void getFromRouter(AddrType& from, long port);
+
+    /**
+     * @brief get the router sending to a port
+     * @param port The port
+     * @return The ID of the router
+     */
+    RouterId getFromRouterId(long port);
 	
     /**
      * @brief get the from port
@@ -121,11 +138,16 @@ public:
 	/**
      * @brief Construct a new CGraphTopo object
      * @param config The config of the simulation
-     * @param addr The address of the router
+     * @param id The ID of the router
      * @param router_list_ The list of routers
      * @param topo_info The graph topology information
      */
-    CGraphTopo(const Config& config, AddrType addr, std::vector<BaseRouter *>& router_list_, TopoInfo& topo_info);
+    CGraphTopo(const Config& config, RouterId id, std::vector<BaseRouter *>& router_list_, TopoInfo& topo_info);
+
+    /**
+     * @brief Get the number of ports, one per neighbour plus the local port
+     */
+    long getPortNumber() const override;
 
 };
 
@@ -138,15 +160,7 @@ public:
         double delay;
     };
 
-    struct SLinkInfo {
-		
-        TAddressNumber neighbourPort;
-		
-        TimeType linkDelay;
-		
-        TAddressNumber neighbour;
-	
-    };
+    using SLinkInfo = ShortestPath::SLinkInfo;
     
     double reconfigPeriod;
     
@@ -172,9 +186,9 @@ public:
 
     ShortestPath::TIntMatrix old_routingTable;
 
-    std::unique_ptr<std::vector<SLinkInfo>[]> portMap;
+    ShortestPath::TPortMap portMap;
 
-    std::unique_ptr<std::vector<SLinkInfo>[]> old_portMap;
+    ShortestPath::TPortMap old_portMap;
 	
     std::unique_ptr<std::unordered_map<TAddressNumber, TAddressNumber>[]> nextHop_port_map;
     
@@ -190,6 +204,32 @@ public:
 
     std::unique_ptr<GraphLib::vertex_t[]> topoVertices;
 
+    /**
+     * @brief The edges of the flows of the current period, added to `topo0` to get `curTopo`
+     */
+    std::vector<GraphLib::edge_t> addedEdges;
+
+    /**
+     * @brief The delay table of `topo0` by vertex index, which the tables of every period are updated from
+     */
+    ShortestPath::TMatrix index_delayTable0;
+
+    ShortestPath::TMatrix index_energyTable0;
+
+    ShortestPath::TIntMatrix index_routingTable0;
+
+    RoutingCache routingCache;
+
+    /**
+     * @brief The key of the tables of the topology before any reconfiguration
+     */
+    std::uint64_t topologyKey;
+
+    /**
+     * @brief The key the period number is hashed into to get the key of the tables of a period
+     */
+    std::uint64_t reconfigKey;
+
     void readTopo(const std::string& topo_file_path);
 
     void setPipelineDelay(GraphLib::graph_t& topo);
@@ -200,7 +240,21 @@ public:
 
     void setTopoVertices(GraphLib::graph_t& topo);
 
-    void calRoutingTable(GraphLib::graph_t& topo);
+    /**
+     * @brief Compute the routing tables of a topology, or load them from the cache
+     * @param topo The topology
+     * @param cache The routing cache
+     * @param key The key of the topology in the cache
+     */
+    void calRoutingTable(GraphLib::graph_t& topo, const RoutingCache& cache, std::uint64_t key);
+
+    /**
+     * @brief Compute the shortest path tables of a topology by vertex index
+     * @param topo The topology, `topo0` with `addedEdges`
+     * @note The tables of `topo0` are computed once and updated for the edges added.
+     */
+    void calIndexTables(GraphLib::graph_t& topo, ShortestPath::TMatrix& index_delayTable,
+        ShortestPath::TMatrix& index_energyTable, ShortestPath::TIntMatrix& index_routingTable);
     
     void readReconfigurationFile(const std::string& reconfigurationFilePath);
     
@@ -218,7 +272,14 @@ public:
 
     void reconfigurate(TimeType reconfigurationTime, TimeType next_reconfigurationTime);
 
-    ReconfigTopoInfo(const std::string& topo_file_path, const std::string& reconfig_file_path);
+    /**
+     * @brief Read a graph topology and its reconfigurations and compute the first routing tables
+     * @param topo_file_path The topology file
+     * @param reconfig_file_path The reconfiguration file
+     * @param routing_cache_dir The directory the routing tables of every period are cached in, empty for none
+     */
+    ReconfigTopoInfo(const std::string& topo_file_path, const std::string& reconfig_file_path,
+        const std::string& routing_cache_dir);
 
 };
 
@@ -251,6 +312,13 @@ protected:
      * @note The result will be stored in `next_addr`
      */
     void getNextAddress(AddrType& next_addr, long port);
+
+    /**
+     * @brief get the router at the other end of a port
+     * @param port The port
+     * @return The ID of the router
+     */
+    RouterId getNextRouterId(long port);
 	
     /**
      * @brief get the wire pc
@@ -266,6 +334,13 @@ protected:
      * @note The result will be stored in `from`
      */
     void getFromRouter(AddrType& from, long port);
+
+    /**
+     * @brief get the router sending to a port
+     * @param port The port
+     * @return The ID of the router
+     */
+    RouterId getFromRouterId(long port);
 	
     /**
      * @brief get the from port
@@ -285,7 +360,7 @@ protected:
 
 public:
 
-    CReconfigTopoRouter(const Config& config, AddrType addr, std::vector<BaseRouter *>& router_list_, ReconfigTopoInfo& topo_info);
+    CReconfigTopoRouter(const Config& config, RouterId id, std::vector<BaseRouter *>& router_list_, ReconfigTopoInfo& topo_info);
 
 };
 
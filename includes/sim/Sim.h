@@ -3,13 +3,92 @@
 # ifndef _SIM_H_
 # define _SIM_H_ 1
 
+# include <algorithm>
 # include <thread>
+# include <chrono>
+# include <cmath>
+# include <memory>
+# include <numeric>
 
 # include "global.h"
+# include "global_defines/event_trace.h"
+# include "global_defines/telemetry.h"
 # include "preprocess/config.h"
 # include "router/base_router.h"
 # include "router/router.h"
 # include "router/topo_router.h"
+# include "router/router_outbox.h"
+# include "sim/pipeline_workers.h"
+# include "sim/partition.h"
+
+/**
+ * @brief The totals of a router at the start of a telemetry window
+ */
+struct TelemetryTotals {
+
+    double buffer_energy = 0;
+
+    double crossbar_energy = 0;
+
+    double arbiter_energy = 0;
+
+    /**
+     * @brief The energy of the link of every port
+     */
+    std::vector<double> link_energy;
+
+    TimeType total_delay = 0;
+
+    std::size_t injected_flits = 0;
+
+    std::size_t accepted_flits = 0;
+
+    std::size_t accepted_packets = 0;
+
+};
+
+/**
+ * @brief The read-only inputs several simulations can share, e.g. in a parameter sweep
+ */
+struct SimInputs {
+
+    /**
+     * @brief The parsed trace, copied by the simulation
+     */
+    const InputTrace* trace = nullptr;
+
+    /**
+     * @brief The graph topology and its routing tables, with `RoutingType::GRAPH_TOPO`
+     */
+    TopoInfo* topo_info = nullptr;
+
+};
+
+/**
+ * @brief The results of a simulation
+ */
+struct SimResults {
+
+    std::size_t finished;
+
+    double average_delay;
+
+    double memory_power;
+
+    double crossbar_power;
+
+    double arbiter_power;
+
+    double link_power;
+
+    double total_power;
+
+    /**
+     * @brief The system calls made reading the trace
+     */
+    std::size_t trace_syscalls;
+
+};
 
 class Sim {
 
@@ -23,36 +102,243 @@ private:
 
     std::size_t router_count_;
 
+    /**
+     * @brief The addresses of the routers, shared with the trace and reached through `Global::addressTable`
+     */
+    std::shared_ptr<const AddressTable> address_table_;
+
     std::vector<BaseRouter *> inter_network_;
 
+    /**
+     * @brief The per-VC state of all routers, with `StateLayoutType::NETWORK`
+     */
+    std::unique_ptr<RouterStateArena> router_state_;
+
+    /**
+     * @brief Whether a router is in `active_routers_` or `woken_routers_`
+     */
+    std::vector<char> router_active_;
+
+    /**
+     * @brief The routers ticked by ROUTER events with `RouterScheduleType::ACTIVE`, in index order
+     */
+    std::vector<std::size_t> active_routers_;
+
+    /**
+     * @brief The routers woken since the last ROUTER event
+     */
+    std::vector<std::size_t> woken_routers_;
+
+    /**
+     * @brief The number of routing pipeline stages run
+     */
+    std::size_t tick_count_;
+
+    /**
+     * @brief The number of routing cycles skipped while the network was empty
+     */
+    std::size_t skipped_cycles_;
+
+    /**
+     * @brief The threads running the pipeline stages, with more than one pipeline thread
+     */
+    std::unique_ptr<PipelineWorkers> workers_;
+
+    /**
+     * @brief One outbox per pipeline worker
+     */
+    std::vector<RouterOutbox> outboxes_;
+
+    /**
+     * @brief The indices of all routers, ticked by ROUTER events with `RouterScheduleType::FULL`
+     */
+    std::vector<std::size_t> all_routers_;
+
+    /**
+     * @brief The partition of every router, with more than one partition
+     */
+    std::vector<std::size_t> partition_of_;
+
+    std::vector<std::unique_ptr<Partition>> partitions_;
+
+    /**
+     * @brief The smallest delay of an event sent from one partition to another
+     */
+    TimeType lookahead_;
+
+    /**
+     * @brief The number of time windows run by the partitioned engine
+     */
+    std::size_t window_count_;
+
     struct {
         TopoInfo *topo_info = nullptr;
         ReconfigTopoInfo *reconfig_topo_info = nullptr;
     } topo_info;
 
+    /**
+     * @brief Whether `topo_info.topo_info` belongs to the caller
+     */
+    bool shared_topo_info_;
+
+    /**
+     * @brief The writer of the delay file, reached by the routers through `Global::delaySink`
+     */
+    std::unique_ptr<DelaySink> delay_sink_;
+
+    /**
+     * @brief The record of every event handled, if the configuration asks for one
+     */
+    std::unique_ptr<EventTrace> event_trace_;
+
+    /**
+     * @brief The record of the activity of every router every report period, if the configuration asks for one
+     */
+    std::unique_ptr<Telemetry> telemetry_;
+
+    /**
+     * @brief The totals of the routers at the start of the telemetry window
+     */
+    std::vector<TelemetryTotals> telemetry_totals_;
+
+    /**
+     * @brief The columns of a telemetry window, kept between windows
+     */
+    TelemetryWindow telemetry_window_;
+
+    TimeType telemetry_start_;
+
+    /**
+     * @brief The end of the report period the telemetry window is in
+     */
+    TimeType telemetry_next_;
+
     void setInitEvent();
 
-    void receive_EVG_message(MessEvent mesg);
+    void receive_EVG_message(MessEvent& mesg);
     
-    void receive_ROUTER_message(MessEvent mesg);
+    void receive_ROUTER_message(MessEvent& mesg);
+
+    void receive_WIRE_message(MessEvent& mesg);
+
+    void receive_CREDIT_message(MessEvent& mesg);
+
+    void receive_RECONFIGURATION_message(MessEvent& mesg);
+
+    BaseRouter& router(RouterId id);
+
+    /**
+     * @brief Tick a router from the next ROUTER event on, until it is idle again
+     * @param index The index of the router
+     */
+    void wakeRouter(std::size_t index);
+
+    /**
+     * @brief Move the ROUTER event straight to the next EVG, WIRE, CREDIT or RECONFIGURATION event
+     * @note Only called while no flit is in the network, so the skipped pipeline stages do nothing.
+     */
+    void skipIdleCycles();
+
+    /**
+     * @brief Log the system calls made reading the trace, per simulated cycle
+     */
+    void logTraceSyscalls() const;
+
+    /**
+     * @brief Make the event trace record of an event
+     * @param mesg The event
+     */
+    EventRecord eventRecord(const MessEvent& mesg) const;
+
+    /**
+     * @brief Write out what the event trace has recorded and log how much
+     */
+    void flushEventTrace();
+
+    /**
+     * @brief Record the telemetry window if an event ends it
+     * @param time The time of the event, the events before it have been handled
+     * @note The report periods the event skipped over, in which nothing happened, are recorded as one window.
+     */
+    void sampleTelemetry(TimeType time);
+
+    /**
+     * @brief Record what the routers did since the start of the telemetry window, and start the next one
+     * @param end The end of the window
+     */
+    void recordTelemetry(TimeType end);
+
+    /**
+     * @brief Record the last telemetry window and log how many were recorded
+     */
+    void finishTelemetry();
+
+    /**
+     * @brief Run a pipeline stage of the routers
+     * @param indices The indices of the routers, in ascending order
+     * @param routing_period The routing period of the ROUTER event
+     * @note With pipeline workers, the routers are split into contiguous ranges, one per worker,
+     *  and the outboxes are applied in router order, so the result does not depend on the number of threads.
+     */
+    void tickRouters(const std::vector<std::size_t>& indices, TimeType routing_period);
+
+    /**
+     * @brief Split the routers into partitions and compute the lookahead
+     * @note Mesh routers are split into contiguous index ranges, that is stripes along the first coordinate,
+     *  graph routers into contiguous runs of a breadth-first order.
+     */
+    void setPartitions();
 
-    void receive_WIRE_message(MessEvent mesg);
+    /**
+     * @brief Tick a router of a partition from the next ROUTER event of the partition on
+     * @param part The partition
+     * @param index The index of the router
+     * @param after_tick Whether the current time's ROUTER event has already been handled,
+     *  as for EVG events, which come last among the events of a cycle
+     */
+    void wakePartitionRouter(Partition& part, std::size_t index, bool after_tick);
 
-    void receive_CREDIT_message(MessEvent mesg);
+    /**
+     * @brief Run the events of a partition within a time window
+     * @param id The partition
+     * @param window_end The events before this time are run
+     * @param limit The events after this time are not run
+     * @param stop_tick The ROUTER events from this time on are not run, -1 for none
+     */
+    void runPartition(std::size_t id, TimeType window_end, TimeType limit, TimeType stop_tick);
 
-    void receive_RECONFIGURATION_message(MessEvent mesg);
+    /**
+     * @brief Move the routing clocks of the partitions as the sequential loop does once every injected packet
+     *  is finished: straight to the next EVG, WIRE or CREDIT event
+     * @param injected The number of trace packets injected so far
+     * @param stop_tick Set to the time of the ROUTER events the next window should stop before, when other
+     *  events come first, after which the sequential loop may move its clock again, -1 otherwise
+     * @return Whether the run goes on, the sequential loop stops once only ROUTER events are left
+     */
+    bool forwardPartitionClocks(long injected, TimeType& stop_tick);
 
-    BaseRouter& router(const AddrType& addr);
+    /**
+     * @brief The main loop of the partitioned engine
+     * @note Every window starts at the earliest pending event and lasts the lookahead, so that
+     *  no event sent across partitions falls inside it. A window also ends at the next packet
+     *  of the trace, which is injected, like every change to shared state, between windows.
+     */
+    void mainProcessPartitioned();
 
 public:
     
-    Sim(const Config& config);
+    /**
+     * @brief Construct a new Sim object
+     * @param config The configuration, which should outlive the simulation
+     * @param inputs The inputs already read, the others are read from the files of the configuration
+     */
+    Sim(const Config& config, const SimInputs& inputs = SimInputs());
     
     ~Sim();
     
     void mainProcess();
     
-    void getResults();
+    SimResults getResults();
 
 };
 
@@ -0,0 +1,85 @@
+# pragma once
+
+/**
+ * @file partition.h
+ * @brief A logical process of the partitioned (PDES) engine.
+ */
+
+# ifndef _PARTITION_H_
+# define _PARTITION_H_ 1
+
+# include <vector>
+
+# include "global_defines/defines.h"
+# include "global_defines/event_trace.h"
+# include "global_defines/message_define.h"
+# include "router/router_outbox.h"
+
+/**
+ * @brief A set of routers with its own event queue and routing clock.
+ * @note A partition only touches its own routers. Events for the routers of another partition
+ *  are kept in `outgoing` and handed over at the end of the time window, which the lookahead
+ *  guarantees they lie beyond.
+ */
+struct Partition {
+
+    /**
+     * @brief The indices of the routers, in ascending order
+     */
+    std::vector<std::size_t> routers;
+
+    MessQueue queue;
+
+    /**
+     * @brief The outbox of the routers while the partition ticks them
+     */
+    RouterOutbox outbox;
+
+    /**
+     * @brief The events for the other partitions, indexed by partition
+     */
+    std::vector<std::vector<MessEvent>> outgoing;
+
+    /**
+     * @brief The routers ticked by ROUTER events, in index order
+     */
+    std::vector<std::size_t> active_routers;
+
+    /**
+     * @brief The routers woken since the last ROUTER event
+     */
+    std::vector<std::size_t> woken_routers;
+
+    /**
+     * @brief The events recorded for the event trace in the current window
+     */
+    std::vector<EventRecord> events;
+
+    /**
+     * @brief Whether a ROUTER event is pending
+     */
+    bool clock_running = false;
+
+    /**
+     * @brief The time of the last ROUTER event
+     */
+    TimeType last_tick = -1;
+
+    /**
+     * @brief The time of the last event moving a flit or a credit
+     * @note Idle ROUTER events do not count, as the sequential engine stops before them.
+     */
+    TimeType last_time = 0;
+
+    std::size_t event_count = 0;
+
+    std::size_t tick_count = 0;
+
+    /**
+     * @brief The number of events sent to other partitions
+     */
+    std::size_t sent_count = 0;
+
+};
+
+# endif
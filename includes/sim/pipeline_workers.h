@@ -0,0 +1,102 @@
+# pragma once
+
+/**
+ * @file pipeline_workers.h
+ * @brief A fixed pool of threads running the router pipeline stages of one cycle.
+ */
+
+# ifndef _PIPELINE_WORKERS_H_
+# define _PIPELINE_WORKERS_H_ 1
+
+# include <condition_variable>
+# include <cstddef>
+# include <exception>
+# include <functional>
+# include <mutex>
+# include <thread>
+# include <vector>
+
+namespace Global {
+    struct Context;
+}
+
+/**
+ * @brief A fixed pool of threads, woken once per cycle and joined at a barrier.
+ * @note Worker 0 is the calling thread, so a pool of n workers owns n - 1 threads.
+ */
+class PipelineWorkers {
+
+private:
+
+    std::vector<std::thread> threads_;
+
+    std::mutex mutex_;
+
+    std::condition_variable start_cv_;
+
+    std::condition_variable done_cv_;
+
+    /**
+     * @brief The task of the current round
+     */
+    const std::function<void(std::size_t)>* task_;
+
+    /**
+     * @brief The simulation context of the thread calling `run`, shared with the workers
+     */
+    Global::Context* context_;
+
+    /**
+     * @brief The number of workers taking part in the current round
+     */
+    std::size_t active_;
+
+    /**
+     * @brief The number of threads still running the current round
+     */
+    std::size_t pending_;
+
+    /**
+     * @brief Bumped at the start of every round
+     */
+    std::size_t round_;
+
+    bool stop_;
+
+    /**
+     * @brief The exceptions thrown by the workers of the current round
+     */
+    std::vector<std::exception_ptr> errors_;
+
+    void loop(std::size_t worker);
+
+public:
+
+    /**
+     * @brief Construct a new PipelineWorkers object
+     * @param worker_num The number of workers, including the calling thread
+     */
+    explicit PipelineWorkers(std::size_t worker_num);
+
+    PipelineWorkers(const PipelineWorkers&) = delete;
+
+    PipelineWorkers& operator=(const PipelineWorkers&) = delete;
+
+    ~PipelineWorkers();
+
+    /**
+     * @brief Get the number of workers, including the calling thread
+     */
+    std::size_t size() const;
+
+    /**
+     * @brief Run `task(worker)` on the first `worker_num` workers and wait for all of them
+     * @param worker_num The number of workers to use, at most `size()`
+     * @param task The task
+     * @note The first exception thrown by a worker is rethrown here.
+     */
+    void run(std::size_t worker_num, const std::function<void(std::size_t)>& task);
+
+};
+
+# endif
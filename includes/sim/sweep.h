@@ -0,0 +1,95 @@
+# pragma once
+
+/**
+ * @file sweep.h
+ * @brief Run many configurations of the simulator in one process.
+ */
+
+# ifndef _SWEEP_H_
+# define _SWEEP_H_ 1
+
+# include <map>
+# include <memory>
+# include <string>
+# include <tuple>
+# include <utility>
+# include <vector>
+
+# include "global.h"
+# include "preprocess/config.h"
+# include "sim/Sim.h"
+
+# include "nlohmann/json.hpp"
+
+/**
+ * @brief A parameter sweep, whose points run concurrently, each in its own `Global::Context`
+ * @note The sweep file is either a JSON array of configurations, or an object with
+ *  - `base`: the keys shared by every point,
+ *  - `sweep`: a list of values for each swept key, whose cartesian product gives the points,
+ *  - `threads`: the number of points run at once, by default the number of cores,
+ *  - `log_file`: the log of the whole sweep,
+ *  - `summary_file`: the configuration and the results of every point, as JSON.
+ *
+ *  The trace and the graph topology are read once and shared by the points using them.
+ */
+class Sweep {
+
+private:
+
+    /**
+     * @brief The configuration of every point
+     */
+    std::vector<nlohmann::json> points_;
+
+    std::size_t thread_num_;
+
+    std::string log_fname_;
+
+    std::string summary_fname_;
+
+    /**
+     * @brief The parsed traces, by file name and network size, as packets are queued by router
+     */
+    std::map<std::tuple<std::string, long, long>, std::unique_ptr<InputTrace>> traces_;
+
+    /**
+     * @brief The graph topologies, by file name
+     */
+    std::map<std::string, std::unique_ptr<TopoInfo>> topologies_;
+
+    /**
+     * @brief Give every point its own delay file, and its own event trace and telemetry file if it writes them
+     */
+    void setDelayFiles();
+
+    /**
+     * @brief Read the trace and the topology of a point, unless another point did
+     * @param config The configuration of the point
+     * @return The inputs of the point
+     */
+    SimInputs readInputs(const Config& config);
+
+    /**
+     * @brief Run a point in a fresh context
+     * @param config The configuration of the point
+     * @param inputs The inputs of the point
+     * @return The results of the point
+     */
+    SimResults runPoint(const Config& config, const SimInputs& inputs);
+
+public:
+
+    /**
+     * @brief Construct a new Sweep object
+     * @param fname The sweep file
+     */
+    explicit Sweep(const std::string& fname);
+
+    /**
+     * @brief Run every point and write the summary
+     */
+    void run();
+
+};
+
+# endif
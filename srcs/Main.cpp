@@ -4,12 +4,19 @@
 # include "global.h"
 # include "preprocess/config.h"
 # include "sim/Sim.h"
+# include "sim/sweep.h"
 
 int main(int argc, char *argv []) {
-    Logger::setLogLevel(LogLevel::Debug);
     try {
+        if (argc == 3 && std::string(argv[1]) == "-SWEEP") {
+            Sweep sweep(argv[2]);
+            sweep.run();
+            return 0;
+        }
 		Config config(argc, argv);
         Logger::setLoggerOut(config.getLogFilePath());
+        Logger::setLogLevel(config.getLogLevel());
+        Logger::setLogOverflow(config.getLogOverflow());
 		Logger::info(fmt::runtime(std::string("\n") + Logger::stream_to_string<Config>(config)));
 		Sim sim(config);
 		sim.mainProcess();
@@ -0,0 +1,244 @@
+# include <cerrno>
+# include <cstdio>
+# include <cstring>
+# include <filesystem>
+# include <stdexcept>
+# include <vector>
+
+# include <sys/stat.h>
+# include <unistd.h>
+
+# include "alg/routing_cache.h"
+# include "global_defines/mapped_file.h"
+
+static_assert(sizeof(RoutingCacheHeader) == 32, "The routing cache header should not be padded.");
+static_assert(sizeof(int) == sizeof(std::uint32_t), "The routing table is stored as 32-bit integers.");
+
+static constexpr std::uint64_t FNV_PRIME = 0x100000001b3ULL;
+
+/**
+ * @brief Get the size of a cache file
+ * @param vertex_count The number of vertices
+ * @param link_count The number of ports of all routers
+ */
+static std::size_t getCacheSize(std::size_t vertex_count, std::size_t link_count) {
+    std::size_t table = vertex_count * vertex_count;
+    return sizeof(RoutingCacheHeader)
+        + 2 * table * sizeof(double)
+        + link_count * sizeof(double)
+        + table * sizeof(std::int32_t)
+        + (vertex_count + 1) * sizeof(std::uint32_t)
+        + 2 * link_count * sizeof(std::uint32_t);
+}
+
+/**
+ * @brief Copy a column out of a cache file and move past it
+ */
+template<typename T>
+static void readColumn(const char*& data, T* column, std::size_t count) {
+    std::memcpy(column, data, count * sizeof(T));
+    data += count * sizeof(T);
+}
+
+template<typename T>
+static void appendColumn(std::vector<char>& buffer, const T* column, std::size_t count) {
+    const char* data = reinterpret_cast<const char*>(column);
+    buffer.insert(buffer.end(), data, data + count * sizeof(T));
+}
+
+RoutingCache::RoutingCache(const std::string& dir)
+:   dir_(dir)
+{}
+
+bool RoutingCache::isEnabled() const {
+    return !this->dir_.empty();
+}
+
+std::string RoutingCache::getFname(std::uint64_t key) const {
+    char name[32];
+    std::snprintf(name, sizeof(name), "%016llx.routes", static_cast<unsigned long long>(key));
+    return (std::filesystem::path(this->dir_) / name).string();
+}
+
+std::uint64_t RoutingCache::hashFile(const std::string& fname, std::uint64_t seed) {
+    MappedFile file(fname);
+    const unsigned char* data = reinterpret_cast<const unsigned char*>(file.data());
+    for (std::size_t i = 0; i < file.size(); i++) {
+        seed = (seed ^ data[i]) * FNV_PRIME;
+    }
+    return seed;
+}
+
+std::uint64_t RoutingCache::hashValue(std::uint64_t value, std::uint64_t seed) {
+    for (int i = 0; i < 8; i++) {
+        seed = (seed ^ ((value >> (8 * i)) & 0xff)) * FNV_PRIME;
+    }
+    return seed;
+}
+
+std::uint64_t RoutingCache::getTopologyKey(const std::string& topo_file_path) {
+    std::uint64_t key = RoutingCache::hashValue(ROUTING_CACHE_VERSION_, RoutingCache::HASH_SEED);
+    key = RoutingCache::hashValue(PIPELINE_STAGE_NUMBER, key);
+    return RoutingCache::hashFile(topo_file_path, key);
+}
+
+bool RoutingCache::load(std::uint64_t key, std::size_t vertex_count,
+    ShortestPath::TMatrix& delayTable, ShortestPath::TMatrix& energyTable,
+    ShortestPath::TIntMatrix& routingTable, ShortestPath::TPortMap& portMap) const
+{
+    if (!this->isEnabled()) {
+        return false;
+    }
+    std::string fname = this->getFname(key);
+    std::error_code ec;
+    if (!std::filesystem::exists(fname, ec)) {
+        return false;
+    }
+    try {
+        MappedFile file(fname);
+        RoutingCacheHeader header;
+        if (file.size() < sizeof(header)) {
+            throw std::runtime_error("truncated header");
+        }
+        std::memcpy(&header, file.data(), sizeof(header));
+        if (std::memcmp(header.magic, ROUTING_CACHE_MAGIC_, sizeof(header.magic)) != 0
+            || header.version != ROUTING_CACHE_VERSION_
+            || header.key != key
+            || header.vertex_count != vertex_count
+            || file.size() != getCacheSize(vertex_count, header.link_count)
+        ) {
+            throw std::runtime_error("stale or corrupt");
+        }
+
+        std::size_t n = vertex_count;
+        std::size_t m = header.link_count;
+        const char* data = file.data() + sizeof(header);
+        const char* offsets_data = data + (2 * n * n + m) * sizeof(double) + n * n * sizeof(std::int32_t);
+        std::vector<std::uint32_t> offsets(n + 1);
+        std::vector<std::uint32_t> neighbour_ports(m);
+        std::vector<std::uint32_t> neighbours(m);
+        readColumn(offsets_data, offsets.data(), n + 1);
+        readColumn(offsets_data, neighbour_ports.data(), m);
+        readColumn(offsets_data, neighbours.data(), m);
+        if (offsets[0] != 0 || offsets[n] != m) {
+            throw std::runtime_error("corrupt port offsets");
+        }
+        for (std::size_t i = 0; i < n; i++) {
+            if (offsets[i + 1] <= offsets[i]) {
+                throw std::runtime_error("corrupt port offsets");
+            }
+        }
+        for (std::size_t i = 0; i < m; i++) {
+            if (neighbours[i] >= n) {
+                throw std::runtime_error("corrupt neighbours");
+            }
+        }
+
+        delayTable.resize(boost::extents[n][n]);
+        energyTable.resize(boost::extents[n][n]);
+        routingTable.resize(boost::extents[n][n]);
+        std::vector<double> link_delays(m);
+        readColumn(data, delayTable.data(), n * n);
+        readColumn(data, energyTable.data(), n * n);
+        readColumn(data, link_delays.data(), m);
+        readColumn(data, routingTable.data(), n * n);
+
+        portMap = std::make_unique<std::vector<ShortestPath::SLinkInfo>[]>(n);
+        for (std::size_t i = 0; i < n; i++) {
+            portMap[i].reserve(offsets[i + 1] - offsets[i]);
+            for (std::size_t j = offsets[i]; j < offsets[i + 1]; j++) {
+                portMap[i].push_back({
+                    static_cast<TAddressNumber>(neighbour_ports[j]),
+                    link_delays[j],
+                    static_cast<TAddressNumber>(neighbours[j])
+                });
+            }
+        }
+    } catch (const std::runtime_error& e) {
+        Logger::warn("Ignored the routing cache file {}: {}", fname, e.what());
+        return false;
+    }
+    Logger::info("Loaded the routing tables from {}.", fname);
+    return true;
+}
+
+void RoutingCache::store(std::uint64_t key, std::size_t vertex_count,
+    const ShortestPath::TMatrix& delayTable, const ShortestPath::TMatrix& energyTable,
+    const ShortestPath::TIntMatrix& routingTable, const ShortestPath::TPortMap& portMap) const
+{
+    if (!this->isEnabled()) {
+        return;
+    }
+    std::size_t n = vertex_count;
+    std::vector<std::uint32_t> offsets(n + 1, 0);
+    for (std::size_t i = 0; i < n; i++) {
+        offsets[i + 1] = offsets[i] + portMap[i].size();
+    }
+    std::size_t m = offsets[n];
+    std::vector<double> link_delays;
+    std::vector<std::uint32_t> neighbour_ports;
+    std::vector<std::uint32_t> neighbours;
+    link_delays.reserve(m);
+    neighbour_ports.reserve(m);
+    neighbours.reserve(m);
+    for (std::size_t i = 0; i < n; i++) {
+        for (auto& link : portMap[i]) {
+            link_delays.push_back(link.linkDelay);
+            neighbour_ports.push_back(link.neighbourPort);
+            neighbours.push_back(link.neighbour);
+        }
+    }
+
+    RoutingCacheHeader header;
+    std::memset(&header, 0, sizeof(header));
+    std::memcpy(header.magic, ROUTING_CACHE_MAGIC_, sizeof(header.magic));
+    header.version = ROUTING_CACHE_VERSION_;
+    header.vertex_count = n;
+    header.link_count = m;
+    header.key = key;
+
+    std::vector<char> buffer;
+    buffer.reserve(getCacheSize(n, m));
+    appendColumn(buffer, &header, 1);
+    appendColumn(buffer, delayTable.data(), n * n);
+    appendColumn(buffer, energyTable.data(), n * n);
+    appendColumn(buffer, link_delays.data(), m);
+    appendColumn(buffer, routingTable.data(), n * n);
+    appendColumn(buffer, offsets.data(), n + 1);
+    appendColumn(buffer, neighbour_ports.data(), m);
+    appendColumn(buffer, neighbours.data(), m);
+
+    std::string fname = this->getFname(key);
+    std::string tmp_fname = fname + ".XXXXXX";
+    std::error_code ec;
+    std::filesystem::create_directories(this->dir_, ec);
+    int fd = ::mkstemp(tmp_fname.data());
+    if (fd < 0) {
+        Logger::warn("Failed to create the routing cache file {}: {}", tmp_fname, std::strerror(errno));
+        return;
+    }
+    const char* data = buffer.data();
+    std::size_t size = buffer.size();
+    while (size > 0) {
+        ssize_t written = ::write(fd, data, size);
+        if (written < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            Logger::warn("Failed to write the routing cache file {}: {}", tmp_fname, std::strerror(errno));
+            ::close(fd);
+            ::unlink(tmp_fname.c_str());
+            return;
+        }
+        data += written;
+        size -= written;
+    }
+    ::fchmod(fd, 0644);
+    ::close(fd);
+    if (std::rename(tmp_fname.c_str(), fname.c_str()) != 0) {
+        Logger::warn("Failed to rename the routing cache file {}: {}", tmp_fname, std::strerror(errno));
+        ::unlink(tmp_fname.c_str());
+        return;
+    }
+    Logger::info("Stored the routing tables in {}.", fname);
+}
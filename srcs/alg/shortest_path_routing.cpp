@@ -1,4 +1,8 @@
+# include <barrier>
+# include <thread>
+
 # include "alg/shortest_path_routing.h"
+# include "sim/pipeline_workers.h"
 
 
 /**
@@ -74,9 +78,79 @@ void ShortestPath::resetMatrix(ShortestPath::TMatrix& matrix, std::size_t n, dou
 }
 
 
+/**
+ * @brief Get the delay and the energy of forwarding through every router
+ * @param g The graph.
+ * @param routerDelay The delays, by vertex index.
+ * @param forwardEnergy The energies, by vertex index.
+ */
+static void getRouterCosts(GraphLib::graph_t& g, std::vector<double>& routerDelay, std::vector<double>& forwardEnergy) {
+    std::size_t n = boost::num_vertices(g);
+    auto index = boost::get(&GraphLib::vertex_info::index, g);
+    auto vertexList = boost::vertices(g);
+    auto forwardEnergyMap = boost::get(&GraphLib::vertex_info::energyPerForwarding, g);
+    auto pipelineStageDelay = boost::get(&GraphLib::vertex_info::pipelineStageDelay, g);
+    forwardEnergy.resize(n);
+    routerDelay.resize(n);
+    std::for_each(vertexList.first, vertexList.second, [&](const GraphLib::vertex_t& v){
+        std::size_t idx = index[v];
+        forwardEnergy[idx] = forwardEnergyMap[v];
+        routerDelay[idx] = routing_delay(pipelineStageDelay, v);
+    });
+}
+
+
+/**
+ * @brief Relax the rows of a range through every router, the Floyd-Warshall loop.
+ * @param begin The first row.
+ * @param end The row after the last.
+ * @param barrier The barrier the workers meet at after every router, nullptr for one worker.
+ * @note A worker writes its own rows only. The tables are symmetric, so the update of `[j][i]` the
+ *  sequential loop makes along with `[i][j]` is made by the worker of row `j` with the same values.
+ */
+static void relaxRows(std::size_t begin, std::size_t end, std::barrier<>* barrier,
+    ShortestPath::TMatrix& delayTable, ShortestPath::TMatrix& energyTable, ShortestPath::TNextHopTable& nextHop,
+    const std::vector<double>& routerDelay, const std::vector<double>& forwardEnergy)
+{
+    std::size_t n = delayTable.shape()[0];
+    for (std::size_t k = 0; k < n; ++k){
+        // Row and column k are not changed while relaxing through k.
+        const double* dk = delayTable[k].origin();
+        const double* ek = energyTable[k].origin();
+        double rdk = routerDelay[k];
+        double fek = forwardEnergy[k];
+        for (std::size_t i = begin; i < end; ++i){
+            double dik = delayTable[i][k];
+            if (i == k || dik == std::numeric_limits<double>::infinity())
+                continue;
+            double* di = delayTable[i].origin();
+            double* ei = energyTable[i].origin();
+            int* hi = nextHop[i].origin();
+            double eik = ei[k];
+            int hik = hi[k];
+            for (std::size_t j = 0; j < n; ++j){
+                double t = dik + dk[j];
+                // Forwarding delay of router k is calculated twice, so it should be subtracted once
+                if (i != j)
+                    t -= rdk;
+                
+                if (j != k && t < di[j]) {
+                    di[j] = t;
+                    // The forwarding energy of router k needs to be subtracted
+                    ei[j] = eik + ek[j] - fek;
+                    hi[j] = hik;
+                }
+            }
+        }
+        if (barrier != nullptr)
+            barrier->arrive_and_wait();
+    }
+}
+
+
 void ShortestPath::calculateShortestPathTables(GraphLib::graph_t& g,
     ShortestPath::TMatrix& delayTable, ShortestPath::TMatrix& energyTable,
-    ShortestPath::TNextHopTable& nextHop)
+    ShortestPath::TNextHopTable& nextHop, std::size_t thread_num)
 {
     
     const double INF_WEIGHT = std::numeric_limits<double>::infinity();
@@ -93,16 +167,9 @@ void ShortestPath::calculateShortestPathTables(GraphLib::graph_t& g,
     
     // Initialize the delay and energy of the routers
     auto index = boost::get(&GraphLib::vertex_info::index, g);
-    auto vertexList = boost::vertices(g);
-    auto forwardEnergyMap = boost::get(&GraphLib::vertex_info::energyPerForwarding, g);
-    auto pipelineStageDelay = boost::get(&GraphLib::vertex_info::pipelineStageDelay, g);
-    std::vector<double> forwardEnergy(n);
-    std::vector<double> routerDelay(n);
-    std::for_each(vertexList.first, vertexList.second, [&](const GraphLib::vertex_t& v){
-        std::size_t idx = index[v];
-        forwardEnergy[idx] = forwardEnergyMap[v];
-        routerDelay[idx] = routing_delay(pipelineStageDelay, v);
-    });
+    std::vector<double> forwardEnergy;
+    std::vector<double> routerDelay;
+    getRouterCosts(g, routerDelay, forwardEnergy);
     
     // Initialize the delay and energy table
     auto edgeList = boost::edges(g);
@@ -118,22 +185,90 @@ void ShortestPath::calculateShortestPathTables(GraphLib::graph_t& g,
         setDoubleValue(energyTable, src_index, tar_index, forwardEnergy[src_index] + hopEnergyMap[e] + forwardEnergy[tar_index]);
     });
 
-    // Floyd-Warshall
-    for (std::size_t k = 0; k < n; ++k){
-        for (std::size_t i = 0; i < n; ++i){
-            for (std::size_t j = 0; j < n; ++j){
-                double t = delayTable[i][k] + delayTable[k][j];
-                // Forwarding delay of router k is calculated twice, so it should be subtracted once
-                if (i != j && j != k && i != k)
-                    t -= routerDelay[k];
-                
-                if (t < delayTable[i][j]) {
-                    delayTable[i][j] = t;
-                    // The forwarding energy of router k needs to be subtracted
-                    energyTable[i][j] = energyTable[i][k] + energyTable[k][j] - forwardEnergy[k];
-                    setDoubleHop(nextHop, i, j, nextHop[i][k], nextHop[j][k]);
+    // Floyd-Warshall, the rows split among the workers
+    if (thread_num == 0)
+        thread_num = std::max(1u, std::thread::hardware_concurrency());
+    thread_num = std::min(thread_num, n / SHORTEST_PATH_PARALLEL_ROWS);
+    if (thread_num <= 1) {
+        relaxRows(0, n, nullptr, delayTable, energyTable, nextHop, routerDelay, forwardEnergy);
+        return;
+    }
+    PipelineWorkers workers(thread_num);
+    std::barrier<> barrier(thread_num);
+    workers.run(thread_num, [&](std::size_t worker) {
+        relaxRows(n * worker / thread_num, n * (worker + 1) / thread_num, &barrier,
+            delayTable, energyTable, nextHop, routerDelay, forwardEnergy);
+    });
+}
+
+
+bool ShortestPath::addShortestPathEdges(GraphLib::graph_t& g, const std::vector<GraphLib::edge_t>& edges,
+    ShortestPath::TMatrix& delayTable, ShortestPath::TMatrix& energyTable,
+    ShortestPath::TNextHopTable& nextHop)
+{
+    // A loop or a second link between two routers replaces the first one in the full computation.
+    for (auto& e : edges) {
+        GraphLib::vertex_t a = boost::source(e, g);
+        GraphLib::vertex_t b = boost::target(e, g);
+        if (a == b)
+            return false;
+        std::size_t links = 0;
+        auto outEdges = boost::out_edges(a, g);
+        std::for_each(outEdges.first, outEdges.second, [&](const GraphLib::edge_t& oe){
+            links += boost::target(oe, g) == b;
+        });
+        if (links > 1)
+            return false;
+    }
+
+    std::size_t n = boost::num_vertices(g);
+    auto index = boost::get(&GraphLib::vertex_info::index, g);
+    auto delay = boost::get(boost::edge_weight, g);
+    auto hopEnergyMap = boost::get(boost::edge_weight2, g);
+    std::vector<double> forwardEnergy;
+    std::vector<double> routerDelay;
+    getRouterCosts(g, routerDelay, forwardEnergy);
+
+    // The delay and energy of the paths from every router to u and v, the forwarding at u or v left out
+    std::vector<double> pu(n), pv(n), qu(n), qv(n);
+    for (auto& e : edges) {
+        std::size_t u = index[boost::source(e, g)];
+        std::size_t v = index[boost::target(e, g)];
+        double c = link_delay(delay, e) + routerDelay[u] + routerDelay[v];
+        double ce = forwardEnergy[u] + hopEnergyMap[e] + forwardEnergy[v];
+        for (std::size_t i = 0; i < n; i++) {
+            pu[i] = i == u ? 0 : delayTable[u][i] - routerDelay[u];
+            pv[i] = i == v ? 0 : delayTable[v][i] - routerDelay[v];
+            qu[i] = i == u ? 0 : energyTable[u][i] - forwardEnergy[u];
+            qv[i] = i == v ? 0 : energyTable[v][i] - forwardEnergy[v];
+        }
+
+        // A path shortened by the link gets shorter to u or v as well, so only the rows
+        // of the routers getting closer to u or v are updated.
+        for (std::size_t i = 0; i < n; i++) {
+            bool toV = i != v && pu[i] + c < delayTable[i][v];
+            bool toU = i != u && pv[i] + c < delayTable[i][u];
+            if (!toV && !toU)
+                continue;
+            int hu = i == u ? static_cast<int>(v) : nextHop[i][u];
+            int hv = i == v ? static_cast<int>(u) : nextHop[i][v];
+            for (std::size_t j = 0; j < n; j++) {
+                if (i == j)
+                    continue;
+                double a = pu[i] + c + pv[j];
+                double b = pv[i] + c + pu[j];
+                if (a < delayTable[i][j] && a <= b) {
+                    delayTable[i][j] = a;
+                    energyTable[i][j] = qu[i] + ce + qv[j];
+                    nextHop[i][j] = hu;
+                }
+                else if (b < delayTable[i][j]) {
+                    delayTable[i][j] = b;
+                    energyTable[i][j] = qv[i] + ce + qu[j];
+                    nextHop[i][j] = hv;
                 }
             }
         }
     }
+    return true;
 }
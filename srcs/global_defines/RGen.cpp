@@ -1,16 +1,17 @@
 # include "global_defines/RGen.h"
 
 RGen::RGen(long seed) {
-    this->seed_ = std::make_unique<long>(seed);
-    srandom(seed);
+    this->reset_seed(seed);
 }
 
 /**
  * @brief Reset the seed of the random number generator.
  */
 void RGen::reset_seed(long seed) {
-    this->seed_ = std::make_unique<long>(seed);
-    srandom(seed);
+    // A zeroed `random_data` is required by `initstate_r`.
+    this->seeded_ = std::make_unique<SeededState>();
+    initstate_r(static_cast<unsigned int>(seed), this->seeded_->buffer,
+        sizeof(this->seeded_->buffer), &this->seeded_->data);
 }
 
 /**
@@ -20,13 +21,26 @@ void RGen::reset_seed() {
     new (&this->rd) std::random_device();
 }
 
+/**
+ * @brief Switch to a private stream.
+ */
+void RGen::reset_stream(unsigned long long seed) {
+    this->stream_ = std::make_unique<std::mt19937_64>(seed);
+}
+
 /**
  * @brief Get a random double number in [0, 1).
  * @return Random double number in [0, 1).
  */
 double RGen::random_double_01() {
-    if (this->seed_) {
-        return random() * 1.0 / RAND_MAX;
+    if (this->stream_) {
+        std::uniform_real_distribution<double> dis(0.0, 1.0);
+        return dis(*this->stream_);
+    }
+    if (this->seeded_) {
+        int32_t value;
+        random_r(&this->seeded_->data, &value);
+        return value * 1.0 / RAND_MAX;
     }
     std::uniform_real_distribution<double> dis(0.0, 1.0);
     return dis(this->rd);
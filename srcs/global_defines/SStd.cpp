@@ -18,6 +18,7 @@ void SStd::sassert(bool x, const char *file, int line, const char *message) {
             std::cerr << "Assertion failed.  Aborting." << std::endl;
             Logger::error("File: {}, Line: {}:: Assertion failed.  Aborting.", file, line);
         }
+        Logger::flush();
         abort();
     }
 }
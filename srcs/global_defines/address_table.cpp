@@ -0,0 +1,57 @@
+# include <stdexcept>
+
+# include "global_defines/address_table.h"
+
+
+AddressTable::AddressTable(std::size_t dimension, long ary)
+:   dimension_(dimension),
+    ary_(ary),
+    addresses_()
+{
+    if (dimension == 0 || dimension > MAX_DIMENSION_ || ary <= 0) {
+        throw std::runtime_error("Invalid network size for the address table");
+    }
+    std::size_t count = 1;
+    for (std::size_t i = 0; i < dimension; i++) {
+        count *= ary;
+    }
+    if (count >= INVALID_ROUTER_ID_) {
+        throw std::runtime_error("Too many routers for 32-bit router IDs");
+    }
+
+    // The last coordinate varies fastest, as the routers have always been numbered.
+    AddrType address;
+    address.resize(dimension, 0);
+    this->addresses_.reserve(count);
+    for (std::size_t id = 0; id < count; id++) {
+        this->addresses_.push_back(address);
+        for (std::size_t j = dimension; j-- > 0;) {
+            if (++address[j] < ary) {
+                break;
+            }
+            address[j] = 0;
+        }
+    }
+}
+
+std::size_t AddressTable::getDimension() const {
+    return this->dimension_;
+}
+
+long AddressTable::getAryNumber() const {
+    return this->ary_;
+}
+
+RouterId AddressTable::getId(const AddrType& address) const {
+    if (address.size() != this->dimension_) {
+        return INVALID_ROUTER_ID_;
+    }
+    std::size_t id = 0;
+    for (auto& x : address) {
+        if (x < 0 || x >= this->ary_) {
+            return INVALID_ROUTER_ID_;
+        }
+        id = id * this->ary_ + x;
+    }
+    return static_cast<RouterId>(id);
+}
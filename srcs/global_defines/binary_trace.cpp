@@ -0,0 +1,181 @@
+# include <algorithm>
+# include <cctype>
+# include <cstring>
+# include <fstream>
+# include <limits>
+# include <stdexcept>
+# include <vector>
+
+# include "global_defines/binary_trace.h"
+# include "global_defines/trace_parser.h"
+
+static_assert(sizeof(BinaryTraceHeader) % sizeof(double) == 0, "The columns should stay aligned.");
+
+BinaryTrace::BinaryTrace(const std::string& fname)
+:   BinaryTrace(MappedFile(fname), fname)
+{}
+
+BinaryTrace::BinaryTrace(MappedFile&& file, const std::string& fname)
+:   file_(std::move(file)),
+    header_(nullptr),
+    start_time_(nullptr),
+    des_time_(nullptr),
+    src_addr_(nullptr),
+    des_addr_(nullptr),
+    packet_size_(nullptr),
+    proto_dsc_(nullptr)
+{
+    this->header_ = reinterpret_cast<const BinaryTraceHeader*>(this->file_.data());
+    if (this->file_.size() < sizeof(BinaryTraceHeader)
+        || std::memcmp(this->header_->magic, BINARY_TRACE_MAGIC_, sizeof(this->header_->magic)) != 0
+        || this->header_->version != BINARY_TRACE_VERSION_
+    ) {
+        throw std::runtime_error("Invalid binary trace: " + fname);
+    }
+
+    std::size_t count = this->header_->record_count;
+    std::size_t dimension = this->header_->dimension;
+    const char* column = this->file_.data() + sizeof(BinaryTraceHeader);
+    this->start_time_ = reinterpret_cast<const double*>(column);
+    column += count * sizeof(double);
+    if (this->isProtocol()) {
+        this->des_time_ = reinterpret_cast<const double*>(column);
+        column += count * sizeof(double);
+    }
+    this->src_addr_ = reinterpret_cast<const std::int32_t*>(column);
+    column += count * dimension * sizeof(std::int32_t);
+    this->des_addr_ = reinterpret_cast<const std::int32_t*>(column);
+    column += count * dimension * sizeof(std::int32_t);
+    this->packet_size_ = reinterpret_cast<const std::int32_t*>(column);
+    column += count * sizeof(std::int32_t);
+    if (this->isProtocol()) {
+        this->proto_dsc_ = reinterpret_cast<const std::int32_t*>(column);
+        column += count * sizeof(std::int32_t);
+    }
+    if (column != this->file_.data() + this->file_.size()) {
+        throw std::runtime_error("Truncated binary trace: " + fname);
+    }
+}
+
+std::size_t BinaryTrace::size() const {
+    return this->header_->record_count;
+}
+
+std::size_t BinaryTrace::getDimension() const {
+    return this->header_->dimension;
+}
+
+bool BinaryTrace::isProtocol() const {
+    return (this->header_->flags & BINARY_TRACE_PROTOCOL_) != 0;
+}
+
+TimeType BinaryTrace::getStartTime(std::size_t index) const {
+    return this->start_time_[index];
+}
+
+TimeType BinaryTrace::getDesTime(std::size_t index) const {
+    return this->des_time_[index];
+}
+
+void BinaryTrace::getSrcAddr(std::size_t index, AddrType& address) const {
+    std::size_t dimension = this->getDimension();
+    address.clear();
+    for (std::size_t i = 0; i < dimension; i++) {
+        address.push_back(this->src_addr_[index * dimension + i]);
+    }
+}
+
+void BinaryTrace::getDesAddr(std::size_t index, AddrType& address) const {
+    std::size_t dimension = this->getDimension();
+    address.clear();
+    for (std::size_t i = 0; i < dimension; i++) {
+        address.push_back(this->des_addr_[index * dimension + i]);
+    }
+}
+
+long BinaryTrace::getPacketSize(std::size_t index) const {
+    return this->packet_size_[index];
+}
+
+long BinaryTrace::getProtoDsc(std::size_t index) const {
+    return this->proto_dsc_[index];
+}
+
+bool BinaryTrace::isBinary(const std::string& fname) {
+    std::ifstream ifs(fname, std::ios::binary);
+    char magic[sizeof(BinaryTraceHeader::magic)];
+    if (!ifs.read(magic, sizeof(magic))) {
+        return false;
+    }
+    return std::memcmp(magic, BINARY_TRACE_MAGIC_, sizeof(magic)) == 0;
+}
+
+bool BinaryTrace::isBinary(const char* data, std::size_t size) {
+    return size >= sizeof(BinaryTraceHeader::magic)
+        && std::memcmp(data, BINARY_TRACE_MAGIC_, sizeof(BinaryTraceHeader::magic)) == 0;
+}
+
+/**
+ * @brief Narrow the values of the text trace to an int32 column
+ */
+static std::vector<std::int32_t> toInt32(const std::vector<long>& values) {
+    std::vector<std::int32_t> column;
+    column.reserve(values.size());
+    for (long value : values) {
+        if (value < std::numeric_limits<std::int32_t>::min() || value > std::numeric_limits<std::int32_t>::max()) {
+            throw std::runtime_error("A value of the text trace does not fit in 32 bits: " + std::to_string(value));
+        }
+        column.push_back(static_cast<std::int32_t>(value));
+    }
+    return column;
+}
+
+template<typename T>
+static void writeColumn(std::ofstream& ofs, const std::vector<T>& column) {
+    ofs.write(reinterpret_cast<const char*>(column.data()), column.size() * sizeof(T));
+}
+
+std::size_t BinaryTrace::convert(const std::string& text_fname, const std::string& binary_fname,
+    std::size_t dimension, bool sync_protocol
+) {
+    // Records come in the format read by `InputTrace::readTraceFile`, up to an optional -1.
+    MappedFile text(text_fname);
+    TraceRecords records;
+    bool end_mark = false;
+    std::size_t consumed = TextTraceParser(dimension, sync_protocol).parse(text.data(), text.size(), records, end_mark);
+    if (!end_mark && consumed != text.size()
+        && std::any_of(text.data() + consumed, text.data() + text.size(), [](char c) { return !std::isspace(c); })
+    ) {
+        throw std::runtime_error("Truncated text trace.");
+    }
+    std::vector<double> start_time = std::move(records.start_time);
+    std::vector<double> des_time = std::move(records.des_time);
+    std::vector<std::int32_t> src_addr = toInt32(records.src_addr);
+    std::vector<std::int32_t> des_addr = toInt32(records.des_addr);
+    std::vector<std::int32_t> packet_size = toInt32(records.packet_size);
+    std::vector<std::int32_t> proto_dsc = toInt32(records.proto_dsc);
+
+    BinaryTraceHeader header;
+    std::memset(&header, 0, sizeof(header));
+    std::memcpy(header.magic, BINARY_TRACE_MAGIC_, sizeof(header.magic));
+    header.version = BINARY_TRACE_VERSION_;
+    header.dimension = dimension;
+    header.record_count = start_time.size();
+    header.flags = sync_protocol ? BINARY_TRACE_PROTOCOL_ : 0;
+
+    std::ofstream ofs(binary_fname, std::ios::binary | std::ios::trunc);
+    if (!ofs.is_open()) {
+        throw std::runtime_error("Failed to open trace file: " + binary_fname);
+    }
+    ofs.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    writeColumn(ofs, start_time);
+    writeColumn(ofs, des_time);
+    writeColumn(ofs, src_addr);
+    writeColumn(ofs, des_addr);
+    writeColumn(ofs, packet_size);
+    writeColumn(ofs, proto_dsc);
+    if (!ofs) {
+        throw std::runtime_error("Failed to write trace file: " + binary_fname);
+    }
+    return start_time.size();
+}
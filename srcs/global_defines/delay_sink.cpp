@@ -0,0 +1,411 @@
+# include <cerrno>
+# include <csignal>
+# include <cstring>
+# include <iterator>
+# include <stdexcept>
+
+# include <fcntl.h>
+# include <sys/stat.h>
+# include <unistd.h>
+
+# include "global_defines/delay_sink.h"
+# include "global_defines/SStd.h"
+# include "logger/logger.hpp"
+
+static_assert(sizeof(DelayFileHeader) == 16, "The delay file header should not be padded.");
+
+/**
+ * @brief The sinks written out by the crash handler
+ */
+static std::atomic<DelaySink*> CrashRegistry[DELAY_SINK_SLOTS_];
+
+/**
+ * @brief The signals the crash handler takes over, before the action they had
+ */
+static constexpr int CRASH_SIGNALS[] = {SIGSEGV, SIGBUS, SIGFPE, SIGABRT};
+
+/**
+ * @brief The actions of `CRASH_SIGNALS` before the crash handler, which it chains to
+ */
+static struct sigaction PreviousActions[std::size(CRASH_SIGNALS)];
+
+/**
+ * @brief Whether the sinks were written out, so that a signal raised again by the previous action does not write them twice
+ */
+static std::atomic<bool> CrashWritten(false);
+
+/**
+ * @brief The times the crash handler reads the view of a sink again while another thread publishes one
+ */
+static constexpr int CRASH_VIEW_RETRIES = 64;
+
+static std::once_flag CrashHandlerOnce;
+
+DelaySink::DelaySink(const std::string& fname, DelayFormatType format, std::size_t dimension, bool async)
+:   fname_(fname),
+    fd_(-1),
+    format_(format),
+    dimension_(dimension),
+    buffer_(DELAY_SINK_BUFFER_),
+    size_(0),
+    crash_views_(),
+    crash_generation_(0),
+    pending_written_(0),
+    drain_count_(0),
+    record_(),
+    async_(async),
+    mutex_(),
+    cv_(),
+    pending_(async ? DELAY_SINK_BUFFER_ : 0),
+    pending_size_(0),
+    stop_(false),
+    error_(),
+    writer_(),
+    slot_(-1)
+{
+    this->fd_ = ::open(fname.c_str(), O_WRONLY | O_CREAT | O_APPEND | O_CLOEXEC, 0644);
+    if (this->fd_ < 0) {
+        throw std::runtime_error("Failed to open delay file: " + fname + ": " + std::strerror(errno));
+    }
+
+    if (this->format_ == DelayFormatType::BINARY) {
+        // Records are appended to an existing binary delay file of the same dimension.
+        struct stat st;
+        DelayFileHeader header;
+        std::memset(&header, 0, sizeof(header));
+        if (::fstat(this->fd_, &st) != 0) {
+            ::close(this->fd_);
+            throw std::runtime_error("Failed to stat delay file: " + fname);
+        }
+        if (st.st_size == 0) {
+            std::memcpy(header.magic, DELAY_SINK_MAGIC_, sizeof(header.magic));
+            header.version = DELAY_SINK_VERSION_;
+            header.dimension = dimension;
+            this->appendValue(header);
+            this->commitRecord();
+        }
+        else {
+            int fd = ::open(fname.c_str(), O_RDONLY | O_CLOEXEC);
+            bool valid = fd >= 0 && ::read(fd, &header, sizeof(header)) == sizeof(header)
+                && std::memcmp(header.magic, DELAY_SINK_MAGIC_, sizeof(header.magic)) == 0
+                && header.version == DELAY_SINK_VERSION_ && header.dimension == dimension;
+            if (fd >= 0) {
+                ::close(fd);
+            }
+            if (!valid) {
+                ::close(this->fd_);
+                throw std::runtime_error("The delay file is not a binary delay file of this network: " + fname);
+            }
+        }
+    }
+
+    if (this->async_) {
+        this->writer_ = std::thread(&DelaySink::writerLoop, this);
+    }
+
+    std::call_once(CrashHandlerOnce, []() {
+        // Signals that stop the process on purpose (SIGINT, SIGTERM) are left to the application.
+        struct sigaction action;
+        std::memset(&action, 0, sizeof(action));
+        action.sa_sigaction = &DelaySink::crashHandler;
+        action.sa_flags = SA_SIGINFO;
+        sigemptyset(&action.sa_mask);
+        for (std::size_t i = 0; i < std::size(CRASH_SIGNALS); i++) {
+            ::sigaction(CRASH_SIGNALS[i], &action, &PreviousActions[i]);
+        }
+    });
+    for (long i = 0; i < DELAY_SINK_SLOTS_; i++) {
+        DelaySink* empty = nullptr;
+        if (CrashRegistry[i].compare_exchange_strong(empty, this)) {
+            this->slot_ = i;
+            break;
+        }
+    }
+}
+
+DelaySink::~DelaySink() {
+    try {
+        this->flush();
+    } catch (std::exception& e) {
+        Logger::error("Failed to flush the delay file: {}", e.what());
+    }
+    if (this->slot_ >= 0) {
+        CrashRegistry[this->slot_].store(nullptr);
+    }
+    if (this->async_) {
+        {
+            std::lock_guard<std::mutex> lock(this->mutex_);
+            this->stop_ = true;
+        }
+        this->cv_.notify_all();
+        this->writer_.join();
+    }
+    ::close(this->fd_);
+}
+
+void DelaySink::crashHandler(int signal, siginfo_t* info, void* context) {
+    if (!CrashWritten.exchange(true)) {
+        for (long i = 0; i < DELAY_SINK_SLOTS_; i++) {
+            DelaySink* sink = CrashRegistry[i].load();
+            if (sink != nullptr) {
+                sink->writeOnCrash();
+            }
+        }
+    }
+    for (std::size_t i = 0; i < std::size(CRASH_SIGNALS); i++) {
+        if (CRASH_SIGNALS[i] != signal) {
+            continue;
+        }
+        const struct sigaction& previous = PreviousActions[i];
+        if (previous.sa_flags & SA_SIGINFO) {
+            previous.sa_sigaction(signal, info, context);
+        }
+        else if (previous.sa_handler != SIG_DFL && previous.sa_handler != SIG_IGN) {
+            previous.sa_handler(signal);
+        }
+        else {
+            // The signal is blocked in its handler, so the default action runs once the handler returns.
+            ::sigaction(signal, &previous, nullptr);
+            ::raise(signal);
+        }
+        return;
+    }
+}
+
+void DelaySink::writeOnCrash() {
+    // Only async-signal-safe calls. Another thread may publish a view meanwhile,
+    // so a view is only taken when the generation is the same before and after reading it.
+    const char* data = nullptr;
+    std::size_t size = 0;
+    const char* pending = nullptr;
+    std::size_t pending_size = 0;
+    std::uint64_t drain = 0;
+    for (int attempt = 0; attempt < CRASH_VIEW_RETRIES; attempt++) {
+        std::uint64_t generation = this->crash_generation_.load(std::memory_order_acquire);
+        const CrashView& view = this->crash_views_[generation & 1];
+        data = view.data.load(std::memory_order_relaxed);
+        size = view.size.load(std::memory_order_relaxed);
+        pending = view.pending.load(std::memory_order_relaxed);
+        pending_size = view.pending_size.load(std::memory_order_relaxed);
+        drain = view.drain.load(std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (this->crash_generation_.load(std::memory_order_relaxed) == generation) {
+            break;
+        }
+    }
+
+    if (pending != nullptr) {
+        std::uint64_t progress = this->pending_written_.load(std::memory_order_acquire);
+        std::size_t written = 0;
+        if ((progress >> DELAY_SINK_PROGRESS_BITS_) == drain) {
+            written = progress & ((std::uint64_t(1) << DELAY_SINK_PROGRESS_BITS_) - 1);
+        }
+        if (written < pending_size) {
+            [[maybe_unused]] ssize_t n = ::write(this->fd_, pending + written, pending_size - written);
+        }
+    }
+    if (data != nullptr && size > 0) {
+        [[maybe_unused]] ssize_t n = ::write(this->fd_, data, size);
+    }
+}
+
+void DelaySink::publishCrashView(std::size_t size, const char* pending, std::size_t pending_size,
+    std::uint64_t drain
+) {
+    std::uint64_t generation = this->crash_generation_.load(std::memory_order_relaxed) + 1;
+    // Orders the view written below after the previous generation, for the check of the crash handler.
+    std::atomic_thread_fence(std::memory_order_release);
+    CrashView& view = this->crash_views_[generation & 1];
+    view.data.store(this->buffer_.data(), std::memory_order_relaxed);
+    view.size.store(size, std::memory_order_relaxed);
+    view.pending.store(pending, std::memory_order_relaxed);
+    view.pending_size.store(pending_size, std::memory_order_relaxed);
+    view.drain.store(drain, std::memory_order_relaxed);
+    this->crash_generation_.store(generation, std::memory_order_release);
+}
+
+void DelaySink::publishCrashView(std::size_t size) {
+    const CrashView& view = this->crash_views_[this->crash_generation_.load(std::memory_order_relaxed) & 1];
+    this->publishCrashView(size, view.pending.load(std::memory_order_relaxed),
+        view.pending_size.load(std::memory_order_relaxed), view.drain.load(std::memory_order_relaxed));
+}
+
+void DelaySink::writeAll(const char* data, std::size_t size) {
+    while (size > 0) {
+        ssize_t n = ::write(this->fd_, data, size);
+        if (n < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            throw std::runtime_error("Failed to write delay file: " + this->fname_ + ": " + std::strerror(errno));
+        }
+        data += n;
+        size -= n;
+    }
+}
+
+void DelaySink::writeAll(const char* data, std::size_t size, std::uint64_t drain) {
+    std::uint64_t tag = drain << DELAY_SINK_PROGRESS_BITS_;
+    std::size_t written = 0;
+    while (written < size) {
+        ssize_t n = ::write(this->fd_, data + written, size - written);
+        if (n < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            throw std::runtime_error("Failed to write delay file: " + this->fname_ + ": " + std::strerror(errno));
+        }
+        written += n;
+        this->pending_written_.store(tag | written, std::memory_order_release);
+    }
+}
+
+void DelaySink::writerLoop() {
+    std::unique_lock<std::mutex> lock(this->mutex_);
+    while (true) {
+        this->cv_.wait(lock, [this]() {
+            return this->pending_size_ > 0 || this->stop_;
+        });
+        if (this->pending_size_ == 0) {
+            return;
+        }
+        // The simulating thread leaves `pending_` alone until it is written.
+        const char* data = this->pending_.data();
+        std::size_t size = this->pending_size_;
+        std::uint64_t drain = this->drain_count_;
+        lock.unlock();
+        try {
+            this->writeAll(data, size, drain);
+            lock.lock();
+        } catch (std::exception& e) {
+            lock.lock();
+            if (this->error_.empty()) {
+                this->error_ = e.what();
+            }
+        }
+        this->pending_size_ = 0;
+        this->cv_.notify_all();
+    }
+}
+
+void DelaySink::drain() {
+    if (!this->async_) {
+        std::size_t size = this->size_;
+        this->size_ = 0;
+        this->drain_count_ += 1;
+        this->publishCrashView(0, this->buffer_.data(), size, this->drain_count_);
+        this->writeAll(this->buffer_.data(), size, this->drain_count_);
+        this->publishCrashView(0, nullptr, 0, 0);
+        return;
+    }
+    std::unique_lock<std::mutex> lock(this->mutex_);
+    this->cv_.wait(lock, [this]() {
+        return this->pending_size_ == 0;
+    });
+    if (!this->error_.empty()) {
+        throw std::runtime_error(this->error_);
+    }
+    std::size_t size = this->size_;
+    if (size == 0) {
+        return;
+    }
+    // The crash handler keeps the previous view while the two are swapped; the writer starts once it is published.
+    this->size_ = 0;
+    this->buffer_.swap(this->pending_);
+    this->pending_size_ = size;
+    this->drain_count_ += 1;
+    this->publishCrashView(0, this->pending_.data(), size, this->drain_count_);
+    this->cv_.notify_all();
+}
+
+void DelaySink::flush() {
+    this->drain();
+    if (this->async_) {
+        std::unique_lock<std::mutex> lock(this->mutex_);
+        this->cv_.wait(lock, [this]() {
+            return this->pending_size_ == 0;
+        });
+        if (!this->error_.empty()) {
+            throw std::runtime_error(this->error_);
+        }
+    }
+}
+
+void DelaySink::commitRecord() {
+    std::size_t size = this->size_;
+    if (size + this->record_.size() > this->buffer_.size()) {
+        this->drain();
+        size = 0;
+    }
+    if (this->record_.size() > this->buffer_.size()) {
+        this->flush();
+        this->writeAll(this->record_.data(), this->record_.size());
+    }
+    else {
+        std::memcpy(this->buffer_.data() + size, this->record_.data(), this->record_.size());
+        this->size_ = size + this->record_.size();
+        this->publishCrashView(this->size_);
+    }
+    this->record_.clear();
+}
+
+void DelaySink::appendAddress(const AddrType& address) {
+    if (this->format_ == DelayFormatType::TEXT) {
+        for (auto& x : address) {
+            fmt::format_to(std::back_inserter(this->record_), "{} ", x);
+        }
+        return;
+    }
+    Sassert(address.size() == this->dimension_, "The address does not match the delay file.");
+    for (auto& x : address) {
+        this->appendValue(static_cast<std::int32_t>(x));
+    }
+}
+
+void DelaySink::writePacket(TimeType start_time, const AddrType& src_addr, const AddrType& des_addr,
+    TimeType delay
+) {
+    if (this->format_ == DelayFormatType::TEXT) {
+        fmt::format_to(std::back_inserter(this->record_), "{} ", (long)start_time);
+        this->appendAddress(src_addr);
+        this->appendAddress(des_addr);
+        // As `std::ostream` prints a double by default.
+        fmt::format_to(std::back_inserter(this->record_), "{:g}\n", delay);
+    }
+    else {
+        this->appendValue(DelayRecordKind::PACKET);
+        this->appendValue(static_cast<std::int64_t>(start_time));
+        this->appendAddress(src_addr);
+        this->appendAddress(des_addr);
+        this->appendValue(static_cast<double>(delay));
+    }
+    this->commitRecord();
+}
+
+void DelaySink::writeTransaction(TimeType src_time, const AddrType& src_addr, const AddrType& des_addr,
+    long proto_desc, const std::vector<TimeType>& delays, bool injected
+) {
+    if (this->format_ == DelayFormatType::TEXT) {
+        fmt::format_to(std::back_inserter(this->record_), "{} ", (long)src_time);
+        this->appendAddress(src_addr);
+        this->appendAddress(des_addr);
+        fmt::format_to(std::back_inserter(this->record_), "{} {}", proto_desc, delays.size());
+        for (auto& x : delays) {
+            fmt::format_to(std::back_inserter(this->record_), " {}", (long)x);
+        }
+        const char* tail = injected ? " -1\n" : "\n";
+        this->record_.insert(this->record_.end(), tail, tail + std::strlen(tail));
+    }
+    else {
+        this->appendValue(injected ? DelayRecordKind::TRANSACTION_INJECTED : DelayRecordKind::TRANSACTION);
+        this->appendValue(static_cast<std::int64_t>(src_time));
+        this->appendAddress(src_addr);
+        this->appendAddress(des_addr);
+        this->appendValue(static_cast<std::int64_t>(proto_desc));
+        this->appendValue(static_cast<std::uint32_t>(delays.size()));
+        for (auto& x : delays) {
+            this->appendValue(static_cast<std::int64_t>(x));
+        }
+    }
+    this->commitRecord();
+}
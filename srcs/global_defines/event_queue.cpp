@@ -0,0 +1,374 @@
+# include <algorithm>
+# include <bit>
+# include <cmath>
+# include <stdexcept>
+
+# include "global_defines/event_queue.h"
+# include "global_defines/SStd.h"
+
+
+HeapEventQueue::HeapEventQueue()
+:   size_(0),
+    m_q_()
+{}
+
+void HeapEventQueue::push(MessEvent&& event) {
+    HeapType& heap = this->m_q_[event.getEventType()];
+    heap.push_back(std::move(event));
+    std::push_heap(heap.begin(), heap.end(), std::greater<MessEvent>());
+    this->size_ += 1;
+}
+
+const MessEvent& HeapEventQueue::top() const {
+    if (this->size_ == 0) {
+        throw std::runtime_error("Message queue is empty.");
+    }
+    const MessEvent* ret = nullptr;
+    for (auto iter = this->m_q_.cbegin(); iter != this->m_q_.cend(); ++iter) {
+        if (iter->second.empty()) {
+            continue;
+        }
+        if (ret == nullptr || iter->second.front() < *ret) {
+            ret = &iter->second.front();
+        }
+    }
+    return *ret;
+}
+
+MessEvent HeapEventQueue::take() {
+    return this->take(this->top().getEventType());
+}
+
+const MessEvent& HeapEventQueue::top(MessType mess_type) const {
+    auto iter = this->m_q_.find(mess_type);
+    if (iter == this->m_q_.end() || iter->second.empty()) {
+        throw std::runtime_error("Message queue is empty.");
+    }
+    return iter->second.front();
+}
+
+MessEvent HeapEventQueue::take(MessType mess_type) {
+    auto iter = this->m_q_.find(mess_type);
+    if (iter == this->m_q_.end() || iter->second.empty()) {
+        throw std::runtime_error("Message queue is empty.");
+    }
+    HeapType& heap = iter->second;
+    std::pop_heap(heap.begin(), heap.end(), std::greater<MessEvent>());
+    MessEvent ret(std::move(heap.back()));
+    heap.pop_back();
+    this->size_ -= 1;
+    return ret;
+}
+
+void HeapEventQueue::clear() {
+    this->m_q_.clear();
+    this->size_ = 0;
+}
+
+void HeapEventQueue::clear(MessType mess_type) {
+    auto iter = this->m_q_.find(mess_type);
+    if (iter == this->m_q_.end()) {
+        return;
+    }
+    this->size_ -= iter->second.size();
+    iter->second.clear();
+}
+
+std::size_t HeapEventQueue::size() const {
+    return this->size_;
+}
+
+std::size_t HeapEventQueue::size(MessType mess_type) const {
+    auto iter = this->m_q_.find(mess_type);
+    if (iter == this->m_q_.end()) {
+        return 0;
+    }
+    return iter->second.size();
+}
+
+/**
+ * @brief Get the index of the bucket covering the time
+ * @param time The time
+ * @return The bucket index, not wrapped around the wheel
+ */
+long long CalendarEventQueue::bucketIndex(TimeType time) const {
+    return static_cast<long long>(std::floor(time / this->width_));
+}
+
+CalendarEventQueue::Bucket& CalendarEventQueue::bucket(long long index) {
+    return this->wheel_[static_cast<std::size_t>(index) & (this->wheel_.size() - 1)];
+}
+
+void CalendarEventQueue::insertIntoWheel(MessEvent&& event, long long index) {
+    Bucket& b = this->bucket(index);
+    if (b.events.capacity() == 0 && !this->spare_.empty()) {
+        b.events = std::move(this->spare_.back());
+        this->spare_.pop_back();
+    }
+    MessType mess_type = event.getEventType();
+    // Events usually arrive in time order, so this is almost always an append.
+    auto pos = std::upper_bound(b.events.begin() + b.head, b.events.end(), event);
+    b.events.insert(pos, std::move(event));
+    this->countEvent(index, mess_type);
+}
+
+void CalendarEventQueue::countEvent(long long index, MessType mess_type) {
+    std::size_t position = static_cast<std::size_t>(index) & (this->wheel_.size() - 1);
+    std::size_t type = static_cast<std::size_t>(mess_type);
+    this->wheel_[position].type_count[type] += 1;
+    this->type_bits_[type][position / 64] |= std::uint64_t(1) << (position % 64);
+}
+
+void CalendarEventQueue::uncountEvent(long long index, MessType mess_type) {
+    std::size_t position = static_cast<std::size_t>(index) & (this->wheel_.size() - 1);
+    std::size_t type = static_cast<std::size_t>(mess_type);
+    if (--this->wheel_[position].type_count[type] == 0) {
+        this->type_bits_[type][position / 64] &= ~(std::uint64_t(1) << (position % 64));
+    }
+}
+
+long long CalendarEventQueue::findBucket(MessType mess_type) const {
+    const std::vector<std::uint64_t>& bits = this->type_bits_[static_cast<std::size_t>(mess_type)];
+    std::size_t mask = this->wheel_.size() - 1;
+    std::size_t start = static_cast<std::size_t>(this->cur_) & mask;
+    std::size_t word = start / 64;
+    // The buckets from `cur_` to the end of the wheel first, then those wrapped around before it:
+    // the first word is visited again at the end, when its bits from `start` on are known to be clear.
+    std::uint64_t w = bits[word] & (~std::uint64_t(0) << (start % 64));
+    for (std::size_t k = 0; k <= bits.size(); k++) {
+        if (w != 0) {
+            std::size_t position = word * 64 + static_cast<std::size_t>(std::countr_zero(w));
+            return this->cur_ + static_cast<long long>((position - start) & mask);
+        }
+        word = word + 1 == bits.size() ? 0 : word + 1;
+        w = bits[word];
+    }
+    return this->cur_ - 1;
+}
+
+void CalendarEventQueue::refillFromOverflow() {
+    long long horizon = this->cur_ + static_cast<long long>(this->wheel_.size());
+    while (!this->overflow_.empty()) {
+        long long index = this->bucketIndex(this->overflow_.front().getEventStart());
+        if (index >= horizon) {
+            break;
+        }
+        std::pop_heap(this->overflow_.begin(), this->overflow_.end(), std::greater<MessEvent>());
+        this->insertIntoWheel(std::move(this->overflow_.back()), std::max(index, this->cur_));
+        this->overflow_.pop_back();
+    }
+}
+
+void CalendarEventQueue::advance() {
+    if (this->size_ == 0) {
+        return;
+    }
+    while (true) {
+        Bucket& b = this->bucket(this->cur_);
+        if (b.head < b.events.size()) {
+            return;
+        }
+        b.head = 0;
+        if (b.events.capacity() > 0) {
+            b.events.clear();
+            this->spare_.push_back(std::move(b.events));
+            b.events = std::vector<MessEvent>();
+        }
+        if (this->size_ == this->overflow_.size()) {
+            // The wheel is empty, jump straight to the earliest overflow event.
+            this->cur_ = this->bucketIndex(this->overflow_.front().getEventStart());
+        }
+        else {
+            this->cur_ += 1;
+        }
+        this->refillFromOverflow();
+    }
+}
+
+CalendarEventQueue::CalendarEventQueue(TimeType width, std::size_t bucket_number)
+:   width_(width),
+    cur_(0),
+    size_(0),
+    type_size_(),
+    wheel_(bucket_number),
+    overflow_(),
+    spare_(),
+    type_bits_()
+{
+    Sassert(bucket_number > 0 && (bucket_number & (bucket_number - 1)) == 0,
+        "The number of calendar buckets should be a power of two.");
+    Sassert(width > 0, "The calendar bucket width should be positive.");
+    this->type_size_.fill(0);
+    this->spare_.reserve(bucket_number);
+    for (auto& bits : this->type_bits_) {
+        bits.assign((bucket_number + 63) / 64, 0);
+    }
+}
+
+void CalendarEventQueue::push(MessEvent&& event) {
+    long long index = this->bucketIndex(event.getEventStart());
+    std::size_t type = static_cast<std::size_t>(event.getEventType());
+    if (this->size_ == 0) {
+        this->cur_ = index;
+    }
+    if (index >= this->cur_ + static_cast<long long>(this->wheel_.size())) {
+        this->overflow_.push_back(std::move(event));
+        std::push_heap(this->overflow_.begin(), this->overflow_.end(), std::greater<MessEvent>());
+    }
+    else {
+        // An event earlier than the current bucket still has to come out first.
+        this->insertIntoWheel(std::move(event), std::max(index, this->cur_));
+    }
+    this->size_ += 1;
+    this->type_size_[type] += 1;
+}
+
+const MessEvent& CalendarEventQueue::top() const {
+    if (this->size_ == 0) {
+        throw std::runtime_error("Message queue is empty.");
+    }
+    const Bucket& b = this->wheel_[static_cast<std::size_t>(this->cur_) & (this->wheel_.size() - 1)];
+    return b.events[b.head];
+}
+
+MessEvent CalendarEventQueue::take() {
+    if (this->size_ == 0) {
+        throw std::runtime_error("Message queue is empty.");
+    }
+    Bucket& b = this->bucket(this->cur_);
+    MessEvent ret(std::move(b.events[b.head]));
+    this->type_size_[static_cast<std::size_t>(ret.getEventType())] -= 1;
+    this->uncountEvent(this->cur_, ret.getEventType());
+    b.head += 1;
+    this->size_ -= 1;
+    this->advance();
+    return ret;
+}
+
+/**
+ * @brief Find the earliest event with the specified message type
+ * @param mess_type The message type
+ * @param index The bucket index of the event, or `cur_ - 1` if it is in the overflow heap
+ * @return The position of the event in its bucket or in the overflow heap
+ */
+std::size_t CalendarEventQueue::find(MessType mess_type, long long& index) const {
+    index = this->findBucket(mess_type);
+    if (index >= this->cur_) {
+        // A bucket is sorted, so its first event of the type is the earliest.
+        const Bucket& b = this->wheel_[static_cast<std::size_t>(index) & (this->wheel_.size() - 1)];
+        for (std::size_t j = b.head; j < b.events.size(); j++) {
+            if (b.events[j].getEventType() == mess_type) {
+                return j;
+            }
+        }
+        Sassert(false, "The calendar bucket counts are out of date.");
+    }
+    std::size_t ret = this->overflow_.size();
+    for (std::size_t j = 0; j < this->overflow_.size(); j++) {
+        if (this->overflow_[j].getEventType() == mess_type
+            && (ret == this->overflow_.size() || this->overflow_[j] < this->overflow_[ret])
+        ) {
+            ret = j;
+        }
+    }
+    index = this->cur_ - 1;
+    return ret;
+}
+
+const MessEvent& CalendarEventQueue::top(MessType mess_type) const {
+    if (this->size(mess_type) == 0) {
+        throw std::runtime_error("Message queue is empty.");
+    }
+    long long index;
+    std::size_t pos = this->find(mess_type, index);
+    if (index < this->cur_) {
+        return this->overflow_[pos];
+    }
+    const Bucket& b = this->wheel_[static_cast<std::size_t>(index) & (this->wheel_.size() - 1)];
+    return b.events[pos];
+}
+
+MessEvent CalendarEventQueue::take(MessType mess_type) {
+    if (this->size(mess_type) == 0) {
+        throw std::runtime_error("Message queue is empty.");
+    }
+    long long index;
+    std::size_t pos = this->find(mess_type, index);
+    std::vector<MessEvent>& events = index < this->cur_ ? this->overflow_ : this->bucket(index).events;
+    MessEvent ret(std::move(events[pos]));
+    events.erase(events.begin() + pos);
+    if (index < this->cur_) {
+        std::make_heap(this->overflow_.begin(), this->overflow_.end(), std::greater<MessEvent>());
+    }
+    else {
+        this->uncountEvent(index, mess_type);
+    }
+    this->size_ -= 1;
+    this->type_size_[static_cast<std::size_t>(mess_type)] -= 1;
+    this->advance();
+    return ret;
+}
+
+void CalendarEventQueue::clear() {
+    for (auto& b : this->wheel_) {
+        b.events.clear();
+        b.head = 0;
+        b.type_count.fill(0);
+    }
+    for (auto& bits : this->type_bits_) {
+        std::fill(bits.begin(), bits.end(), 0);
+    }
+    this->overflow_.clear();
+    this->size_ = 0;
+    this->type_size_.fill(0);
+}
+
+void CalendarEventQueue::clear(MessType mess_type) {
+    auto same_type = [mess_type](const MessEvent& event) {
+        return event.getEventType() == mess_type;
+    };
+    std::size_t type = static_cast<std::size_t>(mess_type);
+    std::vector<std::uint64_t>& bits = this->type_bits_[type];
+    // Only the buckets holding events of the type are visited.
+    for (std::size_t word = 0; word < bits.size(); word++) {
+        for (std::uint64_t w = bits[word]; w != 0; w &= w - 1) {
+            Bucket& b = this->wheel_[word * 64 + static_cast<std::size_t>(std::countr_zero(w))];
+            b.events.erase(std::remove_if(b.events.begin() + b.head, b.events.end(), same_type), b.events.end());
+            b.type_count[type] = 0;
+        }
+        bits[word] = 0;
+    }
+    this->overflow_.erase(std::remove_if(this->overflow_.begin(), this->overflow_.end(), same_type), this->overflow_.end());
+    std::make_heap(this->overflow_.begin(), this->overflow_.end(), std::greater<MessEvent>());
+    this->size_ -= this->type_size_[static_cast<std::size_t>(mess_type)];
+    this->type_size_[static_cast<std::size_t>(mess_type)] = 0;
+    this->advance();
+}
+
+std::size_t CalendarEventQueue::size() const {
+    return this->size_;
+}
+
+std::size_t CalendarEventQueue::size(MessType mess_type) const {
+    return this->type_size_[static_cast<std::size_t>(mess_type)];
+}
+
+TimeType CalendarEventQueue::defaultWidth() {
+    const TimeType delays[] = {WIRE_DELAY_, PIPE_DELAY_, CREDIT_DELAY_};
+    TimeType base = *std::min_element(std::begin(delays), std::end(delays));
+    for (long d = 1; d <= 1000; d++) {
+        TimeType quantum = base / d;
+        bool divides = true;
+        for (TimeType delay : delays) {
+            TimeType r = delay / quantum;
+            if (std::abs(r - std::round(r)) > S_ELPS_ * r) {
+                divides = false;
+                break;
+            }
+        }
+        if (divides) {
+            return quantum;
+        }
+    }
+    return base;
+}
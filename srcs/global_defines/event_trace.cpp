@@ -0,0 +1,77 @@
+# include <cerrno>
+# include <cstring>
+# include <stdexcept>
+
+# include <fcntl.h>
+# include <unistd.h>
+
+# include "global_defines/event_trace.h"
+
+static_assert(sizeof(EventTraceHeader) == 16, "The event trace header should not be padded.");
+static_assert(sizeof(EventRecord) == 40, "The event records should not be padded.");
+
+EventTrace::EventTrace(const std::string& fname, std::size_t router_count)
+:   fname_(fname),
+    fd_(-1),
+    buffer_(),
+    count_(0)
+{
+    this->fd_ = ::open(fname.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+    if (this->fd_ < 0) {
+        throw std::runtime_error("Failed to open event trace: " + fname + ": " + std::strerror(errno));
+    }
+    this->buffer_.reserve(EVENT_TRACE_BUFFER_);
+
+    EventTraceHeader header;
+    std::memset(&header, 0, sizeof(header));
+    std::memcpy(header.magic, EVENT_TRACE_MAGIC_, sizeof(header.magic));
+    header.version = EVENT_TRACE_VERSION_;
+    header.router_count = router_count;
+    try {
+        this->writeAll(reinterpret_cast<const char*>(&header), sizeof(header));
+    } catch (...) {
+        ::close(this->fd_);
+        throw;
+    }
+}
+
+EventTrace::~EventTrace() {
+    try {
+        this->flush();
+    } catch (std::exception&) {}
+    ::close(this->fd_);
+}
+
+void EventTrace::writeAll(const char* data, std::size_t size) {
+    while (size > 0) {
+        ssize_t n = ::write(this->fd_, data, size);
+        if (n < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            throw std::runtime_error("Failed to write event trace: " + this->fname_ + ": " + std::strerror(errno));
+        }
+        data += n;
+        size -= n;
+    }
+}
+
+void EventTrace::record(const std::vector<EventRecord>& records) {
+    for (auto& record : records) {
+        this->record(record);
+    }
+}
+
+void EventTrace::flush() {
+    this->writeAll(reinterpret_cast<const char*>(this->buffer_.data()), this->buffer_.size() * sizeof(EventRecord));
+    this->count_ += this->buffer_.size();
+    this->buffer_.clear();
+}
+
+std::size_t EventTrace::getCount() const {
+    return this->count_ + this->buffer_.size();
+}
+
+const std::string& EventTrace::getFname() const {
+    return this->fname_;
+}
@@ -0,0 +1,64 @@
+# include <algorithm>
+# include <utility>
+
+# include "global_defines/flit_pool.h"
+# include "global_defines/SStd.h"
+
+
+FlitPool::FlitPool()
+:   slots_(),
+    free_(),
+    peak_(0)
+{}
+
+FlitHandle FlitPool::allocate(long flit_id, FlitType flit_type,
+    RouterId src, RouterId des,
+    TimeType start_time, TPacketId packet_id)
+{
+    FlitHandle handle;
+    if (this->free_.empty()) {
+        Sassert(this->slots_.size() < INVALID_FLIT_HANDLE_, "Flit pool exhausted.");
+        handle = static_cast<FlitHandle>(this->slots_.size());
+        this->slots_.emplace_back();
+    }
+    else {
+        handle = this->free_.back();
+        this->free_.pop_back();
+    }
+    Flit& slot = this->slots_[handle];
+    // Keep the payload storage of the recycled slot.
+    DataType data(std::move(slot.getData()));
+    data.clear();
+    slot = Flit(flit_id, flit_type, src, des, start_time, std::move(data), packet_id);
+    this->peak_ = std::max(this->peak_, this->size());
+    return handle;
+}
+
+void FlitPool::release(FlitHandle handle) {
+    Sassert(handle < this->slots_.size(), "Invalid flit handle.");
+    this->free_.push_back(handle);
+}
+
+Flit& FlitPool::get(FlitHandle handle) {
+    return this->slots_[handle];
+}
+
+const Flit& FlitPool::get(FlitHandle handle) const {
+    return this->slots_[handle];
+}
+
+std::size_t FlitPool::size() const {
+    return this->slots_.size() - this->free_.size();
+}
+
+std::size_t FlitPool::getPeakSize() const {
+    return this->peak_;
+}
+
+void FlitPool::clear() {
+    this->slots_.clear();
+    this->slots_.shrink_to_fit();
+    this->free_.clear();
+    this->free_.shrink_to_fit();
+    this->peak_ = 0;
+}
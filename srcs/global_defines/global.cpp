@@ -29,6 +29,99 @@ std::ostream& operator<<(std::ostream& os, const MessType& MessType_) {
     return os;
 }
 
+/**
+ * @brief `operator<<` overload for `EventQueueType`.
+ */
+std::ostream& operator<<(std::ostream& os, const EventQueueType& EventQueueType_) {
+    switch (EventQueueType_) {
+        case EventQueueType::HEAP:
+            os << "HEAP";
+            break;
+        case EventQueueType::CALENDAR:
+            os << "CALENDAR";
+            break;
+        default:
+            os << "UNKNOWN";
+            break;
+    }
+    return os;
+}
+
+/**
+ * @brief `operator<<` overload for `StateLayoutType`.
+ */
+std::ostream& operator<<(std::ostream& os, const StateLayoutType& StateLayoutType_) {
+    switch (StateLayoutType_) {
+        case StateLayoutType::PER_ROUTER:
+            os << "PER_ROUTER";
+            break;
+        case StateLayoutType::NETWORK:
+            os << "NETWORK";
+            break;
+        default:
+            os << "UNKNOWN";
+            break;
+    }
+    return os;
+}
+
+/**
+ * @brief `operator<<` overload for `DelayFormatType`.
+ */
+std::ostream& operator<<(std::ostream& os, const DelayFormatType& DelayFormatType_) {
+    switch (DelayFormatType_) {
+        case DelayFormatType::TEXT:
+            os << "TEXT";
+            break;
+        case DelayFormatType::BINARY:
+            os << "BINARY";
+            break;
+        default:
+            os << "UNKNOWN";
+            break;
+    }
+    return os;
+}
+
+/**
+ * @brief `operator<<` overload for `RouterScheduleType`.
+ */
+std::ostream& operator<<(std::ostream& os, const RouterScheduleType& RouterScheduleType_) {
+    switch (RouterScheduleType_) {
+        case RouterScheduleType::FULL:
+            os << "FULL";
+            break;
+        case RouterScheduleType::ACTIVE:
+            os << "ACTIVE";
+            break;
+        default:
+            os << "UNKNOWN";
+            break;
+    }
+    return os;
+}
+
+/**
+ * @brief `operator<<` overload for `PowerModeType`.
+ */
+std::ostream& operator<<(std::ostream& os, const PowerModeType& PowerModeType_) {
+    switch (PowerModeType_) {
+        case PowerModeType::FULL:
+            os << "FULL";
+            break;
+        case PowerModeType::ACTIVITY:
+            os << "ACTIVITY";
+            break;
+        case PowerModeType::OFF:
+            os << "OFF";
+            break;
+        default:
+            os << "UNKNOWN";
+            break;
+    }
+    return os;
+}
+
 /**
  * @brief `operator<<` overload for `RoutingType`.
  */
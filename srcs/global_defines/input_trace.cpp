@@ -1,9 +1,14 @@
 
 # include "global_defines/input_trace.h"
+# include "global_defines/binary_trace.h"
+# include "global_defines/live_trace_feed.h"
 
 
-FileSizeType InputTrace::getFileSize(const std::string& trace_file_name) {
-    return std::filesystem::file_size(trace_file_name);
+void InputTrace::copyAddress(AddrType& address, const long* values) {
+    address.clear();
+    for (std::size_t i = 0; i < this->dimension_; i++) {
+        address.push_back(values[i]);
+    }
 }
 
 void InputTrace::readAddress(AddrType& address, std::ifstream& trace_file) {
@@ -15,90 +20,220 @@ void InputTrace::readAddress(AddrType& address, std::ifstream& trace_file) {
     }
 }
 
-InputTrace::InputTrace(const std::string& trace_file_name, bool sync_protocol_enable, std::size_t dimension)
+InputTrace::InputTrace(const std::string& trace_file_name, bool sync_protocol_enable,
+    std::shared_ptr<const AddressTable> addresses)
 :   trace_file_name_(trace_file_name),
     sync_protocol_enable_(sync_protocol_enable),
-    has_read_(0),
-    dimension_(dimension),
+    addresses_(addresses),
+    dimension_(addresses->getDimension()),
     input_traces_(),
-    router_traces_(),
+    router_traces_(addresses->size()),
     read_end(false),
-    count_(0)
+    count_(0),
+    window_(0),
+    stream_(),
+    binary_(),
+    binary_next_(0),
+    next_(),
+    read_ahead_full_(false),
+    source_()
 {}
 
+void InputTrace::setStreamWindow(TimeType window) {
+    if (window < 0) {
+        throw std::runtime_error("The trace window should not be negative");
+    }
+    this->window_ = window;
+}
+
+void InputTrace::openStream() {
+    if (this->sync_protocol_enable_) {
+        throw std::runtime_error("Traces of the sync protocol cannot be streamed");
+    }
+    if (BinaryTrace::isBinary(this->trace_file_name_)) {
+        this->binary_ = std::make_shared<BinaryTrace>(this->trace_file_name_);
+        if (this->binary_->getDimension() != this->dimension_ || this->binary_->isProtocol()) {
+            throw std::runtime_error(std::string("The binary trace does not match the network: ")
+                + this->trace_file_name_);
+        }
+    }
+    else {
+        this->stream_ = std::make_shared<std::ifstream>(this->trace_file_name_);
+        if (!this->stream_->is_open()) {
+            throw std::runtime_error(std::string("Failed to open trace file: ") + this->trace_file_name_);
+        }
+    }
+    Logger::info("Streaming the trace with a window of {}.", this->window_);
+    this->readNextPacket();
+}
+
+void InputTrace::readNextPacket() {
+    SPacket spacket(this->dimension_);
+    bool found = false;
+    if (this->binary_) {
+        if (this->binary_next_ < this->binary_->size()) {
+            spacket.start_time = this->binary_->getStartTime(this->binary_next_);
+            this->binary_->getSrcAddr(this->binary_next_, spacket.src_addr);
+            this->binary_->getDesAddr(this->binary_next_, spacket.des_addr);
+            spacket.packet_size = this->binary_->getPacketSize(this->binary_next_);
+            this->binary_next_++;
+            found = true;
+        }
+    }
+    else if (*this->stream_ >> spacket.start_time && spacket.start_time != -1) {
+        this->readAddress(spacket.src_addr, *this->stream_);
+        this->readAddress(spacket.des_addr, *this->stream_);
+        *this->stream_ >> spacket.packet_size;
+        found = true;
+    }
+
+    if (!found) {
+        this->next_.reset();
+        this->stream_.reset();
+        this->binary_.reset();
+        this->read_end = true;
+        Logger::info("Read packets: {}", this->count_);
+        return;
+    }
+    spacket.id = this->count_;
+    this->count_++;
+    this->next_ = spacket;
+}
+
+void InputTrace::queueNextPacket() {
+    TimeType start_time = this->next_->start_time;
+    this->addTrace(*this->next_);
+    this->readNextPacket();
+    if (this->next_ && this->next_->start_time < start_time) {
+        throw std::runtime_error(std::string("A streamed trace should be sorted by start time: ")
+            + this->trace_file_name_);
+    }
+}
+
+void InputTrace::advance(TimeType now) {
+    // The queue is never left empty while the stream has packets, so that the next EVG event can be set.
+    while (this->next_ && (this->next_->start_time < now + this->window_ || this->input_traces_.empty())) {
+        this->queueNextPacket();
+    }
+}
+
 void InputTrace::readTraceFile() {
     if (this->read_end) return;
-    std::ifstream trace_file(this->trace_file_name_);
-    if (!trace_file.is_open()) {
-        throw std::runtime_error(std::string("Failed to open trace file: ") + this->trace_file_name_);
-    }
-    if (this->has_read_ == this->getFileSize(this->trace_file_name_)) {
+    if (this->window_ > 0) {
+        if (!this->stream_ && !this->binary_) {
+            this->openStream();
+        }
         return;
     }
-    trace_file.seekg(this->has_read_, std::ios::beg);
+    if (!this->source_) {
+        this->source_ = std::make_shared<FileTraceSource>(this->trace_file_name_, this->dimension_,
+            this->sync_protocol_enable_);
+    }
+    this->takeSource(false);
+}
+
+void InputTrace::addRecords(const TraceRecords& records) {
     std::size_t count = this->count_;
-    
-    if (!this->sync_protocol_enable_) {
-        SPacket spacket(this->dimension_);
-        while (trace_file >> spacket.start_time) {
-            if (spacket.start_time == -1) {
-                this->read_end = true;
-                break;
-            }
-            this->readAddress(spacket.src_addr, trace_file);
-            this->readAddress(spacket.des_addr, trace_file);
-            trace_file >> spacket.packet_size;
+    for (std::size_t i = 0; i < records.size(); i++) {
+        const long* src_addr = records.src_addr.data() + i * this->dimension_;
+        const long* des_addr = records.des_addr.data() + i * this->dimension_;
+        if (!this->sync_protocol_enable_) {
+            SPacket spacket(this->dimension_);
+            spacket.start_time = records.start_time[i];
+            this->copyAddress(spacket.src_addr, src_addr);
+            this->copyAddress(spacket.des_addr, des_addr);
+            spacket.packet_size = records.packet_size[i];
             spacket.id = count;
-            
+
             this->addTrace(spacket);
-            
-            count++;
         }
-    }
-    else {
-        ProtoPacket packet(this->dimension_);
-        while (trace_file >> packet.src_time) {
-            if (packet.src_time == -1) {
-                this->read_end = true;
-                break;
-            }
-            trace_file >> packet.des_time;
-            this->readAddress(packet.src_addr, trace_file);
-            this->readAddress(packet.des_addr, trace_file);
-            trace_file >> packet.packet_size >> packet.proto_dsc;
+        else {
+            ProtoPacket packet(this->dimension_);
+            packet.src_time = records.start_time[i];
+            packet.des_time = records.des_time[i];
+            this->copyAddress(packet.src_addr, src_addr);
+            this->copyAddress(packet.des_addr, des_addr);
+            packet.packet_size = records.packet_size[i];
+            packet.proto_dsc = records.proto_dsc[i];
             packet.id = count;
             SPacket spacket = ___add_trans___(packet);
-            
+
             this->addTrace(spacket);
-            
-            count++;
         }
+        count++;
     }
-    trace_file.close();
     Logger::info("Read packets: {}", count - this->count_);
     this->count_ = count;
-    this->has_read_ = this->getFileSize(this->trace_file_name_);
+}
+
+void InputTrace::setLive(long poll_interval) {
+    if (this->window_ > 0 || BinaryTrace::isBinary(this->trace_file_name_)) {
+        throw std::runtime_error("A live trace should be a text trace read whole: " + this->trace_file_name_);
+    }
+    this->source_ = std::make_shared<LiveTraceFeed>(this->trace_file_name_, this->dimension_,
+        this->sync_protocol_enable_, poll_interval);
+}
+
+void InputTrace::takeSource(bool wait) {
+    TraceRecords records;
+    this->read_end = this->source_->read(records, wait);
+    if (records.size() > 0) {
+        this->addRecords(records);
+    }
+}
+
+void InputTrace::waitForPackets() {
+    this->readTraceFile();
+    while (this->source_ && this->input_traces_.empty() && !this->read_end) {
+        this->takeSource(true);
+    }
+}
+
+std::size_t InputTrace::getSyscallCount() const {
+    return this->source_ ? this->source_->getSyscallCount() : 0;
+}
+
+const std::shared_ptr<const AddressTable>& InputTrace::getAddressTable() const {
+    return this->addresses_;
 }
 
 void InputTrace::addTrace(const SPacket& packet) {
-    this->input_traces_.push(packet);    
-    if (this->router_traces_.find(packet.src_addr) == this->router_traces_.end()) {
-        this->router_traces_[packet.src_addr] = std::priority_queue<SPacket, std::vector<SPacket>, std::greater<SPacket>>();        
+    SPacket spacket(packet);
+    spacket.src_id = this->addresses_->getId(packet.src_addr);
+    spacket.des_id = this->addresses_->getId(packet.des_addr);
+    if (spacket.src_id == INVALID_ROUTER_ID_ || spacket.des_id == INVALID_ROUTER_ID_) {
+        throw std::runtime_error("Packet " + std::to_string(packet.id) + " has an address outside the network: "
+            + this->trace_file_name_);
     }
-    this->router_traces_[packet.src_addr].push(packet);
+    this->input_traces_.push(spacket);
+    this->router_traces_[spacket.src_id].push(spacket);
 }
 
 bool InputTrace::isEmpty() {
     this->readTraceFile();
+    if (this->input_traces_.empty() && this->next_) {
+        this->advance(this->next_->start_time);
+    }
     return this->input_traces_.empty();
 }
 
-bool InputTrace::isEmpty(const AddrType& address) {
+bool InputTrace::isEmpty(RouterId router) {
     this->readTraceFile();
-    if (this->router_traces_.find(address) == this->router_traces_.end()) {
-        return true;
+    // Read whole, the trace hands a router its later packets as soon as its buffer has room.
+    // The stream is sorted, so the packets read ahead do not change the order of the queues.
+    while (this->router_traces_[router].empty() && this->next_) {
+        if (this->input_traces_.size() >= TRACE_READ_AHEAD_) {
+            if (!this->read_ahead_full_) {
+                this->read_ahead_full_ = true;
+                Logger::warn("{} packets are queued ahead of the trace window: routers out of packets inject "
+                    "their next ones later than when the whole trace is read, which changes the delays.",
+                    this->input_traces_.size());
+            }
+            break;
+        }
+        this->queueNextPacket();
     }
-    return this->router_traces_[address].empty();
+    return this->router_traces_[router].empty();
 }
 
 bool InputTrace::isReadFin() {
@@ -109,22 +244,14 @@ void InputTrace::popFront() {
     this->input_traces_.pop();
 }
 
-void InputTrace::popFront(const AddrType& address) {
-    if (this->router_traces_.find(address) == this->router_traces_.end()) {
-        return;
-    }
-    this->router_traces_[address].pop();
+void InputTrace::popFront(RouterId router) {
+    this->router_traces_[router].pop();
 }
 
 const SPacket& InputTrace::front() const {
     return this->input_traces_.top();
 }
 
-const SPacket& InputTrace::front(const AddrType& address) const {
-    auto it = this->router_traces_.find(address);
-    if (it == this->router_traces_.end()) {
-        throw std::runtime_error("Address not found in router traces");
-    }
-    return it->second.top();
+const SPacket& InputTrace::front(RouterId router) const {
+    return this->router_traces_[router].top();
 }
-
@@ -0,0 +1,165 @@
+# include <cerrno>
+# include <cstring>
+# include <stdexcept>
+
+# include <fcntl.h>
+# include <poll.h>
+# include <sys/inotify.h>
+# include <sys/stat.h>
+# include <unistd.h>
+
+# include "global_defines/live_trace_feed.h"
+
+LiveTraceFeed::LiveTraceFeed(const std::string& fname, std::size_t dimension, bool sync_protocol,
+    long poll_interval
+)
+:   TraceSource(),
+    fname_(fname),
+    parser_(dimension, sync_protocol, 1),
+    poll_interval_(poll_interval),
+    fd_(-1),
+    watch_fd_(-1),
+    keep_fd_(-1),
+    stop_fd_{-1, -1},
+    pending_(),
+    buffer_(LIVE_TRACE_READ_SIZE_),
+    mutex_(),
+    ready_cv_(),
+    batches_(),
+    end_(false),
+    error_(),
+    thread_()
+{
+    try {
+        struct stat st;
+        this->syscalls_++;
+        if (::stat(fname.c_str(), &st) != 0) {
+            throw std::runtime_error("Failed to open trace file: " + fname);
+        }
+        // Reads never block, so that the reader only ever waits in poll.
+        this->fd_ = ::open(fname.c_str(), O_RDONLY | O_NONBLOCK | O_CLOEXEC);
+        this->syscalls_++;
+        if (this->fd_ < 0) {
+            throw std::runtime_error("Failed to open trace file: " + fname);
+        }
+        if (S_ISFIFO(st.st_mode)) {
+            this->keep_fd_ = ::open(fname.c_str(), O_WRONLY | O_NONBLOCK | O_CLOEXEC);
+            this->syscalls_++;
+            if (this->keep_fd_ < 0) {
+                throw std::runtime_error("Failed to hold the trace pipe open: " + fname);
+            }
+        }
+        else {
+            this->watch_fd_ = ::inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+            this->syscalls_ += 2;
+            if (this->watch_fd_ < 0
+                || ::inotify_add_watch(this->watch_fd_, fname.c_str(), IN_MODIFY | IN_CLOSE_WRITE) < 0
+            ) {
+                throw std::runtime_error("Failed to watch trace file: " + fname + ": " + std::strerror(errno));
+            }
+        }
+        if (::pipe2(this->stop_fd_, O_CLOEXEC) != 0) {
+            throw std::runtime_error("Failed to create the stop pipe of the trace feed");
+        }
+    } catch (...) {
+        for (int fd : {this->fd_, this->watch_fd_, this->keep_fd_, this->stop_fd_[0], this->stop_fd_[1]}) {
+            if (fd >= 0) {
+                ::close(fd);
+            }
+        }
+        throw;
+    }
+    this->thread_ = std::thread(&LiveTraceFeed::run, this);
+}
+
+LiveTraceFeed::~LiveTraceFeed() {
+    char stop = 0;
+    while (::write(this->stop_fd_[1], &stop, 1) < 0 && errno == EINTR) {}
+    this->thread_.join();
+    for (int fd : {this->fd_, this->watch_fd_, this->keep_fd_, this->stop_fd_[0], this->stop_fd_[1]}) {
+        if (fd >= 0) {
+            ::close(fd);
+        }
+    }
+}
+
+bool LiveTraceFeed::readAvailable() {
+    while (true) {
+        ssize_t n = ::read(this->fd_, this->buffer_.data(), this->buffer_.size());
+        this->syscalls_++;
+        if (n == 0) {
+            break;
+        }
+        if (n < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            if (errno == EAGAIN) {
+                break;
+            }
+            throw std::runtime_error("Failed to read trace file: " + this->fname_ + ": " + std::strerror(errno));
+        }
+        this->pending_.append(this->buffer_.data(), n);
+    }
+
+    TraceRecords records;
+    bool end_mark = false;
+    std::size_t consumed = this->parser_.parse(this->pending_.data(), this->pending_.size(),
+        records, end_mark, false);
+    this->pending_.erase(0, consumed);
+    if (records.size() > 0 || end_mark) {
+        std::lock_guard<std::mutex> lock(this->mutex_);
+        if (records.size() > 0) {
+            this->batches_.push_back(std::move(records));
+        }
+        this->end_ = end_mark;
+        this->ready_cv_.notify_all();
+    }
+    return end_mark;
+}
+
+void LiveTraceFeed::run() {
+    try {
+        while (!this->readAvailable()) {
+            // inotify wakes the reader on writes; the poll interval covers file systems where it misses them.
+            pollfd fds[2] = {
+                {this->watch_fd_ >= 0 ? this->watch_fd_ : this->fd_, POLLIN, 0},
+                {this->stop_fd_[0], POLLIN, 0}
+            };
+            this->syscalls_++;
+            if (::poll(fds, 2, this->poll_interval_ > 0 ? this->poll_interval_ : -1) < 0 && errno != EINTR) {
+                throw std::runtime_error("Failed to wait for trace file: " + this->fname_ + ": "
+                    + std::strerror(errno));
+            }
+            if (fds[1].revents != 0) {
+                return;
+            }
+            if (this->watch_fd_ >= 0 && fds[0].revents != 0) {
+                do {
+                    this->syscalls_++;
+                } while (::read(this->watch_fd_, this->buffer_.data(), this->buffer_.size()) > 0);
+            }
+        }
+    } catch (...) {
+        std::lock_guard<std::mutex> lock(this->mutex_);
+        this->error_ = std::current_exception();
+        this->ready_cv_.notify_all();
+    }
+}
+
+bool LiveTraceFeed::read(TraceRecords& records, bool wait) {
+    std::unique_lock<std::mutex> lock(this->mutex_);
+    if (wait) {
+        this->ready_cv_.wait(lock, [this]() {
+            return !this->batches_.empty() || this->end_ || this->error_;
+        });
+    }
+    if (this->error_) {
+        std::rethrow_exception(this->error_);
+    }
+    for (auto& batch : this->batches_) {
+        records.append(batch);
+    }
+    this->batches_.clear();
+    return this->end_;
+}
@@ -0,0 +1,68 @@
+# include <stdexcept>
+
+# include <fcntl.h>
+# include <sys/mman.h>
+# include <sys/stat.h>
+# include <unistd.h>
+
+# include "global_defines/mapped_file.h"
+
+MappedFile::MappedFile(const std::string& fname, bool sequential)
+:   data_(nullptr),
+    size_(0),
+    syscalls_(2)
+{
+    // The open and the close, then whatever succeeds in between.
+    int fd = ::open(fname.c_str(), O_RDONLY);
+    if (fd < 0) {
+        throw std::runtime_error("Failed to open file: " + fname);
+    }
+    struct stat st;
+    this->syscalls_++;
+    if (::fstat(fd, &st) != 0) {
+        ::close(fd);
+        throw std::runtime_error("Failed to stat file: " + fname);
+    }
+    this->size_ = st.st_size;
+    if (this->size_ > 0) {
+        this->data_ = ::mmap(nullptr, this->size_, PROT_READ, MAP_PRIVATE, fd, 0);
+        // The mmap and the munmap.
+        this->syscalls_ += 2;
+    }
+    ::close(fd);
+    if (this->data_ == MAP_FAILED) {
+        this->data_ = nullptr;
+        throw std::runtime_error("Failed to map file: " + fname);
+    }
+    if (sequential && this->data_ != nullptr) {
+        ::madvise(this->data_, this->size_, MADV_SEQUENTIAL);
+        this->syscalls_++;
+    }
+}
+
+MappedFile::MappedFile(MappedFile&& other) noexcept
+:   data_(other.data_),
+    size_(other.size_),
+    syscalls_(other.syscalls_)
+{
+    other.data_ = nullptr;
+    other.size_ = 0;
+}
+
+MappedFile::~MappedFile() {
+    if (this->data_ != nullptr) {
+        ::munmap(this->data_, this->size_);
+    }
+}
+
+const char* MappedFile::data() const {
+    return static_cast<const char*>(this->data_);
+}
+
+std::size_t MappedFile::size() const {
+    return this->size_;
+}
+
+std::size_t MappedFile::getSyscallCount() const {
+    return this->syscalls_;
+}
@@ -1,4 +1,6 @@
 # include "global_defines/message_define.h"
+# include "global_defines/event_queue.h"
+# include "global_defines/SStd.h"
 
 
 /**
@@ -27,38 +29,20 @@ MessType MessEvent::getEventType() const {
 
 
 /**
- * @brief Get the source address of the message event
- * @return The source address of the message event
+ * @brief Get the source router of the message event
+ * @return The ID of the source router, or `INVALID_ROUTER_ID_` for EVG, ROUTER and RECONFIGURATION events
  */
-AddrType& MessEvent::getSrc() {
-    return this->src_addr_;
+RouterId MessEvent::getSrc() const {
+    return this->src_;
 }
 
 
 /**
- * @brief Get the source address of the message event (const version)
- * @return The source address of the message event (const version)
+ * @brief Get the destination router of the message event
+ * @return The ID of the destination router, or `INVALID_ROUTER_ID_` for EVG, ROUTER and RECONFIGURATION events
  */
-const AddrType& MessEvent::getSrc() const {
-    return this->src_addr_;
-}
-
-
-/**
- * @brief Get the destination address of the message event
- * @return The destination address of the message event
- */
-AddrType& MessEvent::getDes() {
-    return this->des_addr_;
-}
-
-
-/**
- * @brief Get the destination address of the message event (const version)
- * @return The destination address of the message event (const version)
- */
-const AddrType& MessEvent::getDes() const {
-    return this->des_addr_;
+RouterId MessEvent::getDes() const {
+    return this->des_;
 }
 
 
@@ -81,19 +65,20 @@ long MessEvent::getVC() const {
 
 
 /**
- * @brief Get the flit of the message event
- * @return The flit of the message event
+ * @brief Check if the message event carries a flit
+ * @return true for WIRE events, false otherwise
  */
-Flit& MessEvent::getFlit() {
-    return this->flit_;
+bool MessEvent::hasFlit() const {
+    return this->flit_ != INVALID_FLIT_HANDLE_;
 }
 
 
 /**
- * @brief Get the flit of the message event (const version)
- * @return The flit of the message event (const version)
+ * @brief Get the flit of the message event
+ * @return The handle of the flit in `Global::flitPool()`
  */
-const Flit& MessEvent::getFlit() const {
+FlitHandle MessEvent::getFlit() const {
+    Sassert(this->hasFlit(), "The message event carries no flit.");
     return this->flit_;
 }
 
@@ -106,6 +91,22 @@ TimeType MessEvent::getRoutingPeriod() const {
     return this->routing_period_;
 }
 
+/**
+ * @brief Set the sequence number of the message event
+ * @param seq The sequence number, assigned by `MessQueue` on insertion
+ */
+void MessEvent::setSeq(std::uint64_t seq) {
+    this->seq_ = seq;
+}
+
+/**
+ * @brief Get the sequence number of the message event
+ * @return The sequence number of the message event
+ */
+std::uint64_t MessEvent::getSeq() const {
+    return this->seq_;
+}
+
 /**
  * @brief Construct a new MessEvent object
  * @param start_time The start time of the message event
@@ -115,10 +116,13 @@ TimeType MessEvent::getRoutingPeriod() const {
 MessEvent::MessEvent(TimeType start_time, MessType mess_type, TimeType routing_period)
 :   start_time_(start_time),
     mess_type_(mess_type),
-    routing_period_(routing_period),
+    src_(INVALID_ROUTER_ID_),
+    des_(INVALID_ROUTER_ID_),
     pc_(0),
     vc_(0),
-    flit_()
+    routing_period_(routing_period),
+    seq_(0),
+    flit_(INVALID_FLIT_HANDLE_)
 {}
 
 
@@ -126,21 +130,23 @@ MessEvent::MessEvent(TimeType start_time, MessType mess_type, TimeType routing_p
  * @brief Construct a new MessEvent object
  * @param start_time The start time of the message event
  * @param mess_type The type of the message event
- * @param src_addr The source address of the message event
- * @param des_addr The destination address of the message event
+ * @param src The source router of the message event
+ * @param des The destination router of the message event
  * @param pc The PC of the message event
  * @param vc The VC of the message event
  */
 MessEvent::MessEvent(TimeType start_time, MessType mess_type,
-    const AddrType& src_addr, const AddrType& des_addr,
+    RouterId src, RouterId des,
     long pc, long vc)
 :   start_time_(start_time),
     mess_type_(mess_type),
-    src_addr_(src_addr),
-    des_addr_(des_addr),
+    src_(src),
+    des_(des),
     pc_(pc),
     vc_(vc),
-    flit_()
+    routing_period_(PIPE_DELAY_),
+    seq_(0),
+    flit_(INVALID_FLIT_HANDLE_)
 {}
 
 
@@ -148,172 +154,155 @@ MessEvent::MessEvent(TimeType start_time, MessType mess_type,
  * @brief Construct a new MessEvent object
  * @param start_time The start time of the message event
  * @param mess_type The type of the message event
- * @param src_addr The source address of the message event
- * @param des_addr The destination address of the message event
+ * @param src The source router of the message event
+ * @param des The destination router of the message event
  * @param pc The PC of the message event
  * @param vc The VC of the message event
- * @param flit The flit of the message event
+ * @param flit The handle of the flit of the message event
  */
 MessEvent::MessEvent(TimeType start_time, MessType mess_type,
-    const AddrType& src_addr, const AddrType& des_addr,
-    long pc, long vc, const Flit& flit)
+    RouterId src, RouterId des,
+    long pc, long vc, FlitHandle flit)
 :   start_time_(start_time),
     mess_type_(mess_type),
-    src_addr_(src_addr),
-    des_addr_(des_addr),
+    src_(src),
+    des_(des),
     pc_(pc),
     vc_(vc),
-    flit_(flit)
-{}
-
-/**
- * @brief Construct a new MessEvent object
- * @param start_time The start time of the message event
- * @param mess_type The type of the message event
- * @param flit The flit of the message event
- */
-MessEvent::MessEvent(TimeType start_time, MessType mess_type, const Flit& flit)
-:   start_time_(start_time),
-    mess_type_(mess_type),
-    pc_(0),
-    vc_(0),
+    routing_period_(PIPE_DELAY_),
+    seq_(0),
     flit_(flit)
 {}
 
 
-/**
- * @brief Construct a new MessEvent object by copying another MessEvent object
- * @param me The MessEvent object to be copied
- */
-MessEvent::MessEvent(const MessEvent& me)
-:   start_time_(me.getEventStart()),
-    mess_type_(me.getEventType()),
-    src_addr_(me.getSrc()),
-    des_addr_(me.getDes()),
-    pc_(me.getPC()),
-    vc_(me.getVC()),
-    flit_(me.getFlit()),
-    routing_period_(me.getRoutingPeriod())
-{}
-
-
 /**
  * @brief operator<< overload for MessEvent
  */
 std::ostream& operator<<(std::ostream& os, const MessEvent& me) {
     os << "Start time " << me.getEventStart() << ", ";
-    os << "from ";
-    os << me.getSrc() << " ";
-    os << "to ";
-    os << me.getDes() << " ";
+    if (me.getSrc() != INVALID_ROUTER_ID_) {
+        os << "from router " << me.getSrc() << " ";
+        os << "to router " << me.getDes() << " ";
+    }
     os << "(" << me.getEventType() << ")";
     return os;
 }
 
+/**
+ * @brief The rank of a message type among events of the same time
+ * @param mess_type The message type
+ * @return The rank, smaller first
+ */
+static unsigned char tieRank(MessType mess_type) {
+    switch (mess_type) {
+        case MessType::RECONFIGURATION:
+            return 0;
+        case MessType::WIRE:
+            return 1;
+        case MessType::CREDIT:
+            return 2;
+        case MessType::ROUTER:
+            return 3;
+        case MessType::EVG:
+            return 4;
+        default:
+            return 5;
+    }
+}
+
 bool MessEvent::operator<(const MessEvent& me) const {
-    return this->start_time_ < me.start_time_;
+    if (this->start_time_ != me.start_time_) {
+        return this->start_time_ < me.start_time_;
+    }
+    if (this->mess_type_ != me.mess_type_) {
+        return tieRank(this->mess_type_) < tieRank(me.mess_type_);
+    }
+    return this->seq_ < me.seq_;
 }
 
 bool MessEvent::operator>(const MessEvent& me) const {
-    return this->start_time_ > me.start_time_;
+    return me < *this;
+}
+
+void MessQueue::setEngine(EventQueueType type) {
+    std::unique_ptr<EventQueueEngine> engine;
+    switch (type) {
+        case EventQueueType::HEAP:
+            engine = std::make_unique<HeapEventQueue>();
+            break;
+        case EventQueueType::CALENDAR:
+            engine = std::make_unique<CalendarEventQueue>(CalendarEventQueue::defaultWidth());
+            break;
+        default:
+            throw std::runtime_error("Invalid event queue type.");
+    }
+    while (this->engine_->size() > 0) {
+        engine->push(this->engine_->take());
+    }
+    this->engine_ = std::move(engine);
 }
 
 void MessQueue::clear() {
-    this->m_q_.clear();
-    this->size_ = 0;
+    this->engine_->clear();
 }
 
 void MessQueue::clear(MessType mess_type) {
-    if (this->m_q_.find(mess_type) == this->m_q_.end()) {
-        return;
-    }
-    this->size_ -= this->m_q_[mess_type].size();
-    this->m_q_[mess_type] = std::priority_queue<MessEvent, std::vector<MessEvent>, std::greater<MessEvent>>();
+    this->engine_->clear(mess_type);
 }
 
-void MessQueue::addMessage(const MessEvent& event) {
-    MessType mess_type = event.getEventType();
-    if (this->m_q_.find(mess_type) == this->m_q_.end()) {
-        this->m_q_[mess_type] = std::priority_queue<MessEvent, std::vector<MessEvent>, std::greater<MessEvent>>();
-    }
-    this->m_q_[mess_type].push(event);
-    this->size_ += 1;
+void MessQueue::addMessage(MessEvent&& event) {
+    event.setSeq(this->seq_++);
+    this->engine_->push(std::move(event));
 }
 
 void MessQueue::popFront() {
-    const MessEvent& top = this->getTop();
-    this->m_q_[top.getEventType()].pop();
-    this->size_--;
+    this->engine_->take();
+}
+
+MessEvent MessQueue::takeFront() {
+    return this->engine_->take();
 }
 
 const MessEvent& MessQueue::getTop() const {
-    if (this->m_q_.empty() || this->size_ == 0) {
-        throw std::runtime_error("Message queue is empty.");
-    }
-    auto ret = this->m_q_.cbegin();
-    for (ret = this->m_q_.cbegin(); ret != this->m_q_.cend(); ++ret) {
-        if (ret->second.empty()) {
-            continue;
-        }
-        break;
-    }
-    for (auto iter = ret; iter != this->m_q_.cend(); ++iter) {
-        if (iter->second.empty()) {
-            continue;
-        }
-        if (iter->second.top() < ret->second.top()) {
-            ret = iter;
-        }
-    }
-    return ret->second.top();
+    return this->engine_->top();
 }
 
 const MessEvent& MessQueue::getTop(MessType mess_type) const {
-    auto iter = this->m_q_.find(mess_type);
-    if (iter == this->m_q_.end()) {
-        throw std::runtime_error("Message queue is empty.");
-    }
-    return iter->second.top();
+    return this->engine_->top(mess_type);
 }
 
 bool MessQueue::empty() const {
-    return this->size_ == 0;
+    return this->engine_->size() == 0;
 }
 
 bool MessQueue::empty(MessType mess_type) const {
-    auto iter = this->m_q_.find(mess_type);
-    if (iter == this->m_q_.end()) {
-        return true;
-    }
-    return iter->second.size() == 0;
+    return this->engine_->size(mess_type) == 0;
 }
 
 MessQueue::size_type MessQueue::size() const {
-    return this->size_;
+    return this->engine_->size();
 }
 
-void MessQueue::updateEVGCycle(TimeType new_time) {
+MessQueue::size_type MessQueue::size(MessType mess_type) const {
+    return this->engine_->size(mess_type);
+}
 
-    if (this->m_q_.find(MessType::EVG) == this->m_q_.end()) {
-        this->m_q_[MessType::EVG] = std::priority_queue<MessEvent, std::vector<MessEvent>, std::greater<MessEvent>>();
-        this->addMessage(MessEvent(new_time, MessType::EVG));
-        return;
-    }
-    if (this->m_q_[MessType::EVG].empty()) {
+void MessQueue::updateEVGCycle(TimeType new_time) {
+    if (this->engine_->size(MessType::EVG) == 0) {
         this->addMessage(MessEvent(new_time, MessType::EVG));
         return;
     }
-    if (this->m_q_[MessType::EVG].top().getEventStart() >= new_time) {
-        MessEvent new_event(this->m_q_[MessType::EVG].top());
+    if (this->engine_->top(MessType::EVG).getEventStart() >= new_time) {
+        MessEvent new_event(this->engine_->take(MessType::EVG));
         new_event.setEventStart(new_time);
-        this->m_q_[MessType::EVG].pop();
-        this->m_q_[MessType::EVG].push(new_event);
-        Logger::info("Update EVG cycle to {}.", new_time);
+        this->engine_->push(std::move(new_event));
+        LOG_DEBUG("Update EVG cycle to {}.", new_time);
     }
 }
 
 MessQueue::MessQueue()
-    : m_q_()
-{
-    this->size_ = 0;
-}
+:   seq_(0),
+    engine_(std::make_unique<CalendarEventQueue>(CalendarEventQueue::defaultWidth()))
+{}
+
+MessQueue::~MessQueue() = default;
@@ -1,3 +1,4 @@
+# include <utility>
 # include "global_defines/packet_defines.h"
 
 
@@ -8,16 +9,21 @@
  */
 SPacket::SPacket(std::size_t addr_size) {
 	this->start_time = -1;
+	this->src_id = INVALID_ROUTER_ID_;
+	this->des_id = INVALID_ROUTER_ID_;
 	this->src_addr.reserve(addr_size);
 	this->des_addr.reserve(addr_size);
 }
 
 bool SPacket::operator<(const SPacket& another) const {
-    return this->start_time < another.start_time;
+    if (this->start_time != another.start_time) {
+        return this->start_time < another.start_time;
+    }
+    return this->id < another.id;
 }
 
 bool SPacket::operator>(const SPacket& another) const {
-    return this->start_time > another.start_time;
+    return another < *this;
 }
     
 /**
@@ -48,35 +54,19 @@ FlitType Flit::getFlitType() const {
 }
 
 /**
- * @brief Get the source address
- * @return the source address
+ * @brief Get the source router
+ * @return the ID of the source router
  */
-AddrType& Flit::getSrcAddr(){
-   return this->src_addr_;
+RouterId Flit::getSrc() const {
+   return this->src_;
 }
 
 /**
- * @brief Get the source address (const)
- * @return the source address (const)
+ * @brief Get the destination router
+ * @return the ID of the destination router
  */
-const AddrType& Flit::getSrcAddr() const{
-   return this->src_addr_;
-}
-
-/**
- * @brief Get the destination address
- * @return the destination address
- */
-AddrType& Flit::getDesAddr(){
-   return this->des_addr_;
-}
-
-/**
- * @brief Get the destination address (const)
- * @return the destination address (const)
- */
-const AddrType& Flit::getDesAddr() const {
-    return this->des_addr_;
+RouterId Flit::getDes() const {
+    return this->des_;
 }
 
 /**
@@ -161,8 +151,8 @@ TPacketId Flit::getPacketId() const {
 Flit::Flit()
 :   flit_id_(),
     flit_type_(FlitType::HEADER),
-    src_addr_(),
-    des_addr_(),
+    src_(INVALID_ROUTER_ID_),
+    des_(INVALID_ROUTER_ID_),
     start_time_(),
     send_finish_time_(),
     finish_time_(),
@@ -174,51 +164,35 @@ Flit::Flit()
  * @brief Construct a new Flit object with the specified parameters
  * @param flit_id the flit ID
  * @param flit_type the flit type
- * @param src_addr the source address
- * @param des_addr the destination address
+ * @param src the source router
+ * @param des the destination router
  * @param start_time the start time
- * @param data the data
+ * @param data the data, moved into the flit
  * @param packet_id the packet ID
  * @note The finish time is set to `0`.
  * @note The send finish time is set to `0`.
  */
 Flit::Flit(long flit_id, FlitType flit_type,
-    const AddrType& src_addr, const AddrType& des_addr,
-	TimeType start_time, const DataType& data,
+    RouterId src, RouterId des,
+	TimeType start_time, DataType data,
     TPacketId packet_id)
 :   flit_id_(flit_id),
     flit_type_(flit_type),
-    src_addr_(src_addr),
-    des_addr_(des_addr),
+    src_(src),
+    des_(des),
     start_time_(start_time),
     send_finish_time_(),
     finish_time_(),
-    data_(data),
+    data_(std::move(data)),
     packet_id_(packet_id)
 {}
 
-/**
- * @brief Construct a new Flit object by copying another Flit object
- * @param flit the flit object
- */
-Flit::Flit(const Flit& flit)
-:   flit_id_(flit.getFlitID()),
-    flit_type_(flit.getFlitType()),
-    src_addr_(flit.getSrcAddr()),
-    des_addr_(flit.getDesAddr()),
-    start_time_(flit.getStartTime()),
-    send_finish_time_(flit.getSendFinTime()),
-    finish_time_(flit.getFinTime()),
-    data_(flit.getData()),
-    packet_id_(flit.getPacketId())
-{}
-
 /**
  * @brief operator<< overload for Flit
 */
 std::ostream& operator<<(std::ostream& os, const Flit& flit) {
     os << flit.getFlitID() << ":: ";
-    os << "from " << flit.getSrcAddr() << " to " << flit.getSrcAddr() << " (" << flit.getFlitType() << ")";
+    os << "from router " << flit.getSrc() << " to router " << flit.getDes() << " (" << flit.getFlitType() << ")";
     return os;
 }
 
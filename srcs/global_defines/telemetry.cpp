@@ -0,0 +1,106 @@
+# include <cerrno>
+# include <cstring>
+# include <stdexcept>
+
+# include <fcntl.h>
+# include <unistd.h>
+
+# include "global_defines/telemetry.h"
+
+static_assert(sizeof(TelemetryHeader) == 24, "The telemetry header should not be padded.");
+static_assert(sizeof(TelemetryWindowHeader) == 16, "The telemetry window header should not be padded.");
+
+void TelemetryWindow::resize(std::size_t router_count, std::size_t port_count) {
+    this->buffer_power.resize(router_count);
+    this->crossbar_power.resize(router_count);
+    this->arbiter_power.resize(router_count);
+    this->link_power.resize(router_count * port_count);
+    this->average_delay.resize(router_count);
+    this->injected_flits.resize(router_count);
+    this->accepted_flits.resize(router_count);
+    this->accepted_packets.resize(router_count);
+    this->input_flits.resize(router_count);
+    this->output_flits.resize(router_count);
+}
+
+Telemetry::Telemetry(const std::string& fname, std::size_t router_count, std::size_t port_count)
+:   fname_(fname),
+    fd_(-1),
+    router_count_(router_count),
+    port_count_(port_count),
+    count_(0),
+    buffer_()
+{
+    this->fd_ = ::open(fname.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+    if (this->fd_ < 0) {
+        throw std::runtime_error("Failed to open telemetry file: " + fname + ": " + std::strerror(errno));
+    }
+
+    TelemetryHeader header;
+    std::memset(&header, 0, sizeof(header));
+    std::memcpy(header.magic, TELEMETRY_MAGIC_, sizeof(header.magic));
+    header.version = TELEMETRY_VERSION_;
+    header.router_count = router_count;
+    header.port_count = port_count;
+    try {
+        this->writeAll(reinterpret_cast<const char*>(&header), sizeof(header));
+    } catch (...) {
+        ::close(this->fd_);
+        throw;
+    }
+}
+
+Telemetry::~Telemetry() {
+    ::close(this->fd_);
+}
+
+void Telemetry::writeAll(const char* data, std::size_t size) {
+    while (size > 0) {
+        ssize_t n = ::write(this->fd_, data, size);
+        if (n < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            throw std::runtime_error("Failed to write telemetry file: " + this->fname_ + ": " + std::strerror(errno));
+        }
+        data += n;
+        size -= n;
+    }
+}
+
+template<typename T>
+void Telemetry::append(const std::vector<T>& column) {
+    const char* data = reinterpret_cast<const char*>(column.data());
+    this->buffer_.insert(this->buffer_.end(), data, data + column.size() * sizeof(T));
+}
+
+void Telemetry::record(TimeType start, TimeType end, const TelemetryWindow& window) {
+    if (window.buffer_power.size() != this->router_count_
+        || window.link_power.size() != this->router_count_ * this->port_count_
+    ) {
+        throw std::runtime_error("The telemetry window does not match the network");
+    }
+    TelemetryWindowHeader header{start, end};
+    const char* data = reinterpret_cast<const char*>(&header);
+    this->buffer_.assign(data, data + sizeof(header));
+    this->append(window.buffer_power);
+    this->append(window.crossbar_power);
+    this->append(window.arbiter_power);
+    this->append(window.link_power);
+    this->append(window.average_delay);
+    this->append(window.injected_flits);
+    this->append(window.accepted_flits);
+    this->append(window.accepted_packets);
+    this->append(window.input_flits);
+    this->append(window.output_flits);
+    this->writeAll(this->buffer_.data(), this->buffer_.size());
+    this->count_++;
+}
+
+std::size_t Telemetry::getCount() const {
+    return this->count_;
+}
+
+const std::string& Telemetry::getFname() const {
+    return this->fname_;
+}
@@ -0,0 +1,167 @@
+# include <algorithm>
+# include <charconv>
+# include <exception>
+# include <stdexcept>
+# include <string>
+# include <thread>
+
+# include "global_defines/trace_parser.h"
+
+static bool isSpace(char c) {
+    return c == ' ' || c == '\n' || c == '\t' || c == '\r';
+}
+
+/**
+ * @brief Skip the whitespace before a token
+ */
+static const char* skipSpace(const char* p, const char* end) {
+    while (p != end && isSpace(*p)) {
+        ++p;
+    }
+    return p;
+}
+
+/**
+ * @brief Parse the next token
+ * @param p The position, moved past the token
+ * @param end The end of the buffer
+ * @param value The value
+ * @param complete Whether a token reaching the end of the buffer is whole
+ * @return false if the buffer ends before the token
+ */
+template<typename T>
+static bool parseToken(const char*& p, const char* end, T& value, bool complete) {
+    p = skipSpace(p, end);
+    if (p == end) {
+        return false;
+    }
+    const char* token_end = std::find_if(p, end, isSpace);
+    if (token_end == end && !complete) {
+        return false;
+    }
+    if (*p == '+') {
+        ++p;
+    }
+    auto [ptr, ec] = std::from_chars(p, token_end, value);
+    if (ec != std::errc() || ptr != token_end) {
+        throw std::runtime_error("Invalid token in trace: " + std::string(p, token_end));
+    }
+    p = ptr;
+    return true;
+}
+
+TextTraceParser::TextTraceParser(std::size_t dimension, bool sync_protocol, std::size_t thread_num)
+:   dimension_(dimension),
+    sync_protocol_(sync_protocol),
+    thread_num_(thread_num > 0 ? thread_num : std::max(1u, std::thread::hardware_concurrency()))
+{}
+
+void TextTraceParser::parseChunk(const char* begin, const char* end, bool complete, Chunk& chunk) const {
+    const char* p = begin;
+    long src_addr[MAX_DIMENSION_];
+    long des_addr[MAX_DIMENSION_];
+    while (true) {
+        // A record is only kept once all its fields are read.
+        const char* record = p;
+        TimeType start_time;
+        TimeType des_time = 0;
+        long packet_size;
+        long proto_dsc = 0;
+        if (!parseToken(p, end, start_time, complete)) {
+            chunk.end = p;
+            return;
+        }
+        if (start_time == -1) {
+            chunk.end = p;
+            chunk.end_mark = true;
+            return;
+        }
+        bool whole = !this->sync_protocol_ || parseToken(p, end, des_time, complete);
+        for (std::size_t i = 0; whole && i < this->dimension_; i++) {
+            whole = parseToken(p, end, src_addr[i], complete);
+        }
+        for (std::size_t i = 0; whole && i < this->dimension_; i++) {
+            whole = parseToken(p, end, des_addr[i], complete);
+        }
+        whole = whole && parseToken(p, end, packet_size, complete);
+        whole = whole && (!this->sync_protocol_ || parseToken(p, end, proto_dsc, complete));
+        if (!whole) {
+            chunk.end = record;
+            chunk.partial = true;
+            return;
+        }
+
+        TraceRecords& records = chunk.records;
+        records.start_time.push_back(start_time);
+        records.src_addr.insert(records.src_addr.end(), src_addr, src_addr + this->dimension_);
+        records.des_addr.insert(records.des_addr.end(), des_addr, des_addr + this->dimension_);
+        records.packet_size.push_back(packet_size);
+        if (this->sync_protocol_) {
+            records.des_time.push_back(des_time);
+            records.proto_dsc.push_back(proto_dsc);
+        }
+    }
+}
+
+std::size_t TextTraceParser::parse(const char* data, std::size_t size, TraceRecords& records, bool& end_mark,
+    bool complete
+) const {
+    const char* end = data + size;
+    std::size_t chunk_num = std::clamp<std::size_t>(size / TRACE_PARSE_CHUNK_, 1, this->thread_num_);
+
+    // Every piece but the first starts after a newline.
+    std::vector<const char*> bounds;
+    bounds.push_back(data);
+    for (std::size_t k = 1; k < chunk_num; k++) {
+        const char* p = std::max(bounds.back(), data + size * k / chunk_num);
+        p = std::find(p, end, '\n');
+        bounds.push_back(p == end ? end : p + 1);
+    }
+    bounds.push_back(end);
+
+    std::vector<Chunk> chunks(chunk_num);
+    if (chunk_num == 1) {
+        this->parseChunk(bounds[0], bounds[1], complete, chunks[0]);
+    }
+    else {
+        std::vector<std::thread> threads;
+        std::vector<std::exception_ptr> errors(chunk_num);
+        for (std::size_t k = 0; k < chunk_num; k++) {
+            threads.emplace_back([&, k]() {
+                try {
+                    this->parseChunk(bounds[k], bounds[k + 1], complete || k + 1 < chunk_num, chunks[k]);
+                } catch (...) {
+                    errors[k] = std::current_exception();
+                }
+            });
+        }
+        for (auto& thread : threads) {
+            thread.join();
+        }
+        for (std::size_t k = 0; k < chunk_num; k++) {
+            // Pieces past a -1 do not count, even if they are not a trace.
+            if (errors[k]) {
+                std::rethrow_exception(errors[k]);
+            }
+            if (chunks[k].end_mark) {
+                break;
+            }
+            if (chunks[k].partial && k + 1 < chunk_num) {
+                // A record spans lines, so the pieces do not start at records.
+                return TextTraceParser(this->dimension_, this->sync_protocol_, 1)
+                    .parse(data, size, records, end_mark, complete);
+            }
+        }
+    }
+
+    const char* consumed = data;
+    for (auto& chunk : chunks) {
+        records.append(chunk.records);
+        consumed = chunk.end;
+        if (chunk.end_mark) {
+            end_mark = true;
+            break;
+        }
+    }
+    return consumed - data;
+}
@@ -0,0 +1,55 @@
+# include <cstring>
+# include <stdexcept>
+
+# include "global_defines/binary_trace.h"
+# include "global_defines/mapped_file.h"
+# include "global_defines/trace_source.h"
+
+TraceSource::TraceSource()
+:   syscalls_(0)
+{}
+
+std::size_t TraceSource::getSyscallCount() const {
+    return this->syscalls_.load(std::memory_order_relaxed);
+}
+
+FileTraceSource::FileTraceSource(const std::string& fname, std::size_t dimension, bool sync_protocol)
+:   TraceSource(),
+    fname_(fname),
+    dimension_(dimension),
+    sync_protocol_(sync_protocol)
+{}
+
+bool FileTraceSource::read(TraceRecords& records, bool) {
+    MappedFile file(this->fname_);
+    this->syscalls_ += file.getSyscallCount();
+    if (!BinaryTrace::isBinary(file.data(), file.size())) {
+        bool end_mark = false;
+        TextTraceParser(this->dimension_, this->sync_protocol_).parse(file.data(), file.size(), records, end_mark);
+        return true;
+    }
+
+    BinaryTrace trace(std::move(file), this->fname_);
+    if (trace.getDimension() != this->dimension_) {
+        throw std::runtime_error(std::string("The dimension of the binary trace does not match the network: ")
+            + this->fname_);
+    }
+    if (trace.isProtocol() != this->sync_protocol_) {
+        throw std::runtime_error(std::string("The binary trace and the sync protocol setting do not match: ")
+            + this->fname_);
+    }
+    AddrType address;
+    for (std::size_t i = 0; i < trace.size(); i++) {
+        records.start_time.push_back(trace.getStartTime(i));
+        trace.getSrcAddr(i, address);
+        records.src_addr.insert(records.src_addr.end(), address.begin(), address.end());
+        trace.getDesAddr(i, address);
+        records.des_addr.insert(records.des_addr.end(), address.begin(), address.end());
+        records.packet_size.push_back(trace.getPacketSize(i));
+        if (this->sync_protocol_) {
+            records.des_time.push_back(trace.getDesTime(i));
+            records.proto_dsc.push_back(trace.getProtoDsc(i));
+        }
+    }
+    return true;
+}
@@ -10,7 +10,13 @@ void Config::fromJson(const std::string& fname) {
 
     json j;
     ifs >> j;
+    this->fromJson(j);
+}
 
+void Config::fromJson(const json& j) {
+    if (!j.is_object()) {
+        throw std::runtime_error("A configuration should be a JSON object");
+    }
     if (j.contains("vertices")) {
         this->ary_number_ = j["vertices"].get<long>();
     }
@@ -81,9 +87,48 @@ void Config::fromJson(const std::string& fname) {
     if (j.contains("reconfig_file")) {
         this->reconfig_file_path_ = j["reconfig_file"].get<std::string>();
     }
+    if (j.contains("routing_cache")) {
+        this->routing_cache_dir_ = j["routing_cache"].get<std::string>();
+    }
     if (j.contains("log_file")) {
         this->log_fname_ = j["log_file"].get<std::string>();
     }
+    if (j.contains("log_level")) {
+        std::string tmp = j["log_level"].get<std::string>();
+        if (tmp == "DEBUG") {
+            this->log_level_ = LogLevel::Debug;
+        }
+        else if (tmp == "INFO") {
+            this->log_level_ = LogLevel::Info;
+        }
+        else if (tmp == "WARN") {
+            this->log_level_ = LogLevel::Warn;
+        }
+        else if (tmp == "ERROR") {
+            this->log_level_ = LogLevel::Error;
+        }
+        else {
+            throw std::runtime_error("Invalid log level");
+        }
+    }
+    if (j.contains("log_overflow")) {
+        std::string tmp = j["log_overflow"].get<std::string>();
+        if (tmp == "BLOCK") {
+            this->log_overflow_ = LogOverflow::Block;
+        }
+        else if (tmp == "DROP") {
+            this->log_overflow_ = LogOverflow::Drop;
+        }
+        else {
+            throw std::runtime_error("Invalid log overflow policy");
+        }
+    }
+    if (j.contains("event_trace")) {
+        this->event_trace_fname_ = j["event_trace"].get<std::string>();
+    }
+    if (j.contains("telemetry_file")) {
+        this->telemetry_fname_ = j["telemetry_file"].get<std::string>();
+    }
     if (j.contains("packet_loss")) {
         this->packet_loss_ = j["packet_loss"].get<bool>();
     }
@@ -93,6 +138,84 @@ void Config::fromJson(const std::string& fname) {
     if (j.contains("protocol_enable")) {
         this->sync_protocol_enable_ = j["protocol_enable"].get<bool>();
     }
+    if (j.contains("event_queue")) {
+        std::string tmp = j["event_queue"].get<std::string>();
+        if (tmp == "HEAP") {
+            this->event_queue_ = EventQueueType::HEAP;
+        }
+        else if (tmp == "CALENDAR") {
+            this->event_queue_ = EventQueueType::CALENDAR;
+        }
+        else {
+            throw std::runtime_error("Invalid event queue type");
+        }
+    }
+    if (j.contains("state_layout")) {
+        std::string tmp = j["state_layout"].get<std::string>();
+        if (tmp == "PER_ROUTER") {
+            this->state_layout_ = StateLayoutType::PER_ROUTER;
+        }
+        else if (tmp == "NETWORK") {
+            this->state_layout_ = StateLayoutType::NETWORK;
+        }
+        else {
+            throw std::runtime_error("Invalid state layout type");
+        }
+    }
+    if (j.contains("router_schedule")) {
+        std::string tmp = j["router_schedule"].get<std::string>();
+        if (tmp == "FULL") {
+            this->router_schedule_ = RouterScheduleType::FULL;
+        }
+        else if (tmp == "ACTIVE") {
+            this->router_schedule_ = RouterScheduleType::ACTIVE;
+        }
+        else {
+            throw std::runtime_error("Invalid router schedule type");
+        }
+    }
+    if (j.contains("power_mode")) {
+        std::string tmp = j["power_mode"].get<std::string>();
+        if (tmp == "FULL") {
+            this->power_mode_ = PowerModeType::FULL;
+        }
+        else if (tmp == "ACTIVITY") {
+            this->power_mode_ = PowerModeType::ACTIVITY;
+        }
+        else if (tmp == "OFF") {
+            this->power_mode_ = PowerModeType::OFF;
+        }
+        else {
+            throw std::runtime_error("Invalid power mode");
+        }
+    }
+    if (j.contains("pipeline_threads")) {
+        this->pipeline_threads_ = j["pipeline_threads"].get<long>();
+    }
+    if (j.contains("partitions")) {
+        this->partitions_ = j["partitions"].get<long>();
+    }
+    if (j.contains("trace_window")) {
+        this->trace_window_ = j["trace_window"].get<TimeType>();
+    }
+    if (j.contains("trace_poll_interval")) {
+        this->trace_poll_interval_ = j["trace_poll_interval"].get<long>();
+    }
+    if (j.contains("delay_format")) {
+        std::string tmp = j["delay_format"].get<std::string>();
+        if (tmp == "TEXT") {
+            this->delay_format_ = DelayFormatType::TEXT;
+        }
+        else if (tmp == "BINARY") {
+            this->delay_format_ = DelayFormatType::BINARY;
+        }
+        else {
+            throw std::runtime_error("Invalid delay file format");
+        }
+    }
+    if (j.contains("delay_async")) {
+        this->delay_async_ = j["delay_async"].get<bool>();
+    }
     if (j.contains("random_seed")) {
         this->random_seed_ = std::make_unique<long>(j["random_seed"].get<long>());
     }
@@ -101,10 +224,26 @@ void Config::fromJson(const std::string& fname) {
     }
 }
 
+/**
+ * @brief Parse an option of the command line given as the index of an enum value
+ * @param arg The option
+ * @param last The last value of the enum
+ * @param what The error if it is not a value of the enum
+ * @return The enum value
+ */
+template<typename T>
+static T parseEnumOption(const char* arg, T last, const char* what) {
+    int index = std::stoi(arg);
+    if (index < 0 || index > static_cast<int>(last)) {
+        throw std::runtime_error(what);
+    }
+    return static_cast<T>(index);
+}
+
 void Config::fromCMD(int argc, char * const argv []) {
-    std::string opt_str = "h:?:A:c:V:B:F:T:r:I:O:R:L:G:m:C:l:D:P:E";
+    std::string opt_str = "h:?:A:c:V:B:F:T:r:I:O:R:L:G:m:C:l:D:P:EQ:S:Y:M:W:K:w:p:X:av:o:e:t:k:";
     std::string usage = std::string("usage: ") + argv[0] + " [" + opt_str + "] \n";
-    std::string help("h: help\n?: help\nA: array size\nc: cube dimension\nV: virtual channel number\nB: buffer size\nO: outbuffer size\nF: flit size\nL: link legnth\nT: simulation length\nI: trace file\nR: routing algorithm: 0-dimension 1-opty\n");
+    std::string help("h: help\n?: help\nA: array size\nc: cube dimension\nV: virtual channel number\nB: buffer size\nO: outbuffer size\nF: flit size\nL: link legnth\nT: simulation length\nI: trace file\nR: routing algorithm: 0-dimension 1-opty\nQ: event queue: 0-heap 1-calendar\nS: router state layout: 0-per router 1-network\nY: router schedule: 0-full sweep 1-active routers\nM: power model: 0-full 1-activity 2-off\nW: router pipeline threads\nK: partitions of the parallel engine\nw: trace window, 0 reads the whole trace\np: poll interval of traces ending with -1 in ms, 0 waits for writes\nX: delay file format: 0-text 1-binary\na: write the delay file on a writer thread\nv: log level: 0-debug 1-info 2-warn 3-error\no: full log buffers: 0-block 1-drop debug and info messages\ne: event trace file\nt: telemetry file, written every report period\nk: routing table cache directory of graph topologies\n");
     while (true) {
         
         long ch = ::getopt(argc, argv, opt_str.c_str());
@@ -175,6 +314,10 @@ void Config::fromCMD(int argc, char * const argv []) {
                 this->reconfig_file_path_ = optarg;
                 break;
 
+            case 'k':
+                this->routing_cache_dir_ = optarg;
+                break;
+
             case 'l':
                 this->packet_loss_ = true;
                 break;
@@ -191,6 +334,63 @@ void Config::fromCMD(int argc, char * const argv []) {
                 this->end_with_minus_1_ = true;
                 break;
 
+            case 'Q':
+                this->event_queue_ = parseEnumOption(optarg, EventQueueType::CALENDAR, "Invalid event queue type");
+                break;
+
+            case 'S':
+                this->state_layout_ = parseEnumOption(optarg, StateLayoutType::NETWORK, "Invalid state layout type");
+                break;
+
+            case 'Y':
+                this->router_schedule_ = parseEnumOption(optarg, RouterScheduleType::ACTIVE,
+                    "Invalid router schedule type");
+                break;
+
+            case 'M':
+                this->power_mode_ = parseEnumOption(optarg, PowerModeType::OFF, "Invalid power mode");
+                break;
+
+            case 'W':
+                this->pipeline_threads_ = std::stol(optarg);
+                break;
+
+            case 'K':
+                this->partitions_ = std::stol(optarg);
+                break;
+
+            case 'w':
+                this->trace_window_ = std::stod(optarg);
+                break;
+
+            case 'p':
+                this->trace_poll_interval_ = std::stol(optarg);
+                break;
+
+            case 'X':
+                this->delay_format_ = parseEnumOption(optarg, DelayFormatType::BINARY, "Invalid delay file format");
+                break;
+
+            case 'a':
+                this->delay_async_ = true;
+                break;
+
+            case 'v':
+                this->log_level_ = parseEnumOption(optarg, LogLevel::Error, "Invalid log level");
+                break;
+
+            case 'o':
+                this->log_overflow_ = parseEnumOption(optarg, LogOverflow::Drop, "Invalid log overflow policy");
+                break;
+
+            case 'e':
+                this->event_trace_fname_ = optarg;
+                break;
+
+            case 't':
+                this->telemetry_fname_ = optarg;
+                break;
+
             case '?':
                 throw std::runtime_error(help);
                 break;
@@ -203,9 +403,9 @@ void Config::fromCMD(int argc, char * const argv []) {
 }
 
 /**
- * @brief The constructor for the Config class
+ * @brief The default values of the parameters
  */
-Config::Config(int argc, char * const argv [])
+Config::Config()
 :   ary_number_(8),
 	cube_number_(2),
 	virtual_channel_number_(2),
@@ -216,13 +416,34 @@ Config::Config(int argc, char * const argv [])
 	routing_alg_(0),
 	vc_share_(VCShareType::SHARE),
     report_period_(REPORT_PERIOD_),
-    log_fname_(),
-    delay_fname_(),
     packet_loss_(false),
+    end_with_minus_1_(false),
+    delay_fname_(),
+    log_fname_(),
+    log_level_(LogLevel::Info),
+    log_overflow_(LogOverflow::Block),
+    event_trace_fname_(),
+    telemetry_fname_(),
     sync_protocol_enable_(false),
-    end_with_minus_1_(false)
+    event_queue_(EventQueueType::CALENDAR),
+    state_layout_(StateLayoutType::PER_ROUTER),
+    router_schedule_(RouterScheduleType::ACTIVE),
+    power_mode_(PowerModeType::FULL),
+    pipeline_threads_(1),
+    partitions_(1),
+    trace_window_(0),
+    trace_poll_interval_(LIVE_TRACE_REPOLL_MS_),
+    delay_format_(DelayFormatType::TEXT),
+    delay_async_(false)
+{}
+
+/**
+ * @brief The constructor for the Config class
+ */
+Config::Config(int argc, char * const argv [])
+:   Config()
 {
-    std::string help("h: help\n?: help\nA: array size\nc: cube dimension\nV: virtual channel number\nB: buffer size\nO: outbuffer size\nF: flit size\nL: link legnth\nT: simulation length\nI: trace file\nR: routing algorithm: 0-dimension 1-opty\n");
+    std::string help("h: help\n?: help\nA: array size\nc: cube dimension\nV: virtual channel number\nB: buffer size\nO: outbuffer size\nF: flit size\nL: link legnth\nT: simulation length\nI: trace file\nR: routing algorithm: 0-dimension 1-opty\nQ: event queue: 0-heap 1-calendar\nS: router state layout: 0-per router 1-network\nY: router schedule: 0-full sweep 1-active routers\nM: power model: 0-full 1-activity 2-off\nW: router pipeline threads\nK: partitions of the parallel engine\nw: trace window, 0 reads the whole trace\np: poll interval of traces ending with -1 in ms, 0 waits for writes\nX: delay file format: 0-text 1-binary\na: write the delay file on a writer thread\nv: log level: 0-debug 1-info 2-warn 3-error\no: full log buffers: 0-block 1-drop debug and info messages\ne: event trace file\nt: telemetry file, written every report period\nk: routing table cache directory of graph topologies\n");
     Sassert(argc > 1, help.c_str());
 
     if (argc == 3 && std::string(argv[1]) == "-JSON") {
@@ -231,7 +452,44 @@ Config::Config(int argc, char * const argv [])
     else {
         this->fromCMD(argc, argv);
     }
-    
+    this->validate();
+}
+
+Config::Config(const json& j)
+:   Config()
+{
+    this->fromJson(j);
+    this->validate();
+}
+
+void Config::validate() {
+    // Routing algorithms are read as integers, from the command line and from JSON.
+    if (this->routing_alg_ < 0 || this->routing_alg_ > static_cast<long>(RoutingType::RECONFIGURABLE_GRAPH_TOPO)) {
+        throw std::runtime_error("Invalid routing algorithm type");
+    }
+    if (this->pipeline_threads_ < 1) {
+        throw std::runtime_error("The number of pipeline threads should be positive");
+    }
+    if (this->partitions_ < 1) {
+        throw std::runtime_error("The number of partitions should be positive");
+    }
+    if (this->trace_window_ < 0) {
+        throw std::runtime_error("The trace window should not be negative");
+    }
+    if (this->trace_window_ > 0 && (this->sync_protocol_enable_ || this->end_with_minus_1_)) {
+        throw std::runtime_error("Traces of the sync protocol or ending with -1 cannot be streamed");
+    }
+    if (this->trace_poll_interval_ < 0) {
+        throw std::runtime_error("The trace poll interval should not be negative");
+    }
+    if (!this->telemetry_fname_.empty() && this->report_period_ <= 0) {
+        throw std::runtime_error("The report period should be positive to write telemetry");
+    }
+
+    if (this->cube_number_ > MAX_DIMENSION_) {
+        throw std::runtime_error("Dimension exceeds MAX_DIMENSION_ (" + std::to_string(MAX_DIMENSION_) + ")");
+    }
+
     this->physical_port_number_ = this->cube_number_ * 2 + 1;
     if (this->getRoutingAlg() == RoutingType::CHIPLET_STAR_TOPO_ROUTING) {
         this->physical_port_number_ = std::max(this->physical_port_number_,
@@ -305,6 +563,22 @@ const std::string& Config::getLogFilePath() const {
     return this->log_fname_;
 }
 
+LogLevel Config::getLogLevel() const {
+    return this->log_level_;
+}
+
+LogOverflow Config::getLogOverflow() const {
+    return this->log_overflow_;
+}
+
+const std::string& Config::getEventTraceFname() const {
+    return this->event_trace_fname_;
+}
+
+const std::string& Config::getTelemetryFname() const {
+    return this->telemetry_fname_;
+}
+
 const std::string& Config::getTopoFilePath() const {
     return this->topo_file_path_;
 }
@@ -317,6 +591,10 @@ const std::string& Config::getReconfigFilePath() const {
     return this->reconfig_file_path_;
 }
 
+const std::string& Config::getRoutingCacheDir() const {
+    return this->routing_cache_dir_;
+}
+
 bool Config::isPacketLoss() const {
     return this->packet_loss_;
 }
@@ -329,6 +607,46 @@ bool Config::isSyncProtocolEnable() const {
     return this->sync_protocol_enable_;
 }
 
+EventQueueType Config::getEventQueueType() const {
+    return this->event_queue_;
+}
+
+StateLayoutType Config::getStateLayout() const {
+    return this->state_layout_;
+}
+
+RouterScheduleType Config::getRouterSchedule() const {
+    return this->router_schedule_;
+}
+
+PowerModeType Config::getPowerMode() const {
+    return this->power_mode_;
+}
+
+long Config::getPipelineThreads() const {
+    return this->pipeline_threads_;
+}
+
+long Config::getPartitions() const {
+    return this->partitions_;
+}
+
+TimeType Config::getTraceWindow() const {
+    return this->trace_window_;
+}
+
+long Config::getTracePollInterval() const {
+    return this->trace_poll_interval_;
+}
+
+DelayFormatType Config::getDelayFormat() const {
+    return this->delay_format_;
+}
+
+bool Config::isDelayAsync() const {
+    return this->delay_async_;
+}
+
 std::optional<long> Config::getRandomSeed() const {
     if (!this->random_seed_) {
         return std::nullopt;
@@ -350,6 +668,21 @@ std::ostream& operator<<(std::ostream& os, const Config& cf) {
     os << "Link length:       " << cf.getLinkLength() << "\n";
     os << "Simulation length: " << cf.getSimLength() << "\n";
     os << "Trace file:        " << cf.getTraceFname() << "\n";
-    os << "Routing algorithm: " << cf.getRoutingAlg();
+    os << "Routing algorithm: " << cf.getRoutingAlg() << "\n";
+    os << "Event queue:       " << cf.getEventQueueType() << "\n";
+    os << "State layout:      " << cf.getStateLayout() << "\n";
+    os << "Router schedule:   " << cf.getRouterSchedule() << "\n";
+    os << "Power mode:        " << cf.getPowerMode() << "\n";
+    os << "Pipeline threads:  " << cf.getPipelineThreads() << "\n";
+    os << "Partitions:        " << cf.getPartitions() << "\n";
+    os << "Trace window:      " << cf.getTraceWindow() << "\n";
+    os << "Poll interval:     " << cf.getTracePollInterval() << "\n";
+    os << "Delay format:      " << cf.getDelayFormat() << "\n";
+    os << "Delay async:       " << cf.isDelayAsync() << "\n";
+    os << "Log level:         " << cf.getLogLevel() << "\n";
+    os << "Log overflow:      " << cf.getLogOverflow() << "\n";
+    os << "Event trace:       " << cf.getEventTraceFname() << "\n";
+    os << "Telemetry file:    " << cf.getTelemetryFname() << "\n";
+    os << "Routing cache:     " << cf.getRoutingCacheDir();
     return os;
 }
\ No newline at end of file
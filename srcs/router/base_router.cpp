@@ -79,6 +79,10 @@ void BaseRouter::getNextAddress_mesh(AddrType& nextAddress, long port) {
     }
 }
 
+RouterId BaseRouter::getNextRouterId(long port) {
+    return this->next_routers_[port];
+}
+
 long BaseRouter::getWirePc(long port) {
     return this->curr_wirePcFunc(port);
 }
@@ -139,6 +143,22 @@ void BaseRouter::getFromRouter_chipletStar(AddrType& from, long port) {
 	}
 }
 
+RouterId BaseRouter::getFromRouterId(long port) {
+    return this->from_routers_[port];
+}
+
+void BaseRouter::linkNeighbours() {
+    AddrType address;
+    this->next_routers_.assign(this->physic_ports_, INVALID_ROUTER_ID_);
+    this->from_routers_.assign(this->physic_ports_, INVALID_ROUTER_ID_);
+    for (long port = 1; port < this->physic_ports_; port++) {
+        this->getNextAddress(address, port);
+        this->next_routers_[port] = this->address_table_.getId(address);
+        this->getFromRouter(address, port);
+        this->from_routers_[port] = this->address_table_.getId(address);
+    }
+}
+
 long BaseRouter::getFromPort(long port) {
     return this->curr_prevPortFunc(port);
 }
@@ -219,18 +239,9 @@ TimeType BaseRouter::getPipeStageDelay() const {
     return PIPE_DELAY_;
 }
 
-BaseRouter& BaseRouter::getRouter(const AddrType& addr) {
-    long idx = 0;
-    for (long i = 0; i < addr.size(); i++) {
-        idx = idx * this->ary_size_ + addr[i];
-    }
-    BaseRouter *ret = nullptr;
-    try {
-        ret = this->router_list_.at(idx);
-    } catch (const std::out_of_range& e) {
-        Sassert(false, e.what());
-    }
-    return *ret;
+BaseRouter& BaseRouter::getRouter(RouterId id) {
+    Sassert(id < this->router_list_.size(), "Router ID out of range.");
+    return *this->router_list_[id];
 }
 
 void BaseRouter::updateTrans(TimeType new_time, const Flit& flit) {
@@ -247,25 +258,8 @@ void BaseRouter::updateTrans(TimeType new_time, const Flit& flit) {
     }
 
     if (trans_it.status == ProtoState::DONE) {
-            
-        std::ofstream ofs(this->config_.getDelayFname(), std::ios::app);
-            
-        ofs << (long)trans_it.src_time << ' ';
-            
-        for (auto& x : trans_it.src_addr)
-            ofs << x << ' ';
-            
-        for (auto& x : trans_it.des_addr)
-            ofs << x << ' ';
-            
-        ofs << trans_it.protoDesc << ' ' << trans_it.packetDelay.size();
-            
-        for (auto& x : trans_it.packetDelay)
-            ofs << ' ' << (long)x;
-            
-        ofs << std::endl;
-
-        ofs.close();
+        Global::delaySink()->writeTransaction(trans_it.src_time, trans_it.src_addr, trans_it.des_addr,
+            trans_it.protoDesc, trans_it.packetDelay, false);
     }
 }
 
@@ -284,13 +278,13 @@ void BaseRouter::updateTransACK(TimeType new_time, ProtoStateMachine& trans) {
         packet.packet_size = 1;
         packet.id = trans.id;
         
-        if (Global::inputTrace->isEmpty(this->address_)
-            || Global::inputTrace->front().start_time > packet.start_time
+        if (Global::inputTrace()->isEmpty(this->id_)
+            || Global::inputTrace()->front().start_time > packet.start_time
         ) {
 		    this->setLocalTime(packet.start_time);
 	    }
-        Global::inputTrace->addTrace(packet);
-        Global::messageQueue.updateEVGCycle(packet.start_time);
+        Global::inputTrace()->addTrace(packet);
+        Global::messageQueue().updateEVGCycle(packet.start_time);
         
         trans.status = ProtoState::ACK_TRANS;
     }
@@ -303,6 +297,14 @@ void BaseRouter::updateTransNormal(TimeType new_time, ProtoStateMachine& trans)
     trans.status = ProtoState::DONE;
 }
 
+const AddrType& BaseRouter::getAddress() const {
+    return this->address_;
+}
+
+RouterId BaseRouter::getId() const {
+    return this->id_;
+}
+
 TimeType BaseRouter::getLocalTime() const {
     return this->local_time_;
 }
@@ -313,24 +315,19 @@ void BaseRouter::setLocalTime(TimeType new_local_time) {
 
 void BaseRouter::acceptFlit(TimeType accept_time, const Flit& target_flit) {
 
+    this->accepted_flits_++;
     if (!isTail(target_flit.getFlitType())) {
         return;
     }
+    this->accepted_packets_++;
     
     if (this->config_.isSyncProtocolEnable() == false) {
-		std::ofstream ofs(this->config_.getDelayFname(), std::ios::app);
 		Global::incTotalFin();
 		TimeType t = accept_time - target_flit.getStartTime();
 		this->updateDelay(t);
-		ofs << (long)target_flit.getStartTime() << ' ';
-		for (auto &x : target_flit.getSrcAddr()) {
-            ofs << x << ' ';
-        }
-		for (auto &x : target_flit.getDesAddr()) {
-            ofs << x << ' ';
-        }
-		ofs << t << std::endl;
-        ofs.close();
+        Global::delaySink()->writePacket(target_flit.getStartTime(),
+            this->address_table_.getAddress(target_flit.getSrc()),
+            this->address_table_.getAddress(target_flit.getDes()), t);
 	}
 	else {
 		Global::incTotalFin();
@@ -340,6 +337,15 @@ void BaseRouter::acceptFlit(TimeType accept_time, const Flit& target_flit) {
 	}
 }
 
+void BaseRouter::acceptFlit(TimeType accept_time, FlitHandle target_flit) {
+    if (this->outbox_ != nullptr) {
+        this->outbox_->accepted.push_back({this, accept_time, target_flit});
+        return;
+    }
+    this->acceptFlit(accept_time, Global::flitPool().get(target_flit));
+    Global::flitPool().release(target_flit);
+}
+
 double BaseRouter::getBufferPower() {
     return this->power_module_.getBufferPower();
 }
@@ -348,6 +354,10 @@ double BaseRouter::getLinkPower() {
     return this->power_module_.getLinkPower();
 }
 
+double BaseRouter::getLinkPower(long port) {
+    return this->power_module_.getLinkPower(port);
+}
+
 double BaseRouter::getCrossbarPower() {
     return this->power_module_.getCrossbarPower();
 }
@@ -364,18 +374,38 @@ TimeType BaseRouter::getTotalDelay() const {
     return this->total_delay_;
 }
 
+std::size_t BaseRouter::getInjectedFlits() const {
+    return this->injected_flits_;
+}
+
+std::size_t BaseRouter::getAcceptedFlits() const {
+    return this->accepted_flits_;
+}
+
+std::size_t BaseRouter::getAcceptedPackets() const {
+    return this->accepted_packets_;
+}
+
+std::size_t BaseRouter::getInputFlits() const {
+    return this->input_module_.getFlitCount();
+}
+
+std::size_t BaseRouter::getOutputFlits() const {
+    return this->output_module_.getFlitCount();
+}
+
 void BaseRouter::recvCredit(long phy_idx, long vc_idx) {
     this->output_module_.incCounter(phy_idx, vc_idx);
 }
 
 void BaseRouter::recvPacket() {
     
-    if (Global::inputTrace->isEmpty(this->address_)) 
+    if (Global::inputTrace()->isEmpty(this->id_)) 
         return;
     
     
     if (this->local_time_ == LOCAL_INPUT_TIME_0) {
-        this->local_time_ = Global::inputTrace->front().start_time;
+        this->local_time_ = Global::inputTrace()->front(this->id_).start_time;
     }
 
     TimeType event_time = Global::getCurrTime();
@@ -383,57 +413,38 @@ void BaseRouter::recvPacket() {
     while (this->input_module_.isIBuffFull() == false
         && this->local_time_ <= (event_time + S_ELPS_))
 	{
-		if (Global::inputTrace->isEmpty(this->address_)) 
+		if (Global::inputTrace()->isEmpty(this->id_)) 
             return;
 		
-        const SPacket& p = Global::inputTrace->front(this->address_);
+        const SPacket& p = Global::inputTrace()->front(this->id_);
 		
-        this->injctPacket(packet_counter_, p.src_addr, p.des_addr, this->local_time_, p.packet_size, p.id);
+        this->injctPacket(packet_counter_, p.src_id, p.des_id, this->local_time_, p.packet_size, p.id);
 		
         packet_counter_++;
 		
-        Global::inputTrace->popFront(this->address_);
+        Global::inputTrace()->popFront(this->id_);
 		
-        if (!Global::inputTrace->isEmpty(this->address_)) {
-			this->local_time_ = Global::inputTrace->front().start_time;
+        if (!Global::inputTrace()->isEmpty(this->id_)) {
+			this->local_time_ = Global::inputTrace()->front().start_time;
 		}
 	}
 	
 	if (FILTERING_BOOL && this->input_module_.isIBuffFull()) {
-        std::ostringstream os;
-        os << this->address_;
-        Logger::info("Jam at time {} in router {}.", Global::getCurrTime(), os.str());
+        LOG_INFO("Jam at time {} in router {}.", Global::getCurrTime(),
+            Logger::stream_to_string<AddrType>(this->address_));
 	}
 }
 
-void BaseRouter::injctPacket(long flit_id, const AddrType& src_addr,
-    const AddrType& des_addr, TimeType start_time,
-    long packet_size, TId packet_id)
+void BaseRouter::injctPacket(long flit_id, RouterId src, RouterId des,
+    TimeType start_time, long packet_size, TId packet_id)
 {
     VCType vc_t;
 
-    for (auto& iter : src_addr) {
-        if (iter >= this->ary_size_ || iter < 0) {
-            Sassert(false, "Coordinate out of range.");
-        }
-    }
-    for (auto& iter : des_addr) {
-        if (iter >= this->ary_size_ || iter < 0) {
-            Sassert(false, "Coordinate out of range.");
-        }
-    }
+    // The addresses were checked when the packet was queued by `InputTrace`.
+    Sassert(src < this->router_list_.size() && des < this->router_list_.size(), "Router ID out of range.");
+    this->injected_flits_ += packet_size;
 
     for (long idx = 0; idx < packet_size; idx++) {
-        DataType flit_data;
-        for (long flit_idx = 0; flit_idx < this->flit_size_; flit_idx++) {
-            this->init_data_[flit_idx] = static_cast<AtomType>(
-                this->init_data_[flit_idx] * CORR_EFF_ +
-                Global::RandomGen.random_u_long_long(0, MAX_64_)
-            );
-            // Logger::debug("Flit data: {}", this->init_data_[flit_idx]);
-			flit_data.push_back(this->init_data_[flit_idx]);
-        }
-
         FlitType flit_type = FlitType::BODY;
         if (idx == 0) {
             vc_t = std::pair<long, long>(0, this->input_module_.getBufferSize(0, 0));
@@ -461,8 +472,29 @@ void BaseRouter::injctPacket(long flit_id, const AddrType& src_addr,
             flit_type = FlitType::TAIL;
 		}
 
-        Flit flit(flit_id, flit_type,
-            src_addr, des_addr, start_time, flit_data, packet_id);
+        // The payload lives in the flit pool from here until `acceptFlit`.
+        FlitHandle handle = Global::flitPool().allocate(flit_id, flit_type,
+            src, des, start_time, packet_id);
+        Flit& flit = Global::flitPool().get(handle);
+        DataType& flit_data = flit.getData();
+        if (this->config_.getPowerMode() == PowerModeType::FULL) {
+            flit_data.reserve(this->flit_size_);
+            for (long flit_idx = 0; flit_idx < this->flit_size_; flit_idx++) {
+                this->init_data_[flit_idx] = static_cast<AtomType>(
+                    this->init_data_[flit_idx] * CORR_EFF_ +
+                    this->random().random_u_long_long(0, MAX_64_)
+                );
+                // Logger::debug("Flit data: {}", this->init_data_[flit_idx]);
+                flit_data.push_back(this->init_data_[flit_idx]);
+            }
+        }
+        else {
+            // The flit carries no payload, but the draws are kept so that the arbitration
+            // sees the same random numbers, and the delays match the full power model.
+            for (long flit_idx = 0; flit_idx < this->flit_size_; flit_idx++) {
+                this->random().random_u_long_long(0, MAX_64_);
+            }
+        }
 		
         flit.setSendFinTime(start_time + idx);
         
@@ -470,43 +502,28 @@ void BaseRouter::injctPacket(long flit_id, const AddrType& src_addr,
             ProtoStateMachine& trans_it = Global::getTrans(flit.getPacketId());
 
             trans_it.packetDelay.push_back(flit.getSendFinTime() - flit.getStartTime());
-            
-            std::ofstream ofs(this->config_.getDelayFname(), std::ios::app);
-            
-            ofs << (long)trans_it.src_time << ' ';
-                
-            for (auto& x : trans_it.src_addr)
-                ofs << x << ' ';
-                
-            for (auto& x : trans_it.des_addr)
-                ofs << x << ' ';
-                
-            ofs << trans_it.protoDesc << ' ' << trans_it.packetDelay.size();
-                
-            for (auto& x : trans_it.packetDelay)
-                ofs << ' ' << (long)x;
-            
-            ofs << ' ' << -1;   
-            ofs << std::endl;
-
-            ofs.close();
+
+            Global::delaySink()->writeTransaction(trans_it.src_time, trans_it.src_addr, trans_it.des_addr,
+                trans_it.protoDesc, trans_it.packetDelay, true);
         }
 		
-        this->input_module_.addFlit(0, vc_t.first, flit);
 		this->power_module_.addBufferWritePwr(0, flit_data);
+        this->input_module_.addFlit(0, vc_t.first, handle);
     }
 }
 
-void BaseRouter::recvFlit(long phy_idx, long vc_idx, Flit& flit) {
+void BaseRouter::recvFlit(long phy_idx, long vc_idx, FlitHandle handle) {
+    Flit& flit = Global::flitPool().get(handle);
     if (this->config_.isPacketLoss()) {
         if (this->input_module_.getBufferSize(phy_idx, vc_idx) > this->inbuffer_size_) {
-            Global::AbandonedPackets.insert(flit.getPacketId());
+            Global::AbandonedPackets().insert(flit.getPacketId());
         }
-        if (Global::AbandonedPackets.count(flit.getPacketId()) > 0) {
+        if (Global::AbandonedPackets().count(flit.getPacketId()) > 0) {
+            Global::flitPool().release(handle);
             return;
         }
     }
-    this->input_module_.addFlit(phy_idx, vc_idx, flit);
+    this->input_module_.addFlit(phy_idx, vc_idx, handle);
     this->power_module_.addBufferWritePwr(phy_idx, flit.getData());
 
     if (isHeader(flit.getFlitType())) {
@@ -529,15 +546,15 @@ void BaseRouter::decideRouting() {
 
     for (long each_vc = 0; each_vc < this->vc_number_; each_vc++) {
         if (this->input_module_.getState(0, each_vc) == VCStateType::ROUTING) {
-            Flit flit(this->input_module_.getFlit(0, each_vc));
-            AddrType des_t = flit.getDesAddr();
-            AddrType sor_t = flit.getSrcAddr();
-            if (this->address_ == des_t) {
-                this->acceptFlit(event_time, flit);
+            FlitHandle handle = this->input_module_.getFlit(0, each_vc);
+            const Flit& flit = Global::flitPool().get(handle);
+            if (flit.getDes() == this->id_) {
+                FlitType flit_type = flit.getFlitType();
+                this->acceptFlit(event_time, handle);
                 this->input_module_.removeFlit(0, each_vc);
 
                 VCStateType vcst;
-                if (flit.getFlitType() == FlitType::HEADER) {
+                if (flit_type == FlitType::HEADER) {
                     vcst = VCStateType::HOME;
                 }
                 else {
@@ -547,17 +564,20 @@ void BaseRouter::decideRouting() {
             }
             else {
                 this->input_module_.clearRouting(0, each_vc);
-                this->routingAlg(des_t, sor_t, 0, each_vc);
+                this->routingAlg(this->address_table_.getAddress(flit.getDes()),
+                    this->address_table_.getAddress(flit.getSrc()), 0, each_vc);
                 this->input_module_.setState(0, each_vc, VCStateType::VC_AB);
             }
         }
         else if (this->input_module_.getState(0, each_vc) == VCStateType::HOME) {
             if (this->input_module_.getBufferSize(0, each_vc) > 0) {
-                Flit flit(this->input_module_.getFlit(0, each_vc));
+                FlitHandle handle = this->input_module_.getFlit(0, each_vc);
+                const Flit& flit = Global::flitPool().get(handle);
                 Sassert(!isHeader(flit.getFlitType()), "Error: Flit type is not HEADER");
-                this->acceptFlit(event_time, flit);
+                FlitType flit_type = flit.getFlitType();
+                this->acceptFlit(event_time, handle);
                 this->input_module_.removeFlit(0, each_vc);
-                if (flit.getFlitType() == FlitType::TAIL) {
+                if (flit_type == FlitType::TAIL) {
                     if (this->input_module_.getBufferSize(0, each_vc) > 0) {
                         this->input_module_.setState(0, each_vc, VCStateType::ROUTING);
                     }
@@ -572,32 +592,28 @@ void BaseRouter::decideRouting() {
     for (long each_phy = 1; each_phy < this->physic_ports_; each_phy++) {
         for (long each_vc = 0; each_vc < this->vc_number_; each_vc++) {
             if (this->input_module_.getBufferSize(each_phy, each_vc) > 0) {
-                Flit flit(this->input_module_.getFlit(each_phy, each_vc));
-                AddrType des_t = flit.getDesAddr();
-                if (this->address_ == des_t) {
-                    AddrType cre_add_t;
-					long cre_pc_t;
-                    this->getFromRouter(cre_add_t, each_phy);
-                    cre_pc_t = this->getFromPort(each_phy);
-                    Global::messageQueue.addMessage(
+                FlitHandle handle = this->input_module_.getFlit(each_phy, each_vc);
+                const Flit& flit = Global::flitPool().get(handle);
+                if (flit.getDes() == this->id_) {
+                    this->postEvent(
 					    MessEvent(event_time + CREDIT_DELAY_,
-                            MessType::CREDIT, this->address_,
-                            cre_add_t, cre_pc_t, each_vc
+                            MessType::CREDIT, this->id_,
+                            this->getFromRouterId(each_phy), this->getFromPort(each_phy), each_vc
                         )
                     );
                 }
             }
             if (this->input_module_.getState(each_phy, each_vc) == VCStateType::ROUTING) {
-                Flit flit(this->input_module_.getFlit(each_phy, each_vc));
+                FlitHandle handle = this->input_module_.getFlit(each_phy, each_vc);
+                const Flit& flit = Global::flitPool().get(handle);
                 Sassert(isHeader(flit.getFlitType()), "Error: Flit type is not HEADER");
-                AddrType des_t = flit.getDesAddr();
-                AddrType sor_t = flit.getSrcAddr();
-                if (this->address_ == des_t) {
-                    this->acceptFlit(event_time, flit);
+                if (flit.getDes() == this->id_) {
+                    FlitType flit_type = flit.getFlitType();
+                    this->acceptFlit(event_time, handle);
                     this->input_module_.removeFlit(each_phy, each_vc);
                     
                     VCStateType vcst;
-                    if (flit.getFlitType() == FlitType::HEADER) {
+                    if (flit_type == FlitType::HEADER) {
                         vcst = VCStateType::HOME;
                     }
                     else {
@@ -607,17 +623,20 @@ void BaseRouter::decideRouting() {
                 }
                 else {
                     this->input_module_.clearRouting(each_phy, each_vc);
-                    this->routingAlg(des_t, sor_t, each_phy, each_vc);
+                    this->routingAlg(this->address_table_.getAddress(flit.getDes()),
+                        this->address_table_.getAddress(flit.getSrc()), each_phy, each_vc);
                     this->input_module_.setState(each_phy, each_vc, VCStateType::VC_AB);
                 }
             }
             else if (this->input_module_.getState(each_phy, each_vc) == VCStateType::HOME) {
                 if (this->input_module_.getBufferSize(each_phy, each_vc) > 0) {
-                    Flit flit(this->input_module_.getFlit(each_phy, each_vc));
+                    FlitHandle handle = this->input_module_.getFlit(each_phy, each_vc);
+                    const Flit& flit = Global::flitPool().get(handle);
                     Sassert(!isHeader(flit.getFlitType()), "Error: Flit type is not HEADER");
-                    this->acceptFlit(event_time, flit);
+                    FlitType flit_type = flit.getFlitType();
+                    this->acceptFlit(event_time, handle);
                     this->input_module_.removeFlit(each_phy, each_vc);
-                    if (flit.getFlitType() == FlitType::TAIL) {
+                    if (flit_type == FlitType::TAIL) {
                         if (this->input_module_.getBufferSize(each_phy, each_vc) > 0) {
                             this->input_module_.setState(each_phy, each_vc, VCStateType::ROUTING);
                         }
@@ -648,10 +667,25 @@ void BaseRouter::routingPipeStage(TimeType routing_period) {
     this->decideRouting();
 }
 
+bool BaseRouter::isIdle() const {
+    // With empty buffers every VC is INIT or HOME, and neither state does anything without a flit.
+    return this->input_module_.getFlitCount() == 0 && this->output_module_.getFlitCount() == 0;
+}
+
+long BaseRouter::getPortNumber() const {
+    return this->physic_ports_;
+}
+
+TimeType BaseRouter::getLink(long port, RouterId& neighbour) {
+    neighbour = this->getNextRouterId(port);
+    return this->getWireDelay(port);
+}
+
 VCType BaseRouter::selectVC(long phy_idx, long vc_idx) {
-    std::vector<VCType> vc_can_t = this->input_module_.getRouting(phy_idx, vc_idx);
+    const std::vector<VCType>& vc_can_t = this->input_module_.getRouting(phy_idx, vc_idx);
     Sassert(vc_can_t.size() > 0, "Error: No available VC");
-    std::vector<VCType> vc_acq_t;
+    std::vector<VCType>& vc_acq_t = this->vc_candidates_;
+    vc_acq_t.clear();
 
     for (auto& vc : vc_can_t) {
         if (this->config_.getVcShare() == VCShareType::SHARE) {
@@ -674,12 +708,13 @@ VCType BaseRouter::selectVC(long phy_idx, long vc_idx) {
     else if (vc_acq_t.size() == 1) {
         return vc_acq_t[0];
     }    
-    return vc_acq_t[Global::RandomGen.random_long(0, vc_acq_t.size())];
+    return vc_acq_t[this->random().random_long(0, vc_acq_t.size())];
 }
 
 void BaseRouter::arbitrationVC() {
-    std::unordered_map<VCType, std::vector<VCType>, VCTypeHash> vc_o_i_map;
+    std::vector<std::vector<VCType>>& vc_o_i_map = this->vc_requests_;
 	AtomType vc_request = 0;
+    bool requested = false;
 
 	for (long i = 0; i < this->physic_ports_; i++) {
 		for (long j = 0; j < this->vc_number_; j++) {
@@ -687,24 +722,30 @@ void BaseRouter::arbitrationVC() {
 			if (this->input_module_.getState(i, j) == VCStateType::VC_AB) {
 				vc_t = this->selectVC(i,j);
 				if ((vc_t.first >= 0) && (vc_t.second >= 0)) {
-					vc_o_i_map[vc_t].push_back(VCType(i, j));
-					vc_request = vc_request | Global::VC_MASK[i * vc_number_ + j];
+					if (!requested) {
+                        for (auto& requests : vc_o_i_map) {
+                            requests.clear();
+                        }
+                        requested = true;
+                    }
+					vc_o_i_map[vc_t.first * vc_number_ + vc_t.second].push_back(VCType(i, j));
+					vc_request = vc_request | Global::VC_MASK()[i * vc_number_ + j];
 				}
 			}
 		}
 	}
-	if (vc_o_i_map.size() == 0) {
+	if (!requested) {
 		return;
 	}
     for (long i= 1; i < this->physic_ports_; i++) {
 		for (long j = 0; j < this->vc_number_; j++) {
 			if (this->output_module_.getUsage(i, j) == VCUsageType::FREE) {
-				long cont_temp = vc_o_i_map[VCType(i, j)].size();
+				const std::vector<VCType>& requests = vc_o_i_map[i * vc_number_ + j];
+				long cont_temp = requests.size();
 				if (cont_temp > 0) {
-					VCType vc_win = vc_o_i_map[VCType(i, j)][0];
+					VCType vc_win = requests[0];
 					if (cont_temp > 1) {
-						vc_win = vc_o_i_map[VCType(i, j)]
-                            [Global::RandomGen.random_long(0, cont_temp)];
+						vc_win = requests[this->random().random_long(0, cont_temp)];
 					}
 					this->input_module_.setState(vc_win.first,
                         vc_win.second, VCStateType::SW_AB);
@@ -720,9 +761,11 @@ void BaseRouter::arbitrationVC() {
 }
 
 void BaseRouter::arbitrationSW() {
-    std::unordered_map<long, std::vector<VCType>> vc_o_map;
+    std::vector<std::vector<VCType>>& vc_o_map = this->sw_requests_;
+    bool requested = false;
 	for (long i = 0; i < physic_ports_; i++) {
-		std::vector<long> vc_i_t;
+		std::vector<long>& vc_i_t = this->sw_candidates_;
+		vc_i_t.clear();
 		for (long j = 0; j < vc_number_; j++) {
 			if (this->input_module_.getState(i, j) == VCStateType::SW_AB) {
 				VCType out_t = this->input_module_.getCRouting(i, j);
@@ -734,8 +777,14 @@ void BaseRouter::arbitrationSW() {
 			}
 		}
 		long vc_size_t = vc_i_t.size();
+		if (vc_size_t > 0 && !requested) {
+			for (auto& requests : vc_o_map) {
+				requests.clear();
+			}
+			requested = true;
+		}
 		if (vc_size_t > 1) {
-			long win_t = Global::RandomGen.random_long(0, vc_size_t);
+			long win_t = this->random().random_long(0, vc_size_t);
 			VCType r_t = this->input_module_.getCRouting(i, vc_i_t[win_t]);
 			vc_o_map[r_t.first].push_back(VCType(i, vc_i_t[win_t]));
 		}
@@ -745,7 +794,7 @@ void BaseRouter::arbitrationSW() {
 		}
 	}
 
-	if (vc_o_map.size() == 0) {
+	if (!requested) {
 		return;
 	}
 
@@ -754,10 +803,9 @@ void BaseRouter::arbitrationSW() {
 		if (vc_size_t > 0) {
 			VCType vc_win = vc_o_map[i][0];
 			if (vc_size_t > 1) {
-				vc_win = vc_o_map[i][Global::RandomGen.random_long(0, vc_size_t)];
+				vc_win = vc_o_map[i][this->random().random_long(0, vc_size_t)];
 			}
 			this->input_module_.setState(vc_win.first, vc_win.second, VCStateType::SW_TR);
-			Flit &flit_t = this->input_module_.getFlit(vc_win.first, vc_win.second);
 		}
 	}
 }
@@ -771,39 +819,43 @@ void BaseRouter::toOutBuffer() {
 
 				TimeType event_time = Global::getCurrTime();
 				if (i != 0) {
-					AddrType cre_add_t;
-					long cre_pc_t;
-					this->getFromRouter(cre_add_t, i);
-					cre_pc_t = this->getFromPort(i);
-					Global::messageQueue.addMessage(
+					this->postEvent(
 						MessEvent(event_time + CREDIT_DELAY_,
-							MessType::CREDIT, this->address_,
-                            cre_add_t, cre_pc_t, j
+							MessType::CREDIT, this->id_,
+                            this->getFromRouterId(i), this->getFromPort(i), j
                         )
                     );
 				}
 
 				long in_size_t = this->input_module_.getBufferSize(i, j);
 				Sassert(in_size_t >= 1, "Error: Buffer size is less than 1");
-				Flit flit_t(input_module_.getFlit(i, j));
+				FlitHandle handle = this->input_module_.getFlit(i, j);
+				Flit& flit_t = Global::flitPool().get(handle);
+				// recvPacket() below may grow the flit pool, so keep only the type.
+				FlitType flit_type = flit_t.getFlitType();
 				this->input_module_.removeFlit(i, j);
 				this->power_module_.addBufferReadPwr(i, flit_t.getData());
 				this->power_module_.addCrossbarTravPwr(i, out_t.first, flit_t.getData());
-				this->output_module_.addFlit(out_t.first, flit_t);
+				this->output_module_.addFlit(out_t.first, handle);
 				if (i == 0) {
 					if (this->input_module_.isIBuffFull() == true) {
 						if (this->input_module_.getBufferSize(0, j) < BUFF_BOUND_) {
 							this->input_module_.setIBuffFull(false);
-							this->recvPacket();
+							if (this->outbox_ != nullptr) {
+								this->outbox_->injections.push_back({this, event_time});
+							}
+							else {
+								this->recvPacket();
+							}
 						}
 					}
 				}
 				this->output_module_.addAddr(out_t.first, out_t);
-				if (isTail(flit_t.getFlitType())) {
+				if (isTail(flit_type)) {
 					this->output_module_.releaseChannel(out_t.first, out_t.second);
 				}
 				if (in_size_t > 1) {
-					if (isTail(flit_t.getFlitType())) {
+					if (isTail(flit_type)) {
 						if (this->config_.getVcShare() == VCShareType::MONO) {
 							if (i != 0) {
 								if (in_size_t != 1) {
@@ -837,19 +889,17 @@ void BaseRouter::traverseLink(long port) {
 	if (this->output_module_.getOutBufferSize(port) > 0) {
 		TimeType delay = this->getWireDelay(port);
 		TimeType flit_delay_t = delay + event_time;
-		AddrType wire_add_t;
 		long wire_pc_t = getWirePc(port);
-		this->getNextAddress(wire_add_t, port);
-		Flit flit_t(this->output_module_.getFlit(port));
+		FlitHandle handle = this->output_module_.getFlit(port);
 		VCType outadd_t = this->output_module_.getAddr(port);
-		this->power_module_.addLinkTravPwr(port, flit_t.getData());
+		this->power_module_.addLinkTravPwr(port, Global::flitPool().get(handle).getData());
 
 		this->output_module_.removeFlit(port);
 		this->output_module_.removeAddr(port);
-		Global::messageQueue.addMessage(
+		this->postEvent(
             MessEvent(flit_delay_t, MessType::WIRE,
-                this->address_, wire_add_t,
-                wire_pc_t, outadd_t.second, flit_t
+                this->id_, this->getNextRouterId(port),
+                wire_pc_t, outadd_t.second, handle
             )
         );
 	}
@@ -1040,29 +1090,85 @@ void BaseRouter::chiplet_star_topo_routing_alg(const AddrType& des_t,const AddrT
 	}
 }
 
-BaseRouter::BaseRouter(const Config& config, AddrType addr, std::vector<BaseRouter *>& router_list)
+BaseRouter::BaseRouter(const Config& config, RouterId id, std::vector<BaseRouter *>& router_list)
 :   physic_ports_(config.getPhysicalPortNumber()),
     vc_number_(config.getVirtualChannelNumber()),
     inbuffer_size_(config.getInBufferSize()),
     outbuffer_size_(config.getOutBufferSize()),
-    address_(addr),
+    address_table_(*Global::addressTable()),
+    id_(id),
+    address_(Global::addressTable()->getAddress(id)),
+    next_routers_(),
+    from_routers_(),
     ary_size_(config.getAryNumber()),
     flit_size_(config.getFlitSize()),
     config_(config),
-    input_module_(config.getPhysicalPortNumber(), config.getVirtualChannelNumber()),
+    input_module_(config.getPhysicalPortNumber(), config.getVirtualChannelNumber(), config.getInBufferSize()),
     output_module_(config.getPhysicalPortNumber(), config.getVirtualChannelNumber(), config.getInBufferSize(), config.getOutBufferSize()),
-    power_module_(config.getPhysicalPortNumber(), config.getVirtualChannelNumber(), config.getFlitSize(), config.getLinkLength()),
+    power_module_(config.getPhysicalPortNumber(), config.getVirtualChannelNumber(), config.getFlitSize(), config.getLinkLength(), config.getPowerMode()),
+    own_state_(std::make_unique<RouterStateArena>(1, config.getPhysicalPortNumber(), config.getVirtualChannelNumber(), config.getInBufferSize())),
+    state_(own_state_->slice(0)),
     init_data_(),
     total_delay_(0),
+    injected_flits_(0),
+    accepted_flits_(0),
+    accepted_packets_(0),
     routing_alg_(config.getRoutingAlg()),
+    vc_requests_(config.getPhysicalPortNumber() * config.getVirtualChannelNumber()),
+    sw_requests_(config.getPhysicalPortNumber()),
+    vc_candidates_(),
+    sw_candidates_(),
     curr_algorithm(0),
     local_time_(LOCAL_INPUT_TIME_0),
     packet_counter_(0),
     router_list_(router_list)
 {
+    this->input_module_.bindState(this->state_);
+    this->output_module_.bindState(this->state_);
     this->init_data_.resize(this->flit_size_);
     for (long i = 0; i < this->flit_size_; i++) {
-        this->init_data_[i] = Global::RandomGen.random_u_long_long(0, MAX_64_);
+        this->init_data_[i] = Global::RandomGen().random_u_long_long(0, MAX_64_);
+    }
+    // Every input VC may request the same output, so the requests never grow past these.
+    long input_vcs = this->physic_ports_ * this->vc_number_;
+    for (auto& requests : this->vc_requests_) {
+        requests.reserve(input_vcs);
     }
+    for (auto& requests : this->sw_requests_) {
+        requests.reserve(this->physic_ports_);
+    }
+    this->vc_candidates_.reserve(input_vcs);
+    this->sw_candidates_.reserve(this->vc_number_);
     this->setRoutingType();
 }
+
+RGen& BaseRouter::random() {
+    return this->random_gen_ ? *this->random_gen_ : Global::RandomGen();
+}
+
+void BaseRouter::postEvent(MessEvent&& event) {
+    if (this->outbox_ != nullptr) {
+        this->outbox_->events.push_back(std::move(event));
+    }
+    else {
+        Global::messageQueue().addMessage(std::move(event));
+    }
+}
+
+void BaseRouter::seedRandom(unsigned long long seed) {
+    this->random_gen_ = std::make_unique<RGen>();
+    this->random_gen_->reset_stream(seed);
+}
+
+void BaseRouter::setOutbox(RouterOutbox* outbox) {
+    this->outbox_ = outbox;
+}
+
+void BaseRouter::bindState(RouterStateArena& arena, std::size_t index) {
+    RouterStateSlice state = arena.slice(index);
+    RouterStateArena::copy(this->state_, state, arena.sliceSize());
+    this->state_ = state;
+    this->input_module_.bindState(this->state_);
+    this->output_module_.bindState(this->state_);
+    this->own_state_.reset();
+}
@@ -1,32 +1,52 @@
+# include <algorithm>
+# include <bit>
+# include <numeric>
+# include <type_traits>
+
 # include "router/modules.h"
 
 /**
  * @brief Construct a new Input Modules object
  * @param phy_port_num the number of physical ports
  * @param vc_num the number of virtual channels
+ * @param buffer_size the size of input buffer
+ * @note The injection port is preallocated for `BUFF_BOUND_` flits and grows beyond that.
  */
-InputModules::InputModules(long phy_port_num, long vc_num)
-:  ibuff_full_(false)
+InputModules::InputModules(long phy_port_num, long vc_num, long buffer_size)
+:   phy_port_num_(phy_port_num),
+    vc_num_(vc_num),
+    state_(),
+    ibuff_full_(false),
+    flit_count_(0)
 {    
     this->input_.resize(phy_port_num);
     for (long i = 0; i < phy_port_num; i++) {
-        this->input_[i].resize(vc_num);
-    }
-    
-    this->states_.resize(phy_port_num);
-    for (long i = 0; i < phy_port_num; i++) {
-        this->states_[i].resize(vc_num, VCStateType::INIT);
+        this->input_[i].resize(vc_num, RingBuffer<FlitHandle>(i == 0 ? BUFF_BOUND_ : buffer_size));
     }
 
     this->routing_.resize(phy_port_num);
     for (long i = 0; i < phy_port_num; i++) {
         this->routing_[i].resize(vc_num);
     }
+}
 
-    this->crouting_.resize(phy_port_num);
-    for (long i = 0; i < phy_port_num; i++) {
-        this->crouting_[i].resize(vc_num, VC_NULL);
-    }
+/**
+ * @brief Use the state arrays of a `RouterStateArena`
+ * @param state the state of the router
+ */
+void InputModules::bindState(const RouterStateSlice& state) {
+    this->state_ = state;
+}
+
+/**
+ * @brief Get the index of a vc in the state arrays
+ * @param pc the physical port
+ * @param vc the virtual channel
+ */
+std::size_t InputModules::index(long pc, long vc) const {
+    Sassert(pc >= 0 && pc < this->phy_port_num_ && vc >= 0 && vc < this->vc_num_,
+        "Physical port or virtual channel out of range.");
+    return static_cast<std::size_t>(pc * this->vc_num_ + vc);
 }
 
 /**
@@ -58,6 +78,13 @@ std::size_t InputModules::getBufferSize(long pc, long vc) const {
     return this->input_.at(pc).at(vc).size();
 }
 
+/**
+ * @brief Get the number of flits in all input buffers
+ */
+std::size_t InputModules::getFlitCount() const {
+    return this->flit_count_;
+}
+
 /**
  * @brief set the state
  * @param pc the physical port
@@ -65,11 +92,7 @@ std::size_t InputModules::getBufferSize(long pc, long vc) const {
  * @param state the new state
  */
 void InputModules::setState(long pc, long vc, VCStateType state) {
-    try {
-        this->states_.at(pc).at(vc) = state;
-    } catch (const std::out_of_range& e) {
-        Sassert(false, e.what());
-    }
+    this->state_.states[this->index(pc, vc)] = state;
 }
 
 /**
@@ -79,23 +102,19 @@ void InputModules::setState(long pc, long vc, VCStateType state) {
  * @return the state
  */
 VCStateType InputModules::getState(long pc, long vc) const {
-    try {
-        return this->states_.at(pc).at(vc);
-    } catch (const std::out_of_range& e) {
-        Sassert(false, e.what());
-    }
-    return this->states_.at(pc).at(vc);
+    return this->state_.states[this->index(pc, vc)];
 }
 
 /**
  * @brief add a flit
  * @param pc the physical port
  * @param vc the virtual channel
- * @param flit the flit
+ * @param flit the handle of the flit
  */
-void InputModules::addFlit(long pc, long vc, const Flit& flit) {
+void InputModules::addFlit(long pc, long vc, FlitHandle flit) {
     try {
         this->input_.at(pc).at(vc).push_back(flit);
+        this->flit_count_ += 1;
     } catch (const std::out_of_range& e) {
         Sassert(false, e.what());
     }
@@ -105,9 +124,9 @@ void InputModules::addFlit(long pc, long vc, const Flit& flit) {
  * @brief Get the flit
  * @param pc the physical port
  * @param vc the virtual channel
- * @return the flit
+ * @return the handle of the flit in `Global::flitPool()`
  */
-Flit& InputModules::getFlit(long pc, long vc) {
+FlitHandle InputModules::getFlit(long pc, long vc) const {
     try {
         return this->input_.at(pc).at(vc).front();
     } catch (const std::out_of_range& e) {
@@ -125,6 +144,7 @@ Flit& InputModules::getFlit(long pc, long vc) {
 void InputModules::removeFlit(long pc, long vc) {
     try {
         this->input_.at(pc).at(vc).pop_front();
+        this->flit_count_ -= 1;
     } catch (const std::out_of_range& e) {
         Sassert(false, e.what());
     }
@@ -179,11 +199,7 @@ void InputModules::clearRouting(long pc, long vc) {
  * @param vc_type the virtual channel type
  */
 void InputModules::setCRouting(long pc, long vc, VCType vc_type) {
-    try {
-        this->crouting_.at(pc).at(vc) = vc_type;
-    } catch (const std::out_of_range& e) {
-        Sassert(false, e.what());
-    }
+    this->state_.crouting[this->index(pc, vc)] = vc_type;
 }
 
 /**
@@ -192,12 +208,7 @@ void InputModules::setCRouting(long pc, long vc, VCType vc_type) {
  * @param vc the virtual channel
  */
 VCType InputModules::getCRouting(long pc, long vc) {
-    try {
-        return this->crouting_.at(pc).at(vc);
-    } catch (const std::out_of_range& e) {
-        Sassert(false, e.what());
-    }
-    return this->crouting_.at(pc).at(vc);
+    return this->state_.crouting[this->index(pc, vc)];
 }
 
 /**
@@ -208,27 +219,36 @@ VCType InputModules::getCRouting(long pc, long vc) {
  * @param output_buffer_size the size of output buffer
  */
 OutputModules::OutputModules(long phy_port_num, long vc_num, long input_buffer_size, long output_buffer_size)
-:   buffer_size_(input_buffer_size)
+:   buffer_size_(input_buffer_size),
+    phy_port_num_(phy_port_num),
+    vc_num_(vc_num),
+    state_(),
+    flit_count_(0)
 {    
-    this->counter_.resize(phy_port_num);
-    for (long i = 0; i < phy_port_num; i++) {
-        this->counter_[i].resize(vc_num, input_buffer_size);
-    }
-
     this->localcounter_.resize(phy_port_num, output_buffer_size);
-	this->assign_.resize(phy_port_num);
-	for (long i = 0; i < phy_port_num; i++) {
-		this->assign_[i].resize(vc_num, VC_NULL);
-	}
-	
-    this->usage_.resize(phy_port_num);
-	for (long i = 0; i < phy_port_num; i++) {
-		this->usage_[i].resize(vc_num, VCUsageType::FREE);
-	}
 	
-    this->outbuffers_.resize(phy_port_num);
+    this->outbuffers_.resize(phy_port_num, RingBuffer<FlitHandle>(output_buffer_size));
 	this->flit_state_.resize(phy_port_num);
-	this->outadd_.resize(phy_port_num);
+	this->outadd_.resize(phy_port_num, RingBuffer<VCType>(output_buffer_size));
+}
+
+/**
+ * @brief Use the state arrays of a `RouterStateArena`
+ * @param state the state of the router
+ */
+void OutputModules::bindState(const RouterStateSlice& state) {
+    this->state_ = state;
+}
+
+/**
+ * @brief Get the index of a vc in the state arrays
+ * @param phy_port the physical port
+ * @param vc the virtual channel
+ */
+std::size_t OutputModules::index(long phy_port, long vc) const {
+    Sassert(phy_port >= 0 && phy_port < this->phy_port_num_ && vc >= 0 && vc < this->vc_num_,
+        "Physical port or virtual channel out of range.");
+    return static_cast<std::size_t>(phy_port * this->vc_num_ + vc);
 }
 
 /**
@@ -237,11 +257,7 @@ OutputModules::OutputModules(long phy_port_num, long vc_num, long input_buffer_s
  * @param vc the virtual channel
  */
 void OutputModules::incCounter(long phy_port, long vc) {
-    try {
-        this->counter_.at(phy_port).at(vc) += 1;
-    } catch (const std::out_of_range& e) {
-        Sassert(false, e.what());
-    }
+    this->state_.counter[this->index(phy_port, vc)] += 1;
 }
 
 /**
@@ -250,11 +266,7 @@ void OutputModules::incCounter(long phy_port, long vc) {
  * @param vc the virtual channel
  */
 void OutputModules::decCounter(long phy_port, long vc) {
-    try {
-        this->counter_.at(phy_port).at(vc) -= 1;
-    } catch (const std::out_of_range& e) {
-        Sassert(false, e.what());
-    }
+    this->state_.counter[this->index(phy_port, vc)] -= 1;
 }
 
 /**
@@ -264,12 +276,7 @@ void OutputModules::decCounter(long phy_port, long vc) {
  * @return the counter
  */
 long OutputModules::getCounter(long phy_port, long vc) {
-    try {
-        return this->counter_.at(phy_port).at(vc);
-    } catch (const std::out_of_range& e) {
-        Sassert(false, e.what());
-    }
-    return this->counter_.at(phy_port).at(vc);
+    return this->state_.counter[this->index(phy_port, vc)];
 }
 
 /**
@@ -293,12 +300,7 @@ long OutputModules::getLocalCounter(long phy_port) {
  * @return the usage
  */
 VCUsageType OutputModules::getUsage(long phy_port, long vc) {
-    try {
-        return this->usage_.at(phy_port).at(vc);
-    } catch (const std::out_of_range& e) {
-        Sassert(false, e.what());
-    }
-    return this->usage_.at(phy_port).at(vc);
+    return this->state_.usage[this->index(phy_port, vc)];
 }
 
 /**
@@ -308,12 +310,9 @@ VCUsageType OutputModules::getUsage(long phy_port, long vc) {
  * @param vc_type the vc_type
  */
 void OutputModules::acquireChannel(long phy_port, long vc, VCType vc_type) {
-    try {
-        this->usage_.at(phy_port).at(vc) = VCUsageType::USED;
-        this->assign_.at(phy_port).at(vc) = vc_type;
-    } catch (const std::out_of_range& e) {
-        Sassert(false, e.what());
-    }
+    std::size_t idx = this->index(phy_port, vc);
+    this->state_.usage[idx] = VCUsageType::USED;
+    this->state_.assign[idx] = vc_type;
 }
 
 /**
@@ -322,12 +321,9 @@ void OutputModules::acquireChannel(long phy_port, long vc, VCType vc_type) {
  * @param vc the virtual channel
  */
 void OutputModules::releaseChannel(long phy_port, long vc) {
-    try {
-        this->usage_.at(phy_port).at(vc) = VCUsageType::FREE;
-        this->assign_.at(phy_port).at(vc) = VC_NULL;
-    } catch (const std::out_of_range& e) {
-        Sassert(false, e.what());
-    }
+    std::size_t idx = this->index(phy_port, vc);
+    this->state_.usage[idx] = VCUsageType::FREE;
+    this->state_.assign[idx] = VC_NULL;
 }
 
 /**
@@ -344,14 +340,22 @@ std::size_t OutputModules::getOutBufferSize(long port) {
     return this->outbuffers_.at(port).size();
 }
 
+/**
+ * @brief Get the number of flits in all output buffers
+ */
+std::size_t OutputModules::getFlitCount() const {
+    return this->flit_count_;
+}
+
 /**
  * @brief Add a flit
  * @param port the physical port
- * @param flit the flit
+ * @param flit the handle of the flit
  */
-void OutputModules::addFlit(long port, const Flit& flit) {
+void OutputModules::addFlit(long port, FlitHandle flit) {
     try {
         this->outbuffers_.at(port).push_back(flit);
+        this->flit_count_ += 1;
         this->localcounter_.at(port) -= 1;
     } catch (const std::out_of_range& e) {
         Sassert(false, e.what());
@@ -361,9 +365,9 @@ void OutputModules::addFlit(long port, const Flit& flit) {
 /**
  * @brief Get the flit
  * @param port the port
- * @return the flit
+ * @return the handle of the flit in `Global::flitPool()`
  */
-Flit& OutputModules::getFlit(long port) {
+FlitHandle OutputModules::getFlit(long port) const {
     try {
         return this->outbuffers_.at(port).front();
     } catch (const std::out_of_range& e) {
@@ -379,6 +383,7 @@ Flit& OutputModules::getFlit(long port) {
 void OutputModules::removeFlit(long port) {
     try {
         this->outbuffers_.at(port).pop_front();
+        this->flit_count_ -= 1;
         this->localcounter_.at(port) += 1;
     } catch (const std::out_of_range& e) {
         Sassert(false, e.what());
@@ -424,30 +429,67 @@ void OutputModules::removeAddr(long port) {
     }
 }
 
+static_assert(PARM(flit_width) == 2 * ATOM_WIDTH_, "A buffer write should cover the old and the new atom.");
+static_assert(HAMM_MASK(8) == BIGNONE, "The byte mask of Orion should keep the whole word.");
+
+// the number of bits a signed byte is extended to before Orion masks it
+static constexpr LIB_Type_max_uint SIGN_WIDTH = sizeof(LIB_Type_max_uint) * 8 - 7;
+
+/**
+ * @brief Count the bits Orion records as switched when it compares two atoms byte by byte
+ * @note The bytes are passed as `char`s, so a signed byte is extended before `HAMM_MASK(8)` is applied
+ *  and its top bit counts once for every bit above the low seven.
+ */
+static LIB_Type_max_uint byteHamming(AtomType old_d, AtomType new_d) {
+	AtomType diff = old_d ^ new_d;
+	if constexpr (std::is_signed_v<char>) {
+		return std::popcount(diff & 0x7f7f7f7f7f7f7f7fULL) + SIGN_WIDTH * std::popcount(diff & 0x8080808080808080ULL);
+	} else {
+		return std::popcount(diff);
+	}
+}
+
 /**
  * @brief Construct a new Power Modules object
  * @param phy_port_num the number of physical ports
  * @param vc_num the number of virtual ports
  * @param flit_size the size of flit
  * @param link_length the length of link
+ * @param mode how the power is modelled
  */
-PowerModules::PowerModules(long phy_port_num, long vc_num, long flit_size, long link_length)
-:   flit_size_(flit_size)
+PowerModules::PowerModules(long phy_port_num, long vc_num, long flit_size, long link_length, PowerModeType mode)
+:   flit_size_(flit_size),
+	mode_(mode),
+	buffer_read_count_(0),
+	buffer_read_ones_(0),
+	buffer_write_count_(0),
+	buffer_write_switch_(0),
+	crossbar_in_switch_(0),
+	crossbar_out_switch_(0),
+	crossbar_ctr_switch_(0),
+	link_switch_(phy_port_num, 0)
 {
     FUNC(SIM_router_power_init, &this->router_info_, &this->router_power_);
-	this->buffer_write_.resize(phy_port_num);
-	this->buffer_read_.resize(phy_port_num);
-	this->crossbar_read_.resize(phy_port_num);
-	this->crossbar_write_.resize(phy_port_num);
-	this->link_traversal_.resize(phy_port_num);
-	this->crossbar_input_.resize(phy_port_num, 0);
-	for (long i = 0; i < phy_port_num; i++) {
-		this->buffer_write_[i].resize(flit_size, 0);
-		this->buffer_read_[i].resize(flit_size, 0);
-		this->crossbar_read_[i].resize(flit_size, 0);
-		this->crossbar_write_[i].resize(flit_size, 0);
-		this->link_traversal_[i].resize(flit_size, 0);
+	// Orion dereferences the missing port state of a buffer access with a row decoder.
+	Sassert(this->router_info_.in_buf_info.row_dec_model == SIM_NO_MODEL,
+		"The input buffer should not have a row decoder");
+	Sassert(this->router_info_.in_buf_info.n_set != 1 || this->router_info_.in_buf_info.assoc <= 1,
+		"The input buffer should not be fully associative");
+	if (mode == PowerModeType::FULL) {
+		this->buffer_write_.resize(phy_port_num);
+		this->buffer_read_.resize(phy_port_num);
+		this->crossbar_read_.resize(phy_port_num);
+		this->crossbar_write_.resize(phy_port_num);
+		this->link_traversal_.resize(phy_port_num);
+		for (long i = 0; i < phy_port_num; i++) {
+			this->buffer_write_[i].resize(flit_size, 0);
+			this->buffer_read_[i].resize(flit_size, 0);
+			this->crossbar_read_[i].resize(flit_size, 0);
+			this->crossbar_write_[i].resize(flit_size, 0);
+			this->link_traversal_[i].resize(flit_size, 0);
+		}
 	}
+	this->crossbar_input_.resize(phy_port_num, 0);
 	SIM_arbiter_init(&this->arbiter_vc_power_, 1, 1, phy_port_num * vc_num, 0, NULL);
 	this->arbiter_vc_req_.resize(phy_port_num);
 	this->arbiter_vc_grant_.resize(phy_port_num);
@@ -456,59 +498,82 @@ PowerModules::PowerModules(long phy_port_num, long vc_num, long flit_size, long
 		this->arbiter_vc_grant_[i].resize(vc_num, 1);
 	}
 	SIM_bus_init(&this->link_power_, GENERIC_BUS, IDENT_ENC, ATOM_WIDTH_, 0, 1, 1, link_length, 0);
+
+	// Every bit of a random payload switches with probability 0.5, as Orion assumes for its average energies.
+	LIB_Type_max_uint read_mask = HAMM_MASK(this->router_info_.in_buf_info.eff_data_cols);
+	this->flit_read_ones_ = flit_size * std::popcount(read_mask) / 2;
+	this->flit_write_switch_ = flit_size * (std::is_signed_v<char> ? 4 * (7 + SIGN_WIDTH) : ATOM_WIDTH_ / 2);
+	this->flit_crossbar_switch_ = flit_size * std::popcount(this->router_power_.crossbar.mask) / 2;
+	this->flit_link_switch_ = flit_size * std::popcount(this->link_power_.bus_mask) / 2;
 }
 
 void PowerModules::addBufferReadPwr(long in_port, DataType& read_d) {
-    for (long i = 0; i < this->flit_size_; i++) {
-		FUNC(SIM_buf_power_data_read, 
-            &this->router_info_.in_buf_info, 
-            &this->router_power_.in_buf,
-            read_d[i]
-        );
-		this->buffer_read_[in_port][i] = read_d[i];
+	if (this->mode_ == PowerModeType::OFF) {
+		return;
+	}
+	this->buffer_read_count_ += this->flit_size_;
+	// Only a single-ended bitline depends on the data, it discharges for every one read.
+	if (this->router_info_.in_buf_info.data_end == 1) {
+		if (this->mode_ == PowerModeType::ACTIVITY) {
+			this->buffer_read_ones_ += this->flit_read_ones_;
+		}
+		else {
+			LIB_Type_max_uint mask = HAMM_MASK(this->router_info_.in_buf_info.eff_data_cols);
+			for (long i = 0; i < this->flit_size_; i++) {
+				this->buffer_read_ones_ += std::popcount(read_d[i] & mask);
+			}
+		}
+	}
+	if (this->mode_ == PowerModeType::FULL) {
+		std::copy_n(read_d.begin(), this->flit_size_, this->buffer_read_[in_port].begin());
 	}
 }
 
 void PowerModules::addBufferWritePwr(long in_port, DataType& write_d) {
-    
+	if (this->mode_ == PowerModeType::OFF) {
+		return;
+	}
+	this->buffer_write_count_ += this->flit_size_;
+	if (this->mode_ == PowerModeType::ACTIVITY) {
+		this->buffer_write_switch_ += this->flit_write_switch_;
+		return;
+	}
+	DataType& old_d = this->buffer_write_[in_port];
 	for (long i = 0; i < this->flit_size_; i++) {
-		VOLA AtomType ata[4] = {0};
-		VOLA AtomType& old_d = ata[0];
-		VOLA AtomType& new_d = ata[1];
-		VOLA AtomType& old_d2 = ata[2];
-		VOLA AtomType& new_d2 = ata[3];
-		old_d = this->buffer_write_[in_port][i];
-		new_d = write_d[i];
-		old_d2 = this->buffer_write_[in_port][i];
-		new_d2 = write_d[i];
-
-		FUNC(SIM_buf_power_data_write,
-            &this->router_info_.in_buf_info,
-			&this->router_power_.in_buf,
-            (char *)(&old_d),
-            (char *)(&old_d),
-            (char *)(&new_d));
-
-		this->buffer_write_[in_port][i] = write_d[i];
+		this->buffer_write_switch_ += byteHamming(old_d[i], write_d[i]);
 	}
+	std::copy_n(write_d.begin(), this->flit_size_, old_d.begin());
 }
 
 void PowerModules::addCrossbarTravPwr(long in_port, long out_port, DataType& trav_d) {
-    for (long i = 0; i < this->flit_size_; i++) {
-		SIM_crossbar_record(&this->router_power_.crossbar, 1,
-            trav_d[i], this->crossbar_read_[in_port][i], 1, 1);
-		
-        SIM_crossbar_record(&this->router_power_.crossbar, 0,
-            trav_d[i], this->crossbar_write_[out_port][i],
-            this->crossbar_input_[out_port], in_port);
-
-		this->crossbar_read_[in_port][i] = trav_d[i];
-		this->crossbar_write_[out_port][i] = trav_d[i];
-		this->crossbar_input_[out_port] = in_port;
+	if (this->mode_ == PowerModeType::OFF) {
+		return;
+	}
+	// The control lines switch with the first atom of a flit from another input.
+	if (this->flit_size_ > 0 && this->crossbar_input_[out_port] != in_port) {
+		this->crossbar_ctr_switch_++;
 	}
+	this->crossbar_input_[out_port] = in_port;
+	if (this->mode_ == PowerModeType::ACTIVITY) {
+		this->crossbar_in_switch_ += this->flit_crossbar_switch_;
+		this->crossbar_out_switch_ += this->flit_crossbar_switch_;
+		return;
+	}
+	LIB_Type_max_uint mask = this->router_power_.crossbar.mask;
+	DataType& in_d = this->crossbar_read_[in_port];
+	DataType& out_d = this->crossbar_write_[out_port];
+	for (long i = 0; i < this->flit_size_; i++) {
+		this->crossbar_in_switch_ += std::popcount((trav_d[i] ^ in_d[i]) & mask);
+		this->crossbar_out_switch_ += std::popcount((trav_d[i] ^ out_d[i]) & mask);
+	}
+	std::copy_n(trav_d.begin(), this->flit_size_, in_d.begin());
+	std::copy_n(trav_d.begin(), this->flit_size_, out_d.begin());
 }
 
 void PowerModules::addVCArbitPwr(long pc, long vc, AtomType req, unsigned long gra) {
+	if (this->mode_ == PowerModeType::OFF) {
+		return;
+	}
     SIM_arbiter_record(&this->arbiter_vc_power_, req, this->arbiter_vc_req_[pc][vc],
         gra, this->arbiter_vc_grant_[pc][vc]);
 	this->arbiter_vc_req_[pc][vc] = req;
@@ -516,24 +581,102 @@ void PowerModules::addVCArbitPwr(long pc, long vc, AtomType req, unsigned long g
 }
 
 void PowerModules::addLinkTravPwr(long in_port, DataType& read_d) {
-    for (long i = 0; i < this->flit_size_; i++) {
-		AtomType old_d = this->link_traversal_[in_port][i];
-		AtomType new_d = read_d[i];
-		SIM_bus_record(&this->link_power_, old_d, new_d);
-		this->link_traversal_[in_port][i] = read_d[i];
+	if (this->mode_ == PowerModeType::OFF) {
+		return;
+	}
+	if (this->mode_ == PowerModeType::ACTIVITY) {
+		this->link_switch_[in_port] += this->flit_link_switch_;
+		return;
+	}
+	LIB_Type_max_uint mask = this->link_power_.bus_mask;
+	DataType& old_d = this->link_traversal_[in_port];
+	for (long i = 0; i < this->flit_size_; i++) {
+		this->link_switch_[in_port] += std::popcount((read_d[i] ^ old_d[i]) & mask);
+	}
+	std::copy_n(read_d.begin(), this->flit_size_, old_d.begin());
+}
+
+/**
+ * @note This repeats what `SIM_buf_power_data_read` and `SIM_buf_power_data_write` record for every atom.
+ *  A write passes Orion the old, the new and the old atom again as the data line, the old data and the new
+ *  data. With separate read and write bitlines, the data line is updated before the memory cells are
+ *  compared, so the bitlines switch twice and the cells once for every bit switched, and the other way
+ *  round with shared bitlines.
+ */
+void PowerModules::foldBufferActivity() {
+	SIM_power_array_info_t& info = this->router_info_.in_buf_info;
+	SIM_power_array_t& arr = this->router_power_.in_buf;
+
+	LIB_Type_max_uint reads = this->buffer_read_count_;
+	arr.data_bitline_pre.n_charge += reads * info.blk_bits;
+	arr.data_wordline.n_read += reads * info.data_ndwl;
+	if (info.tag_mem_model) {
+		arr.tag_wordline.n_read += reads * info.tag_ndwl;
+	}
+	if (info.data_end == 1) {
+		arr.data_bitline.n_col_read += this->buffer_read_ones_;
+	} else {
+		arr.data_bitline.n_col_read += reads * info.eff_data_cols;
+		arr.data_amp.n_access += reads * info.eff_data_cols;
 	}
+
+	LIB_Type_max_uint writes = this->buffer_write_count_;
+	arr.data_wordline.n_write += writes * info.data_ndwl;
+	if (info.tag_mem_model) {
+		arr.tag_wordline.n_write += writes * info.tag_ndwl;
+	}
+	if (info.share_rw) {
+		arr.data_bitline.n_col_write += writes * info.eff_data_cols;
+		if (info.assoc == 1 && info.data_ndbl > 1) {
+			arr.data_bitline.n_col_write += writes * PARM(flit_width) * (info.data_ndbl - 1);
+		}
+		arr.data_mem.n_switch += 2 * this->buffer_write_switch_;
+	} else {
+		arr.data_bitline.n_col_write += 2 * this->buffer_write_switch_;
+		arr.data_mem.n_switch += this->buffer_write_switch_;
+	}
+
+	this->buffer_read_count_ = 0;
+	this->buffer_read_ones_ = 0;
+	this->buffer_write_count_ = 0;
+	this->buffer_write_switch_ = 0;
+}
+
+void PowerModules::foldCrossbarActivity() {
+	SIM_power_crossbar_t& crossbar = this->router_power_.crossbar;
+	// Only the matrix crossbar records its activity.
+	if (crossbar.model == MATRIX_CROSSBAR) {
+		crossbar.n_chg_in += this->crossbar_in_switch_;
+		crossbar.n_chg_out += this->crossbar_out_switch_;
+		crossbar.n_chg_ctr += this->crossbar_ctr_switch_;
+	}
+	this->crossbar_in_switch_ = 0;
+	this->crossbar_out_switch_ = 0;
+	this->crossbar_ctr_switch_ = 0;
+}
+
+void PowerModules::foldLinkActivity() {
+	// Nothing else records to the bus, so its counter is the sum of the ports.
+	this->link_power_.n_switch = std::accumulate(this->link_switch_.begin(), this->link_switch_.end(), LIB_Type_max_uint(0));
 }
 
 double PowerModules::getBufferPower() {
+	this->foldBufferActivity();
     return SIM_array_power_report(&this->router_info_.in_buf_info,
         &this->router_power_.in_buf);
 }
 
 double PowerModules::getLinkPower() {
+	this->foldLinkActivity();
     return SIM_bus_report(&this->link_power_);
 }
 
+double PowerModules::getLinkPower(long port) {
+	return this->link_switch_[port] * this->link_power_.e_switch;
+}
+
 double PowerModules::getCrossbarPower() {
+	this->foldCrossbarActivity();
     return SIM_crossbar_report(&this->router_power_.crossbar);
 }
 
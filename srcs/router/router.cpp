@@ -25,9 +25,11 @@ long CXYRouter::getFromPort(long port) {
     return this->getFromPort_mesh(port);
 }
 
-CXYRouter::CXYRouter(const Config& config, AddrType addr, std::vector<BaseRouter *>& router_list_)
-:   BaseRouter(config, addr, router_list_)
-{}
+CXYRouter::CXYRouter(const Config& config, RouterId id, std::vector<BaseRouter *>& router_list_)
+:   BaseRouter(config, id, router_list_)
+{
+    this->linkNeighbours();
+}
 
 void CTXYRouter::routingAlg(const AddrType& dst, const AddrType& src, long s_ph, long s_vc) {
     this->TXY_algorithm(dst, src, s_ph, s_vc);
@@ -53,9 +55,11 @@ long CTXYRouter::getFromPort(long port) {
     return this->getFromPort_mesh(port);
 }
 	
-CTXYRouter::CTXYRouter(const Config& config, AddrType addr, std::vector<BaseRouter *>& router_list_)
-:   BaseRouter(config, addr, router_list_)
-{}
+CTXYRouter::CTXYRouter(const Config& config, RouterId id, std::vector<BaseRouter *>& router_list_)
+:   BaseRouter(config, id, router_list_)
+{
+    this->linkNeighbours();
+}
 
 void CChipletMeshRouter::routingAlg(const AddrType& dst, const AddrType& src, long s_ph, long s_vc) {
     this->chiplet_routing_alg(dst, src, s_ph, s_vc);
@@ -81,9 +85,11 @@ long CChipletMeshRouter::getFromPort(long port) {
     return this->getFromPort_mesh(port);
 }
 
-CChipletMeshRouter::CChipletMeshRouter(const Config& config, AddrType addr, std::vector<BaseRouter *>& router_list_)
-:   BaseRouter(config, addr, router_list_)
-{}
+CChipletMeshRouter::CChipletMeshRouter(const Config& config, RouterId id, std::vector<BaseRouter *>& router_list_)
+:   BaseRouter(config, id, router_list_)
+{
+    this->linkNeighbours();
+}
 
 void CChipletStarRouter::routingAlg(const AddrType& dst, const AddrType& src, long s_ph, long s_vc) {
     this->chiplet_star_topo_routing_alg(dst, src, s_ph, s_vc);
@@ -109,6 +115,8 @@ long CChipletStarRouter::getFromPort(long port) {
     return this->getFromPort_chipletStar(port);
 }
 
-CChipletStarRouter::CChipletStarRouter(const Config& config, AddrType addr, std::vector<BaseRouter *>& router_list_)
-:   BaseRouter(config, addr, router_list_)
-{}
\ No newline at end of file
+CChipletStarRouter::CChipletStarRouter(const Config& config, RouterId id, std::vector<BaseRouter *>& router_list_)
+:   BaseRouter(config, id, router_list_)
+{
+    this->linkNeighbours();
+}
\ No newline at end of file
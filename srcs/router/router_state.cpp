@@ -0,0 +1,39 @@
+# include <algorithm>
+
+# include "router/router_state.h"
+# include "global_defines/SStd.h"
+
+
+RouterStateArena::RouterStateArena(std::size_t router_num, long phy_port_num, long vc_num, long input_buffer_size)
+:   phy_port_num_(phy_port_num),
+    vc_num_(vc_num),
+    states_(router_num * phy_port_num * vc_num, VCStateType::INIT),
+    crouting_(router_num * phy_port_num * vc_num, VC_NULL),
+    counter_(router_num * phy_port_num * vc_num, input_buffer_size),
+    usage_(router_num * phy_port_num * vc_num, VCUsageType::FREE),
+    assign_(router_num * phy_port_num * vc_num, VC_NULL)
+{}
+
+RouterStateSlice RouterStateArena::slice(std::size_t router) {
+    std::size_t offset = router * this->sliceSize();
+    Sassert(offset < this->states_.size(), "Router index out of range.");
+    RouterStateSlice ret;
+    ret.states = this->states_.data() + offset;
+    ret.crouting = this->crouting_.data() + offset;
+    ret.counter = this->counter_.data() + offset;
+    ret.usage = this->usage_.data() + offset;
+    ret.assign = this->assign_.data() + offset;
+    return ret;
+}
+
+std::size_t RouterStateArena::sliceSize() const {
+    return static_cast<std::size_t>(this->phy_port_num_ * this->vc_num_);
+}
+
+void RouterStateArena::copy(const RouterStateSlice& from, const RouterStateSlice& to, std::size_t size) {
+    std::copy(from.states, from.states + size, to.states);
+    std::copy(from.crouting, from.crouting + size, to.crouting);
+    std::copy(from.counter, from.counter + size, to.counter);
+    std::copy(from.usage, from.usage + size, to.usage);
+    std::copy(from.assign, from.assign + size, to.assign);
+}
@@ -1,5 +1,20 @@
 # include "router/topo_router.h"
 
+/**
+ * @brief Map the neighbours of every router to the ports leading to them
+ * @note A neighbour linked twice is reached through its last port.
+ */
+static void setNextHopPortMap(const ShortestPath::TPortMap& portMap, TAddressNumber vertexCnt,
+    std::unique_ptr<std::unordered_map<TAddressNumber, TAddressNumber>[]>& nextHop_port_map)
+{
+	nextHop_port_map = std::make_unique<std::unordered_map<TAddressNumber, TAddressNumber>[]>(vertexCnt);
+	for (TAddressNumber i = 0; i < vertexCnt; i++) {
+		for (std::size_t port = 0; port < portMap[i].size(); port++) {
+			nextHop_port_map[i][portMap[i][port].neighbour] = port;
+		}
+	}
+}
+
 void TopoInfo::readTopo(const std::string& topo_file_path) {
     Sassert(readGvGraph(topo_file_path, this->topo0), "Read topo failed.");
 	GraphLib::resetIndex(this->topo0);
@@ -9,7 +24,7 @@ void TopoInfo::setPipelineDelay() {
     auto nodes = boost::vertices(this->topo0);
 	auto pipelineStageDelay = boost::get(&GraphLib::vertex_info::pipelineStageDelay, this->topo0);
 	std::for_each(nodes.first, nodes.second, [&](const GraphLib::vertex_t& v) {
-		Global::RoutingPeriods.insert(pipelineStageDelay[v]);
+		Global::RoutingPeriods().insert(pipelineStageDelay[v]);
 	});
 }
 	
@@ -37,7 +52,12 @@ void TopoInfo::setTopoVertices() {
 	});
 }
 	
-void TopoInfo::calRoutingTable() {
+void TopoInfo::calRoutingTable(const RoutingCache& cache, std::uint64_t key) {
+    if (cache.load(key, this->vertexCnt, this->delayTable, this->energyTable, this->routingTable, this->portMap)) {
+		setNextHopPortMap(this->portMap, this->vertexCnt, this->nextHop_port_map);
+		return;
+	}
+
     ShortestPath::TMatrix index_delayTable;
     ShortestPath::TMatrix index_energyTable;
 	ShortestPath::TIntMatrix index_routingTable;
@@ -71,9 +91,7 @@ void TopoInfo::calRoutingTable() {
 	}
 
 	this->portMap = std::make_unique<std::vector<SLinkInfo>[]>(this->vertexCnt);
-	this->nextHop_port_map = std::make_unique<std::unordered_map<TAddressNumber, TAddressNumber>[]>(this->vertexCnt);
 	for (TAddressNumber i = 0; i < this->vertexCnt; i++) {
-		this->nextHop_port_map[i][i] = 0;
 		this->portMap[i].push_back({0, 0, i});
 	}
 	
@@ -89,25 +107,26 @@ void TopoInfo::calRoutingTable() {
         TAddressNumber q = this->portMap[add2].size();
 		this->portMap[add1].push_back({q, d, add2});
 		this->portMap[add2].push_back({p, d, add1});
-		this->nextHop_port_map[add1][add2] = p;
-		this->nextHop_port_map[add2][add1] = q;
 	});
+	setNextHopPortMap(this->portMap, this->vertexCnt, this->nextHop_port_map);
+	cache.store(key, this->vertexCnt, this->delayTable, this->energyTable, this->routingTable, this->portMap);
 }
 
-TopoInfo::TopoInfo(const std::string& topo_file_path) {
+TopoInfo::TopoInfo(const std::string& topo_file_path, const std::string& routing_cache_dir) {
     this->readTopo(topo_file_path);
 	this->otherInit();
 	this->setPipelineDelay();
 	this->setPortCnt();
 	this->setTopoVertices();
-	this->calRoutingTable();
+	RoutingCache cache(routing_cache_dir);
+	this->calRoutingTable(cache, cache.isEnabled() ? RoutingCache::getTopologyKey(topo_file_path) : 0);
 }
 
 void CGraphTopo::routingAlg(const AddrType& dst, const AddrType& src, long s_ph, long s_vc) {
-    TAddressNumber nextAdd = this->topo_info.routingTable[this->address_.front()][dst.front()];
-	auto it = this->topo_info.nextHop_port_map[this->address_.front()].find(nextAdd);
-	if (it == this->topo_info.nextHop_port_map[this->address_.front()].end()) {
-        Logger::error("Routing error: dst {} in {} next: {}", dst.front(), this->address_.front(), nextAdd);
+    TAddressNumber nextAdd = this->topo_info.routingTable[this->id_][dst.front()];
+	auto it = this->topo_info.nextHop_port_map[this->id_].find(nextAdd);
+	if (it == this->topo_info.nextHop_port_map[this->id_].end()) {
+        Logger::error("Routing error: dst {} in {} next: {}", dst.front(), this->id_, nextAdd);
 		Sassert(false, "Routing error.");
 	}
 	TAddressNumber port = it->second;
@@ -117,33 +136,45 @@ void CGraphTopo::routingAlg(const AddrType& dst, const AddrType& src, long s_ph,
 }
 
 TimeType CGraphTopo::getWireDelay(long port) {
-    return this->topo_info.portMap[this->address_.front()][port].linkDelay;
+    return this->topo_info.portMap[this->id_][port].linkDelay;
 }
 
 void CGraphTopo::getNextAddress(AddrType& next_addr, long port) {
     next_addr.clear();
-    next_addr.push_back(this->topo_info.portMap[this->address_.front()][port].neighbour);
+    next_addr.push_back(this->topo_info.portMap[this->id_][port].neighbour);
+}
+
+RouterId CGraphTopo::getNextRouterId(long port) {
+    return this->topo_info.portMap[this->id_][port].neighbour;
 }
 
 long CGraphTopo::getWirePc(long port) {
-    return this->topo_info.portMap[this->address_.front()][port].neighbourPort;
+    return this->topo_info.portMap[this->id_][port].neighbourPort;
 }
 
 void CGraphTopo::getFromRouter(AddrType& from, long port) {
     from.clear();
-    from.push_back(this->topo_info.portMap[this->address_.front()][port].neighbour);
+    from.push_back(this->topo_info.portMap[this->id_][port].neighbour);
+}
+
+RouterId CGraphTopo::getFromRouterId(long port) {
+    return this->topo_info.portMap[this->id_][port].neighbour;
 }
 
 long CGraphTopo::getFromPort(long port) {
-    return this->topo_info.portMap[this->address_.front()][port].neighbourPort;
+    return this->topo_info.portMap[this->id_][port].neighbourPort;
+}
+
+long CGraphTopo::getPortNumber() const {
+    return this->topo_info.portMap[this->id_].size();
 }
 
 TimeType CGraphTopo::pipelineStageDelay() {
-    return this->topo_info.topo0[this->topo_info.topoVertices[this->address_.front()]].pipelineStageDelay;
+    return this->topo_info.topo0[this->topo_info.topoVertices[this->id_]].pipelineStageDelay;
 }
 
-CGraphTopo::CGraphTopo(const Config& config, AddrType addr, std::vector<BaseRouter *>& router_list_, TopoInfo& topo_info)
-:   BaseRouter(config, addr, router_list_),
+CGraphTopo::CGraphTopo(const Config& config, RouterId id, std::vector<BaseRouter *>& router_list_, TopoInfo& topo_info)
+:   BaseRouter(config, id, router_list_),
     topo_info(topo_info)
 {}
 
@@ -156,7 +187,7 @@ void ReconfigTopoInfo::setPipelineDelay(GraphLib::graph_t& topo) {
     auto nodes = boost::vertices(topo);
 	auto pipelineStageDelay = boost::get(&GraphLib::vertex_info::pipelineStageDelay, this->topo0);
 	std::for_each(nodes.first, nodes.second, [&](const GraphLib::vertex_t& v) {
-		Global::RoutingPeriods.insert(pipelineStageDelay[v]);
+		Global::RoutingPeriods().insert(pipelineStageDelay[v]);
 	});
 }
 	
@@ -184,11 +215,34 @@ void ReconfigTopoInfo::setTopoVertices(GraphLib::graph_t& topo) {
 	});
 }
 	
-void ReconfigTopoInfo::calRoutingTable(GraphLib::graph_t& topo) {
+void ReconfigTopoInfo::calIndexTables(GraphLib::graph_t& topo, ShortestPath::TMatrix& index_delayTable,
+    ShortestPath::TMatrix& index_energyTable, ShortestPath::TIntMatrix& index_routingTable)
+{
+    if (this->index_routingTable0.num_elements() == 0) {
+		ShortestPath::calculateShortestPathTables(this->topo0,
+			this->index_delayTable0, this->index_energyTable0, this->index_routingTable0);
+	}
+	index_delayTable.resize(boost::extents[this->vertexCnt][this->vertexCnt]);
+	index_energyTable.resize(boost::extents[this->vertexCnt][this->vertexCnt]);
+	index_routingTable.resize(boost::extents[this->vertexCnt][this->vertexCnt]);
+	index_delayTable = this->index_delayTable0;
+	index_energyTable = this->index_energyTable0;
+	index_routingTable = this->index_routingTable0;
+	if (!ShortestPath::addShortestPathEdges(topo, this->addedEdges, index_delayTable, index_energyTable, index_routingTable)) {
+		ShortestPath::calculateShortestPathTables(topo, index_delayTable, index_energyTable, index_routingTable);
+	}
+}
+
+void ReconfigTopoInfo::calRoutingTable(GraphLib::graph_t& topo, const RoutingCache& cache, std::uint64_t key) {
+    if (cache.load(key, this->vertexCnt, this->delayTable, this->energyTable, this->routingTable, this->portMap)) {
+		setNextHopPortMap(this->portMap, this->vertexCnt, this->nextHop_port_map);
+		return;
+	}
+
     ShortestPath::TMatrix index_delayTable;
     ShortestPath::TMatrix index_energyTable;
 	ShortestPath::TIntMatrix index_routingTable;
-	ShortestPath::calculateShortestPathTables(topo, index_delayTable, index_energyTable, index_routingTable);
+	this->calIndexTables(topo, index_delayTable, index_energyTable, index_routingTable);
 	
     auto name = boost::get(&GraphLib::vertex_info::name, topo);
 	auto index = boost::get(&GraphLib::vertex_info::index, topo);
@@ -218,9 +272,7 @@ void ReconfigTopoInfo::calRoutingTable(GraphLib::graph_t& topo) {
 	}
 
 	this->portMap = std::make_unique<std::vector<SLinkInfo>[]>(this->vertexCnt);
-	this->nextHop_port_map = std::make_unique<std::unordered_map<TAddressNumber, TAddressNumber>[]>(this->vertexCnt);
 	for (TAddressNumber i = 0; i < this->vertexCnt; i++) {
-		this->nextHop_port_map[i][i] = 0;
 		this->portMap[i].push_back({0, 0, i});
 	}
 	
@@ -236,9 +288,9 @@ void ReconfigTopoInfo::calRoutingTable(GraphLib::graph_t& topo) {
         TAddressNumber q = this->portMap[add2].size();
 		this->portMap[add1].push_back({q, d, add2});
 		this->portMap[add2].push_back({p, d, add1});
-		this->nextHop_port_map[add1][add2] = p;
-		this->nextHop_port_map[add2][add1] = q;
 	});
+	setNextHopPortMap(this->portMap, this->vertexCnt, this->nextHop_port_map);
+	cache.store(key, this->vertexCnt, this->delayTable, this->energyTable, this->routingTable, this->portMap);
 }
 
 void ReconfigTopoInfo::readReconfigurationFile(const std::string& reconfigurationFilePath) {
@@ -278,12 +330,14 @@ void ReconfigTopoInfo::reconfigurateTopology(std::int64_t periodNumber) {
     this->resetTopology();
     for (auto& newLink : this->flows[periodNumber]) {
         GraphLib::edge_p ep{newLink.delay};
-        boost::add_edge(this->topoVertices[newLink.src], this->topoVertices[newLink.dst], ep, this->curTopo);
+        this->addedEdges.push_back(
+            boost::add_edge(this->topoVertices[newLink.src], this->topoVertices[newLink.dst], ep, this->curTopo).first);
     }
 }
 
 void ReconfigTopoInfo::resetTopology() {
     this->curTopo = this->topo0;
+    this->addedEdges.clear();
     this->setTopoVertices(this->curTopo);
 }
 
@@ -304,32 +358,43 @@ std::int64_t ReconfigTopoInfo::getCurrentReconfigurationPeriod() {
 void ReconfigTopoInfo::reconfigurate(TimeType reconfigurationTime, TimeType next_reconfigurationTime) {
     if (this->curReconfigPeriodNumber < this->periodCnt) {
         this->reconfigurateTopology(this->curReconfigPeriodNumber);
-        this->calRoutingTable(this->curTopo);
+        this->calRoutingTable(this->curTopo, this->routingCache,
+            RoutingCache::hashValue(this->curReconfigPeriodNumber, this->reconfigKey));
         this->lastReconfigurationTime = reconfigurationTime;
         this->nextReconfigurationTime = next_reconfigurationTime;
         this->curReconfigPeriodNumber += 1;
     }
 }
 
-ReconfigTopoInfo::ReconfigTopoInfo(const std::string& topo_file_path, const std::string& reconfig_file_path) {
+ReconfigTopoInfo::ReconfigTopoInfo(const std::string& topo_file_path, const std::string& reconfig_file_path,
+    const std::string& routing_cache_dir)
+:   routingCache(routing_cache_dir),
+    topologyKey(0),
+    reconfigKey(0)
+{
     this->readTopo(topo_file_path);
     this->otherInit();
     this->readReconfigurationFile(reconfig_file_path);
+    if (this->routingCache.isEnabled()) {
+        // The tables of a period depend on the topology and the flows added, the first ones on the topology only.
+        this->topologyKey = RoutingCache::getTopologyKey(topo_file_path);
+        this->reconfigKey = RoutingCache::hashFile(reconfig_file_path, this->topologyKey);
+    }
     this->curReconfigPeriodNumber = RECONFIGURATION_PERIOD_NUMBER_0;
     this->lastReconfigurationTime = 0;
     this->old_routingTable.resize(boost::extents[this->vertexCnt][this->vertexCnt]);
     this->setPipelineDelay(this->topo0);
     this->setPortCnt_rtr(this->topo0);
     this->resetTopology();
-    this->calRoutingTable(this->curTopo);
+    this->calRoutingTable(this->curTopo, this->routingCache, this->topologyKey);
     this->swapRoutingInfo();
 }
 
 void CReconfigTopoRouter::routingAlg(const AddrType& dst, const AddrType& src, long s_ph, long s_vc) {
-    TAddressNumber nextAdd = this->topo_info.routingTable[this->address_.front()][dst.front()];
-	auto it = this->topo_info.nextHop_port_map[this->address_.front()].find(nextAdd);
-	if (it == this->topo_info.nextHop_port_map[this->address_.front()].end()) {
-        Logger::error("Routing error: dst {} in {} next: {}", dst.front(), this->address_.front(), nextAdd);
+    TAddressNumber nextAdd = this->topo_info.routingTable[this->id_][dst.front()];
+	auto it = this->topo_info.nextHop_port_map[this->id_].find(nextAdd);
+	if (it == this->topo_info.nextHop_port_map[this->id_].end()) {
+        Logger::error("Routing error: dst {} in {} next: {}", dst.front(), this->id_, nextAdd);
 		Sassert(false, "Routing error.");
 	}
 	TAddressNumber port = it->second;
@@ -339,29 +404,37 @@ void CReconfigTopoRouter::routingAlg(const AddrType& dst, const AddrType& src, l
 }
 
 TimeType CReconfigTopoRouter::getWireDelay(long port) {
-    return this->topo_info.portMap[this->address_.front()][port].linkDelay;
+    return this->topo_info.portMap[this->id_][port].linkDelay;
 }
 
 void CReconfigTopoRouter::getNextAddress(AddrType& next_addr, long port) {
     next_addr.clear();
-    next_addr.push_back(this->topo_info.portMap[this->address_.front()][port].neighbour);
+    next_addr.push_back(this->topo_info.portMap[this->id_][port].neighbour);
+}
+
+RouterId CReconfigTopoRouter::getNextRouterId(long port) {
+    return this->topo_info.portMap[this->id_][port].neighbour;
 }
 
 long CReconfigTopoRouter::getWirePc(long port) {
-    return this->topo_info.portMap[this->address_.front()][port].neighbourPort;
+    return this->topo_info.portMap[this->id_][port].neighbourPort;
 }
 
 void CReconfigTopoRouter::getFromRouter(AddrType& from, long port) {
     from.clear();
-    from.push_back(this->topo_info.portMap[this->address_.front()][port].neighbour);
+    from.push_back(this->topo_info.portMap[this->id_][port].neighbour);
+}
+
+RouterId CReconfigTopoRouter::getFromRouterId(long port) {
+    return this->topo_info.portMap[this->id_][port].neighbour;
 }
 
 long CReconfigTopoRouter::getFromPort(long port) {
-    return this->topo_info.portMap[this->address_.front()][port].neighbourPort;
+    return this->topo_info.portMap[this->id_][port].neighbourPort;
 }
 
 TimeType CReconfigTopoRouter::pipelineStageDelay() {
-    return this->topo_info.topo0[this->topo_info.topoVertices[this->address_.front()]].pipelineStageDelay;
+    return this->topo_info.topo0[this->topo_info.topoVertices[this->id_]].pipelineStageDelay;
 }
 
 bool CReconfigTopoRouter::isEventAfterReconfiguration(TimeType delay) {
@@ -372,7 +445,7 @@ bool CReconfigTopoRouter::isNearReconfiguration() {
     return Global::getCurrTime() + RECONFIGURATION_INTERVAL >= this->topo_info.nextReconfigurationTime;
 }
 
-CReconfigTopoRouter::CReconfigTopoRouter(const Config& config, AddrType addr, std::vector<BaseRouter *>& router_list_, ReconfigTopoInfo& topo_info)
-:   BaseRouter(config, addr, router_list_),
+CReconfigTopoRouter::CReconfigTopoRouter(const Config& config, RouterId id, std::vector<BaseRouter *>& router_list_, ReconfigTopoInfo& topo_info)
+:   BaseRouter(config, id, router_list_),
     topo_info(topo_info)
 {}
\ No newline at end of file
@@ -3,7 +3,7 @@
 void Sim::setInitEvent() {
     switch (this->config_.getRoutingAlg()) {
         case RoutingType::RECONFIGURABLE_GRAPH_TOPO:
-            Global::messageQueue.addMessage(
+            Global::messageQueue().addMessage(
                 MessEvent(
                     0 - S_ELPS_/  2,
                     MessType::ROUTER
@@ -11,8 +11,8 @@ void Sim::setInitEvent() {
             );
             break;
         case RoutingType::GRAPH_TOPO:
-            for (auto& p: Global::RoutingPeriods) {
-                Global::messageQueue.addMessage(
+            for (auto& p: Global::RoutingPeriods()) {
+                Global::messageQueue().addMessage(
                     MessEvent(
                         0,
                         MessType::ROUTER,
@@ -22,7 +22,7 @@ void Sim::setInitEvent() {
             }
             break;
         default:
-            Global::messageQueue.addMessage(
+            Global::messageQueue().addMessage(
                 MessEvent(
                     0,
                     MessType::ROUTER
@@ -32,55 +32,148 @@ void Sim::setInitEvent() {
     }
 }
 
-void Sim::receive_EVG_message(MessEvent mesg) {
-    AddrType tmp = Global::inputTrace->front().src_addr;
-    this->router(tmp).recvPacket();
-    Global::inputTrace->popFront();
-    if (!Global::inputTrace->isEmpty()) {
-        Global::messageQueue.addMessage(
+void Sim::receive_EVG_message(MessEvent& mesg) {
+    Global::inputTrace()->advance(Global::getCurrTime());
+    RouterId src = Global::inputTrace()->front().src_id;
+    this->router(src).recvPacket();
+    this->wakeRouter(src);
+    Global::inputTrace()->popFront();
+    if (!Global::inputTrace()->isEmpty()) {
+        Global::messageQueue().addMessage(
             MessEvent(
-                Global::inputTrace->front().start_time,
+                Global::inputTrace()->front().start_time,
                 MessType::EVG
             )
         );
     }
 }
     
-void Sim::receive_ROUTER_message(MessEvent mesg) {
+/**
+ * @brief Merge the woken routers into the active routers, keeping index order
+ * @param active The active routers, in ascending order
+ * @param woken The woken routers, cleared
+ * @note The routers are merged from the back, as `std::inplace_merge` would allocate a buffer every cycle.
+ */
+static void mergeWokenRouters(std::vector<std::size_t>& active, std::vector<std::size_t>& woken) {
+    if (woken.empty()) {
+        return;
+    }
+    std::sort(woken.begin(), woken.end());
+    std::size_t i = active.size();
+    std::size_t j = woken.size();
+    active.resize(i + j);
+    for (std::size_t k = active.size(); j > 0; ) {
+        if (i > 0 && active[i - 1] > woken[j - 1]) {
+            active[--k] = active[--i];
+        }
+        else {
+            active[--k] = woken[--j];
+        }
+    }
+    woken.clear();
+}
+
+void Sim::receive_ROUTER_message(MessEvent& mesg) {
     TimeType p = mesg.getRoutingPeriod();
-    Global::messageQueue.addMessage(
+    Global::messageQueue().addMessage(
         MessEvent(
             mesg.getEventStart() + p,
             MessType::ROUTER,
             p
         )
     );
-    for (auto& router : this->inter_network_) {
-        router->routingPipeStage(p);
+    if (this->config_.getRouterSchedule() == RouterScheduleType::FULL) {
+        this->tickRouters(this->all_routers_, p);
+        return;
+    }
+
+    // Routers are ticked in index order, as in the full sweep, so that the random sequence is kept.
+    mergeWokenRouters(this->active_routers_, this->woken_routers_);
+    this->tickRouters(this->active_routers_, p);
+    std::size_t keep = 0;
+    for (std::size_t index : this->active_routers_) {
+        if (this->inter_network_[index]->isIdle()) {
+            this->router_active_[index] = 0;
+        }
+        else {
+            this->active_routers_[keep++] = index;
+        }
     }
+    this->active_routers_.resize(keep);
 }
 
-void Sim::receive_WIRE_message(MessEvent mesg) {
-    AddrType des_t = mesg.getDes();
+void Sim::tickRouters(const std::vector<std::size_t>& indices, TimeType routing_period) {
+    this->tick_count_ += indices.size();
+    if (!this->workers_) {
+        for (std::size_t index : indices) {
+            this->inter_network_[index]->routingPipeStage(routing_period);
+        }
+        return;
+    }
+
+    std::size_t worker_num = std::clamp<std::size_t>(indices.size() / PIPELINE_MIN_ROUTERS_,
+        1, this->workers_->size());
+    std::size_t chunk = (indices.size() + worker_num - 1) / worker_num;
+    TimeType now = Global::getCurrTime();
+    std::function<void(std::size_t)> task = [&](std::size_t worker) {
+        Global::CurrTime = now;
+        RouterOutbox& outbox = this->outboxes_[worker];
+        std::size_t end = std::min(indices.size(), (worker + 1) * chunk);
+        for (std::size_t k = worker * chunk; k < end; k++) {
+            BaseRouter* router = this->inter_network_[indices[k]];
+            router->setOutbox(&outbox);
+            router->routingPipeStage(routing_period);
+            router->setOutbox(nullptr);
+        }
+    };
+    if (worker_num == 1) {
+        task(0);
+    }
+    else {
+        this->workers_->run(worker_num, task);
+    }
+
+    // The outboxes cover contiguous router ranges, so applying them in worker order keeps router order.
+    for (std::size_t worker = 0; worker < worker_num; worker++) {
+        for (auto& event : this->outboxes_[worker].events) {
+            Global::messageQueue().addMessage(std::move(event));
+        }
+    }
+    for (std::size_t worker = 0; worker < worker_num; worker++) {
+        for (auto& accepted : this->outboxes_[worker].accepted) {
+            accepted.router->acceptFlit(accepted.time, accepted.flit);
+        }
+    }
+    for (std::size_t worker = 0; worker < worker_num; worker++) {
+        for (auto& injection : this->outboxes_[worker].injections) {
+            injection.router->recvPacket();
+        }
+        this->outboxes_[worker].clear();
+    }
+}
+
+void Sim::receive_WIRE_message(MessEvent& mesg) {
+    RouterId des_t = mesg.getDes();
     long pc_t = mesg.getPC();
 	long vc_t = mesg.getVC();
-	Flit& flits_t = mesg.getFlit();
-	this->router(des_t).recvFlit(pc_t, vc_t, flits_t);
+	this->router(des_t).recvFlit(pc_t, vc_t, mesg.getFlit());
+    this->wakeRouter(des_t);
 }
 
-void Sim::receive_CREDIT_message(MessEvent mesg) {
-    AddrType des_t = mesg.getDes();
+void Sim::receive_CREDIT_message(MessEvent& mesg) {
+    RouterId des_t = mesg.getDes();
     long pc_t = mesg.getPC();
 	long vc_t = mesg.getVC();
 	this->router(des_t).recvCredit(pc_t, vc_t);
+    this->wakeRouter(des_t);
 }
 
-void Sim::receive_RECONFIGURATION_message(MessEvent mesg) {
+void Sim::receive_RECONFIGURATION_message(MessEvent& mesg) {
     TimeType eventTime = mesg.getEventStart();
     TimeType nextReconfigTime = eventTime + this->topo_info.reconfig_topo_info->getCurrentReconfigurationPeriod();
 	this->topo_info.reconfig_topo_info->reconfigurate(eventTime, nextReconfigTime);
     Logger::info("Enter reconfiguration period {}.", this->topo_info.reconfig_topo_info->getCurrentReconfigurationPeriod());
-    Global::messageQueue.addMessage(
+    Global::messageQueue().addMessage(
         MessEvent(
             nextReconfigTime,
             MessType::RECONFIGURATION
@@ -88,43 +181,492 @@ void Sim::receive_RECONFIGURATION_message(MessEvent mesg) {
     );
 }
 
-BaseRouter& Sim::router(const AddrType& addr) {
-    long index = 0;
-    for (auto& iter: addr) {
-        index = iter + index * this->config_.getAryNumber();
+BaseRouter& Sim::router(RouterId id) {
+    return *this->inter_network_[id];
+}
+
+void Sim::wakeRouter(std::size_t index) {
+    if (this->router_active_[index] == 0) {
+        this->router_active_[index] = 1;
+        this->woken_routers_.push_back(index);
     }
-    return *this->inter_network_[index];
 }
 
-Sim::Sim(const Config& config)
+void Sim::skipIdleCycles() {
+    // Several routing clocks (GRAPH_TOPO) are left alone.
+    if (Global::messageQueue().size(MessType::ROUTER) != 1
+        || Global::messageQueue().getTop().getEventType() != MessType::ROUTER
+    ) {
+        return;
+    }
+
+    TimeType next_event_time = -1;
+    for (unsigned char idx = 0; idx < MESS_TYPE_NUMBER; idx++) {
+        if (idx == static_cast<unsigned char>(MessType::ROUTER) || Global::messageQueue().empty(MessType(idx))) {
+            continue;
+        }
+        TimeType t = Global::messageQueue().getTop(MessType(idx)).getEventStart();
+        if (next_event_time < 0 || t < next_event_time) {
+            next_event_time = t;
+        }
+    }
+    if (next_event_time < 0) {
+        return;
+    }
+
+    const MessEvent& clock = Global::messageQueue().getTop();
+    TimeType start = clock.getEventStart();
+    TimeType p = clock.getRoutingPeriod();
+    // Stay on the clock grid and never pass the next event, the stages before it have nothing to do.
+    long cycles = static_cast<long>(std::floor((next_event_time - start) / p + S_ELPS_));
+    if (cycles <= 0) {
+        return;
+    }
+    Global::messageQueue().popFront();
+    Global::messageQueue().addMessage(
+        MessEvent(
+            start + cycles * p,
+            MessType::ROUTER,
+            p
+        )
+    );
+    this->skipped_cycles_ += cycles;
+    LOG_DEBUG("Skip {} idle cycles to cycle: {}.", cycles, start + cycles * p);
+}
+
+void Sim::setPartitions() {
+    if (this->config_.isSyncProtocolEnable() || this->config_.isPacketLoss() || this->config_.isEndWithMinus1()
+        || this->config_.getRoutingAlg() == RoutingType::RECONFIGURABLE_GRAPH_TOPO
+    ) {
+        throw std::runtime_error("The partitioned engine does not support the sync protocol, "
+            "packet loss, traces ending with -1 or reconfiguration.");
+    }
+
+    std::size_t router_num = this->inter_network_.size();
+    std::size_t partition_num = std::min<std::size_t>(this->config_.getPartitions(), router_num);
+    std::vector<std::vector<std::size_t>> neighbours(router_num);
+    std::vector<std::vector<TimeType>> delays(router_num);
+    for (std::size_t i = 0; i < router_num; i++) {
+        BaseRouter* router = this->inter_network_[i];
+        for (long port = 1; port < router->getPortNumber(); port++) {
+            RouterId neighbour;
+            TimeType delay = router->getLink(port, neighbour);
+            Sassert(neighbour < router_num, "A link leads out of the network.");
+            neighbours[i].push_back(neighbour);
+            delays[i].push_back(delay);
+        }
+    }
+
+    // Every partition is a contiguous run of this order.
+    std::vector<std::size_t> order(router_num);
+    std::iota(order.begin(), order.end(), 0);
+    if (this->config_.getRoutingAlg() == RoutingType::GRAPH_TOPO) {
+        std::vector<char> visited(router_num, 0);
+        std::size_t tail = 0;
+        for (std::size_t root = 0; root < router_num; root++) {
+            if (visited[root]) {
+                continue;
+            }
+            visited[root] = 1;
+            std::size_t head = tail;
+            order[tail++] = root;
+            while (head < tail) {
+                for (std::size_t next : neighbours[order[head++]]) {
+                    if (!visited[next]) {
+                        visited[next] = 1;
+                        order[tail++] = next;
+                    }
+                }
+            }
+        }
+    }
+    this->partition_of_.resize(router_num);
+    for (std::size_t k = 0; k < router_num; k++) {
+        this->partition_of_[order[k]] = k * partition_num / router_num;
+    }
+
+    for (std::size_t id = 0; id < partition_num; id++) {
+        auto part = std::make_unique<Partition>();
+        part->queue.setEngine(this->config_.getEventQueueType());
+        part->outgoing.resize(partition_num);
+        this->partitions_.push_back(std::move(part));
+    }
+    for (std::size_t i = 0; i < router_num; i++) {
+        this->partitions_[this->partition_of_[i]]->routers.push_back(i);
+    }
+    for (auto& part : this->partitions_) {
+        part->active_routers.reserve(part->routers.size());
+        part->woken_routers.reserve(part->routers.size());
+    }
+
+    // Flits cross a cut link after its wire delay, credits after CREDIT_DELAY_.
+    this->lookahead_ = CREDIT_DELAY_;
+    for (std::size_t i = 0; i < router_num; i++) {
+        for (std::size_t k = 0; k < neighbours[i].size(); k++) {
+            if (this->partition_of_[neighbours[i][k]] != this->partition_of_[i]) {
+                this->lookahead_ = std::min(this->lookahead_, delays[i][k]);
+            }
+        }
+    }
+    Sassert(this->lookahead_ > 0, "Links between partitions need a positive delay.");
+
+    this->workers_ = std::make_unique<PipelineWorkers>(partition_num);
+    Logger::info("Split {} routers into {} partitions, with a lookahead of {}.",
+        router_num, partition_num, this->lookahead_);
+}
+
+void Sim::wakePartitionRouter(Partition& part, std::size_t index, bool after_tick) {
+    if (this->router_active_[index] == 0) {
+        this->router_active_[index] = 1;
+        part.woken_routers.push_back(index);
+    }
+    if (part.clock_running) {
+        return;
+    }
+    // Stay on the grid of the sequential routing clock, which ticks every PIPE_DELAY_ from 0.
+    TimeType now = Global::getCurrTime();
+    TimeType tick = std::ceil(now / PIPE_DELAY_ - S_ELPS_) * PIPE_DELAY_;
+    if (after_tick && tick <= now + S_ELPS_) {
+        tick += PIPE_DELAY_;
+    }
+    tick = std::max(tick, part.last_tick + PIPE_DELAY_);
+    part.queue.addMessage(
+        MessEvent(
+            tick,
+            MessType::ROUTER
+        )
+    );
+    part.clock_running = true;
+}
+
+void Sim::runPartition(std::size_t id, TimeType window_end, TimeType limit, TimeType stop_tick) {
+    Partition& part = *this->partitions_[id];
+    while (!part.queue.empty()) {
+        TimeType t = part.queue.getTop().getEventStart();
+        if (t >= window_end || t > limit) {
+            break;
+        }
+        if (stop_tick >= 0 && t >= stop_tick && part.queue.getTop().getEventType() == MessType::ROUTER) {
+            break;
+        }
+        MessEvent mesg(part.queue.takeFront());
+        Global::setCurrTime(t);
+        part.event_count++;
+        if (this->event_trace_) {
+            part.events.push_back(this->eventRecord(mesg));
+        }
+
+        switch (mesg.getEventType()) {
+            case MessType::ROUTER: {
+                part.clock_running = false;
+                part.last_tick = t;
+                mergeWokenRouters(part.active_routers, part.woken_routers);
+                for (std::size_t index : part.active_routers) {
+                    BaseRouter* router = this->inter_network_[index];
+                    router->setOutbox(&part.outbox);
+                    router->routingPipeStage(mesg.getRoutingPeriod());
+                    router->setOutbox(nullptr);
+                }
+                part.tick_count += part.active_routers.size();
+                if (!part.outbox.accepted.empty()) {
+                    part.last_time = t;
+                }
+
+                for (auto& event : part.outbox.events) {
+                    std::size_t dest = this->partition_of_[event.getDes()];
+                    if (dest == id) {
+                        part.queue.addMessage(std::move(event));
+                    }
+                    else {
+                        Sassert(event.getEventStart() >= window_end, "An event crosses partitions within the lookahead.");
+                        part.outgoing[dest].push_back(std::move(event));
+                        part.sent_count++;
+                    }
+                }
+                part.outbox.events.clear();
+
+                std::size_t keep = 0;
+                for (std::size_t index : part.active_routers) {
+                    if (this->inter_network_[index]->isIdle()) {
+                        this->router_active_[index] = 0;
+                    }
+                    else {
+                        part.active_routers[keep++] = index;
+                    }
+                }
+                part.active_routers.resize(keep);
+                if (!part.active_routers.empty()) {
+                    part.queue.addMessage(
+                        MessEvent(
+                            t + mesg.getRoutingPeriod(),
+                            MessType::ROUTER
+                        )
+                    );
+                    part.clock_running = true;
+                }
+                break;
+            }
+            case MessType::WIRE:
+                this->router(mesg.getDes()).recvFlit(mesg.getPC(), mesg.getVC(), mesg.getFlit());
+                part.last_time = t;
+                this->wakePartitionRouter(part, mesg.getDes(), false);
+                break;
+            case MessType::CREDIT:
+                this->router(mesg.getDes()).recvCredit(mesg.getPC(), mesg.getVC());
+                part.last_time = t;
+                this->wakePartitionRouter(part, mesg.getDes(), false);
+                break;
+            default:
+                Sassert(false, "This message type is not supported by the partitioned engine.");
+                break;
+        }
+    }
+}
+
+bool Sim::forwardPartitionClocks(long injected, TimeType& stop_tick) {
+    stop_tick = -1;
+    // The sequential loop checks after every event, the partitions can only check between windows.
+    if (injected != static_cast<long>(Global::getTotalFin())) {
+        return true;
+    }
+    TimeType next_tick = -1;
+    TimeType next_event_time = -1;
+    for (auto& part : this->partitions_) {
+        for (unsigned char idx = 0; idx < MESS_TYPE_NUMBER; idx++) {
+            if (part->queue.empty(MessType(idx))) {
+                continue;
+            }
+            TimeType t = part->queue.getTop(MessType(idx)).getEventStart();
+            if (idx == static_cast<unsigned char>(MessType::ROUTER)) {
+                next_tick = next_tick < 0 ? t : std::min(next_tick, t);
+            }
+            else if (next_event_time < 0 || t < next_event_time) {
+                next_event_time = t;
+            }
+        }
+    }
+    // The EVG event of the next packet comes after the ROUTER event of the same time.
+    TimeType packet_time = Global::inputTrace()->isEmpty() ? -1 : Global::inputTrace()->front().start_time;
+    TimeType first_time = next_event_time;
+    if (packet_time >= 0 && (first_time < 0 || packet_time < first_time)) {
+        first_time = packet_time;
+    }
+    if (first_time < 0) {
+        return false;
+    }
+    if (next_tick < 0) {
+        return true;
+    }
+
+    if (next_tick < first_time) {
+        double cycles = round((first_time - next_tick) / PIPE_DELAY_);
+        TimeType new_tick = next_tick + cycles * PIPE_DELAY_;
+        for (auto& part : this->partitions_) {
+            if (part->queue.empty(MessType::ROUTER)) {
+                continue;
+            }
+            part->queue.clear(MessType::ROUTER);
+            part->queue.addMessage(
+                MessEvent(
+                    new_tick,
+                    MessType::ROUTER
+                )
+            );
+        }
+        this->skipped_cycles_ += static_cast<std::size_t>(cycles);
+        next_tick = new_tick;
+    }
+    if ((next_event_time >= 0 && next_event_time <= next_tick) || (packet_time >= 0 && packet_time < next_tick)) {
+        stop_tick = next_tick;
+    }
+    return true;
+}
+
+void Sim::mainProcessPartitioned() {
+    auto wall_start = std::chrono::steady_clock::now();
+    TimeType end_time = 0;
+    long injected = 0;
+    std::size_t sent_count = 0;
+    std::function<void(std::size_t)> task;
+
+    while (true) {
+        // Hand over the events sent across partitions, in partition order.
+        for (auto& src : this->partitions_) {
+            for (std::size_t dest = 0; dest < this->partitions_.size(); dest++) {
+                for (auto& event : src->outgoing[dest]) {
+                    this->partitions_[dest]->queue.addMessage(std::move(event));
+                }
+                src->outgoing[dest].clear();
+            }
+        }
+
+        TimeType stop_tick = -1;
+        if (!this->forwardPartitionClocks(injected, stop_tick)) {
+            break;
+        }
+
+        TimeType start = -1;
+        for (auto& part : this->partitions_) {
+            if (!part->queue.empty() && (start < 0 || part->queue.getTop().getEventStart() < start)) {
+                start = part->queue.getTop().getEventStart();
+            }
+        }
+        bool has_packet = !Global::inputTrace()->isEmpty();
+        TimeType packet_time = has_packet ? Global::inputTrace()->front().start_time : -1;
+        if (has_packet && (start < 0 || packet_time < start)) {
+            start = packet_time;
+        }
+        if (start < 0) {
+            break;
+        }
+        if (start > this->config_.getSimLength()) {
+            // The sequential loop stops on the first event past the length, so the run ends there too.
+            end_time = std::max(end_time, start);
+            break;
+        }
+        this->sampleTelemetry(start);
+        TimeType window_end = start + this->lookahead_;
+        if (this->telemetry_) {
+            // The telemetry is sampled between windows, so a window stops at the end of a report period.
+            window_end = std::min(window_end, this->telemetry_next_);
+        }
+        bool inject = has_packet && packet_time < window_end;
+        TimeType limit = inject ? packet_time : window_end;
+        if (stop_tick >= 0 && stop_tick <= limit) {
+            // The sequential loop may move its routing clock again before the tick, so the window stops there.
+            inject = false;
+            limit = stop_tick;
+        }
+        if (inject) {
+            Global::inputTrace()->advance(packet_time);
+        }
+
+        task = [this, window_end, limit, stop_tick](std::size_t id) {
+            this->runPartition(id, window_end, limit, stop_tick);
+        };
+        this->workers_->run(this->partitions_.size(), task);
+        this->window_count_++;
+
+        // The changes to shared state are applied in partition order, then in router order.
+        for (auto& part : this->partitions_) {
+            if (this->event_trace_) {
+                this->event_trace_->record(part->events);
+                part->events.clear();
+            }
+            for (auto& accepted : part->outbox.accepted) {
+                accepted.router->acceptFlit(accepted.time, accepted.flit);
+            }
+            part->outbox.accepted.clear();
+        }
+        for (auto& part : this->partitions_) {
+            for (auto& injection : part->outbox.injections) {
+                Global::setCurrTime(injection.time);
+                injection.router->recvPacket();
+                this->wakePartitionRouter(*part, injection.router->getId(), true);
+            }
+            part->outbox.injections.clear();
+            end_time = std::max(end_time, part->last_time);
+        }
+        while (inject && !Global::inputTrace()->isEmpty() && Global::inputTrace()->front().start_time <= limit) {
+            RouterId index = Global::inputTrace()->front().src_id;
+            Global::setCurrTime(Global::inputTrace()->front().start_time);
+            end_time = std::max(end_time, Global::getCurrTime());
+            this->inter_network_[index]->recvPacket();
+            this->wakePartitionRouter(*this->partitions_[this->partition_of_[index]], index, true);
+            Global::inputTrace()->popFront();
+            this->mess_count_++;
+            injected++;
+        }
+    }
+
+    for (auto& part : this->partitions_) {
+        this->mess_count_ += part->event_count;
+        this->tick_count_ += part->tick_count;
+        sent_count += part->sent_count;
+    }
+    Global::setCurrTime(end_time);
+
+    std::chrono::duration<double> wall_time = std::chrono::steady_clock::now() - wall_start;
+    Logger::info("Processed {} events in {:.3f} s with {} partitions.",
+        this->mess_count_, wall_time.count(), this->partitions_.size());
+    Logger::info("Ran {} time windows, {} events crossed partitions.", this->window_count_, sent_count);
+    Logger::info("Flit pool peak: {} flits in flight.", Global::flitPool().getPeakSize());
+    Logger::info("Ran {} router pipeline stages.", this->tick_count_);
+    Logger::info("Skipped {} idle cycles.", this->skipped_cycles_);
+    this->logTraceSyscalls();
+    this->flushEventTrace();
+    this->finishTelemetry();
+    Global::delaySink()->flush();
+}
+
+Sim::Sim(const Config& config, const SimInputs& inputs)
 :   config_(config),
     last_time_(0),
-    mess_count_(0)
+    mess_count_(0),
+    tick_count_(0),
+    skipped_cycles_(0),
+    lookahead_(0),
+    window_count_(0),
+    shared_topo_info_(inputs.topo_info != nullptr),
+    delay_sink_(),
+    event_trace_(),
+    telemetry_(),
+    telemetry_totals_(),
+    telemetry_window_(),
+    telemetry_start_(0),
+    telemetry_next_(config.getReportPeriod())
 {
     if (config.getRandomSeed() != std::nullopt) {
-        Global::RandomGen.reset_seed(config.getRandomSeed().value());
+        Global::RandomGen().reset_seed(config.getRandomSeed().value());
     }
+
+    Global::messageQueue().setEngine(config.getEventQueueType());
+
+    this->delay_sink_ = std::make_unique<DelaySink>(config.getDelayFname(), config.getDelayFormat(),
+        config.getCubeNumber(), config.isDelayAsync());
+    Global::delaySink() = this->delay_sink_.get();
     
-    Global::inputTrace = new InputTrace(config.getTraceFname(),
-        config.isSyncProtocolEnable(), config.getCubeNumber());
-    
-    this->router_count_ = config.getAryNumber();
+    if (inputs.trace != nullptr) {
+        Global::inputTrace() = new InputTrace(*inputs.trace);
+        this->address_table_ = inputs.trace->getAddressTable();
+        Sassert(this->address_table_->getDimension() == config.getCubeNumber()
+            && this->address_table_->getAryNumber() == config.getAryNumber(),
+            "The trace was read for another network.");
+    }
+    else {
+        this->address_table_ = std::make_shared<AddressTable>(config.getCubeNumber(), config.getAryNumber());
+        Global::inputTrace() = new InputTrace(config.getTraceFname(),
+            config.isSyncProtocolEnable(), this->address_table_);
+        Global::inputTrace()->setStreamWindow(config.getTraceWindow());
+        if (config.isEndWithMinus1()) {
+            Global::inputTrace()->setLive(config.getTracePollInterval());
+        }
+    }
     
-    for (long i = 0; i < config.getCubeNumber() - 1; i++) {
-        this->router_count_ = this->router_count_ * config.getAryNumber();
+    Global::addressTable() = this->address_table_.get();
+    this->router_count_ = this->address_table_->size();
+    if (!config.getEventTraceFname().empty()) {
+        this->event_trace_ = std::make_unique<EventTrace>(config.getEventTraceFname(), this->router_count_);
+    }
+    if (!config.getTelemetryFname().empty()) {
+        this->telemetry_ = std::make_unique<Telemetry>(config.getTelemetryFname(), this->router_count_,
+            config.getPhysicalPortNumber());
+        this->telemetry_totals_.resize(this->router_count_);
+        for (auto& totals : this->telemetry_totals_) {
+            totals.link_energy.resize(config.getPhysicalPortNumber(), 0);
+        }
+        this->telemetry_window_.resize(this->router_count_, config.getPhysicalPortNumber());
     }
 
-    AddrType addr;
-    addr.resize(config.getCubeNumber(), 0);
     this->inter_network_.reserve(this->router_count_);
 
-    for (long i = 0; i < this->router_count_; i++) {
+    for (RouterId id = 0; id < this->router_count_; id++) {
 
         switch (config.getRoutingAlg()) {
             case RoutingType::XY:
                 this->inter_network_.push_back(
                     new CXYRouter(
-                        config, addr,
+                        config, id,
                         this->inter_network_
                     )
                 );
@@ -132,7 +674,7 @@ Sim::Sim(const Config& config)
             case RoutingType::TXY:
                 this->inter_network_.push_back(
                     new CTXYRouter(
-                        config, addr,
+                        config, id,
                         this->inter_network_
                     )
                 );
@@ -140,7 +682,7 @@ Sim::Sim(const Config& config)
             case RoutingType::CHIPLET_ROUTING_MESH:
                 this->inter_network_.push_back(
                     new CChipletMeshRouter(
-                        config, addr,
+                        config, id,
                         this->inter_network_
                     )
                 );
@@ -148,20 +690,24 @@ Sim::Sim(const Config& config)
             case RoutingType::CHIPLET_STAR_TOPO_ROUTING:
 			    this->inter_network_.push_back(
                     new CChipletStarRouter(
-                        config, addr,
+                        config, id,
                         this->inter_network_
                     )
                 );
                 break;
 		    case RoutingType::GRAPH_TOPO:
-			    if (this->topo_info.topo_info == nullptr) {
+			    if (this->topo_info.topo_info == nullptr && inputs.topo_info != nullptr) {
+                    this->topo_info.topo_info = inputs.topo_info;
+                }
+			    else if (this->topo_info.topo_info == nullptr) {
                     this->topo_info.topo_info = new TopoInfo(
-                        config.getTopoFilePath()
+                        config.getTopoFilePath(),
+                        config.getRoutingCacheDir()
                     );
                 }
                 this->inter_network_.push_back(
                     new CGraphTopo(
-                        config, addr,
+                        config, id,
                         this->inter_network_,
                         *this->topo_info.topo_info
                     )
@@ -171,12 +717,13 @@ Sim::Sim(const Config& config)
 			    if (this->topo_info.reconfig_topo_info == nullptr) {
                     this->topo_info.reconfig_topo_info = new ReconfigTopoInfo(
                         config.getTopoFilePath(),
-                        config.getReconfigFilePath()
+                        config.getReconfigFilePath(),
+                        config.getRoutingCacheDir()
                     );
                 }
                 this->inter_network_.push_back(
                     new CReconfigTopoRouter(
-                        config, addr,
+                        config, id,
                         this->inter_network_,
                         *this->topo_info.reconfig_topo_info
                     )
@@ -186,35 +733,60 @@ Sim::Sim(const Config& config)
                 Sassert(false, "Invalid routing algorithm.");
                 break;
         }
+    }
+    this->router_active_.resize(this->inter_network_.size(), 0);
+    this->active_routers_.reserve(this->inter_network_.size());
+    this->woken_routers_.reserve(this->inter_network_.size());
+    this->all_routers_.resize(this->inter_network_.size());
+    std::iota(this->all_routers_.begin(), this->all_routers_.end(), 0);
 
-        addr[config.getCubeNumber() - 1] += 1;
-        for (long j = config.getCubeNumber() - 1; j > 0; j--) {
-            if (addr[j] == config.getAryNumber()) {
-                addr[j] = 0;
-                addr[j - 1] += 1;
-            }
+    if (config.getPipelineThreads() > 1 || config.getPartitions() > 1) {
+        // The streams are drawn in router order, so a seeded run stays reproducible.
+        for (auto& router : this->inter_network_) {
+            router->seedRandom(Global::RandomGen().random_u_long_long(0, MAX_64_));
         }
     }
-    Global::inputTrace->readTraceFile();
-    Global::messageQueue.addMessage(
+    if (config.getPartitions() > 1) {
+        this->setPartitions();
+    }
+    else if (config.getPipelineThreads() > 1) {
+        this->workers_ = std::make_unique<PipelineWorkers>(config.getPipelineThreads());
+        this->outboxes_.resize(this->workers_->size());
+    }
+
+    if (config.getStateLayout() == StateLayoutType::NETWORK) {
+        this->router_state_ = std::make_unique<RouterStateArena>(this->inter_network_.size(),
+            config.getPhysicalPortNumber(), config.getVirtualChannelNumber(), config.getInBufferSize());
+        for (std::size_t i = 0; i < this->inter_network_.size(); i++) {
+            this->inter_network_[i]->bindState(*this->router_state_, i);
+        }
+    }
+
+    Global::inputTrace()->waitForPackets();
+    Global::inputTrace()->advance(Global::getCurrTime());
+    Global::messageQueue().addMessage(
         MessEvent(
-            Global::inputTrace->front().start_time,
+            Global::inputTrace()->front().start_time,
             MessType::EVG
         )
     );
 
-    Global::VC_MASK.push_back(1);
+    Global::VC_MASK().push_back(1);
     for (u_int64_t i = 1; i < config_.getPhysicalPortNumber() * config_.getVirtualChannelNumber(); i++) {
-        Global::VC_MASK.push_back(Global::VC_MASK[i - 1] << 1);
+        Global::VC_MASK().push_back(Global::VC_MASK()[i - 1] << 1);
     }
 }
 
 Sim::~Sim() {
-    delete Global::inputTrace;
+    delete Global::inputTrace();
+    Global::inputTrace() = nullptr;
+    Global::addressTable() = nullptr;
+    this->delay_sink_.reset();
+    Global::delaySink() = nullptr;
     for (auto& router: this->inter_network_) {
         delete router;
     }
-    if (this->topo_info.topo_info != nullptr) {
+    if (this->topo_info.topo_info != nullptr && !this->shared_topo_info_) {
         delete this->topo_info.topo_info;
     }
     if (this->topo_info.reconfig_topo_info != nullptr) {
@@ -223,25 +795,29 @@ Sim::~Sim() {
 }
 
 void Sim::mainProcess() {
-    TimeType report_t = 0;
     long total_incoming = 0;
+    if (!this->partitions_.empty()) {
+        this->mainProcessPartitioned();
+        return;
+    }
+    auto wall_start = std::chrono::steady_clock::now();
     this->setInitEvent();
 
     while (Global::getCurrTime() <= this->config_.getSimLength()) {
-        if (Global::messageQueue.empty()) {
-            if (Global::inputTrace->isReadFin()) {
+        if (Global::messageQueue().empty()) {
+            if (Global::inputTrace()->isReadFin()) {
                 break;
             }
             else if (this->config_.isEndWithMinus1()) {
-                while (Global::inputTrace->isEmpty() && !Global::inputTrace->isReadFin()) {
-                    std::this_thread::sleep_for(std::chrono::milliseconds(500));
-                }
-		if (Global::inputTrace->isReadFin() && Global::inputTrace->isEmpty()) {
+                // Whoever writes the trace may wait for the delays of the packets so far.
+                Global::delaySink()->flush();
+                Global::inputTrace()->waitForPackets();
+		if (Global::inputTrace()->isReadFin() && Global::inputTrace()->isEmpty()) {
                     break;
             	}
-                Global::messageQueue.addMessage(
+                Global::messageQueue().addMessage(
                     MessEvent(
-                        Global::inputTrace->front().start_time,
+                        Global::inputTrace()->front().start_time,
                         MessType::EVG
                     )
                 );
@@ -251,14 +827,18 @@ void Sim::mainProcess() {
             }
         }
         
-        MessEvent current_message(Global::messageQueue.getTop());
+        MessEvent current_message(Global::messageQueue().takeFront());
 
-        Global::messageQueue.popFront();
+        this->mess_count_++;
+        this->sampleTelemetry(current_message.getEventStart());
         Global::setCurrTime(current_message.getEventStart());
         Sassert(Global::getCurrTime() <= ((current_message.getEventStart()) + S_ELPS_),
             "Current time is greater than event start time.");
         
-        Logger::debug("Get a message:: {}.", Logger::stream_to_string<MessEvent>(current_message));
+        LOG_DEBUG("Get a message:: {}.", Logger::stream_to_string<MessEvent>(current_message));
+        if (this->event_trace_) {
+            this->event_trace_->record(this->eventRecord(current_message));
+        }
         switch (current_message.getEventType()) {
             case MessType::EVG:
                 this->receive_EVG_message(current_message);
@@ -268,17 +848,9 @@ void Sim::mainProcess() {
                 this->receive_ROUTER_message(current_message);
                 break;
             case MessType::WIRE:
-                Logger::info("From Router {} to Router {} Port {} Virtual Channel {}.",
-                    Logger::stream_to_string<AddrType>(current_message.getSrc()),
-                    Logger::stream_to_string<AddrType>(current_message.getDes()),
-                    current_message.getPC(), current_message.getVC());
                 this->receive_WIRE_message(current_message);
                 break;
             case MessType::CREDIT:
-                Logger::info("From Router {} to Router {} Port {} Virtual Channel {}.",
-                    Logger::stream_to_string<AddrType>(current_message.getSrc()),
-                    Logger::stream_to_string<AddrType>(current_message.getDes()),
-                    current_message.getPC(), current_message.getVC());
                 this->receive_CREDIT_message(current_message);
                 break;
             case MessType::RECONFIGURATION:
@@ -293,26 +865,26 @@ void Sim::mainProcess() {
             double first_event_time = -1;
             double first_router_event_time = -1;
 
-            for (unsigned char idx = 0; idx < 5; idx++) {
-                if (!Global::messageQueue.empty(MessType(idx))) {
+            for (unsigned char idx = 0; idx < MESS_TYPE_NUMBER; idx++) {
+                if (!Global::messageQueue().empty(MessType(idx))) {
                     if (idx == static_cast<unsigned char>(MessType::ROUTER)) {
                         first_router_event_time =
-                            Global::messageQueue.getTop(MessType::ROUTER).getEventStart();
+                            Global::messageQueue().getTop(MessType::ROUTER).getEventStart();
                     }
                     else if (first_event_time == -1
-                        || Global::messageQueue.getTop(MessType(idx)).getEventStart() < first_event_time
+                        || Global::messageQueue().getTop(MessType(idx)).getEventStart() < first_event_time
                     ) {
-                        first_event_time = Global::messageQueue.getTop(MessType(idx)).getEventStart();
+                        first_event_time = Global::messageQueue().getTop(MessType(idx)).getEventStart();
                     }
                 }
             }
 
             if (first_event_time < 0) {
-                Global::messageQueue.clear();
+                Global::messageQueue().clear();
                 break;
             }
             if (first_router_event_time < 0) {
-                Global::messageQueue.clear();
+                Global::messageQueue().clear();
                 continue;
             }
 
@@ -320,22 +892,129 @@ void Sim::mainProcess() {
                 double t = (first_event_time - first_router_event_time) / PIPE_DELAY_;
                 double new_router_event_time = first_router_event_time + round(t) * PIPE_DELAY_;
 
-                Global::messageQueue.clear(MessType::ROUTER);
+                Global::messageQueue().clear(MessType::ROUTER);
 
-                Global::messageQueue.addMessage(
+                Global::messageQueue().addMessage(
                     MessEvent(
                         new_router_event_time,
                         MessType::ROUTER
                     )
                 );
                 Global::setCurrTime(new_router_event_time);
-                Logger::info("Direct forward to cycle: {}.", Global::getCurrTime());
+                this->skipped_cycles_ += static_cast<std::size_t>(round(t));
+                LOG_DEBUG("Direct forward to cycle: {}.", Global::getCurrTime());
             }
         }
+        else if (Global::flitPool().size() == 0) {
+            this->skipIdleCycles();
+        }
+    }
+
+    std::chrono::duration<double> wall_time = std::chrono::steady_clock::now() - wall_start;
+    Logger::info("Processed {} events in {:.3f} s with the {} event queue.",
+        this->mess_count_, wall_time.count(),
+        Logger::stream_to_string<EventQueueType>(this->config_.getEventQueueType()));
+    Logger::info("Flit pool peak: {} flits in flight.", Global::flitPool().getPeakSize());
+    Logger::info("Ran {} router pipeline stages with the {} schedule on {} threads.", this->tick_count_,
+        Logger::stream_to_string<RouterScheduleType>(this->config_.getRouterSchedule()),
+        this->config_.getPipelineThreads());
+    Logger::info("Skipped {} idle cycles.", this->skipped_cycles_);
+    this->logTraceSyscalls();
+    this->flushEventTrace();
+    this->finishTelemetry();
+    Global::delaySink()->flush();
+}
+
+EventRecord Sim::eventRecord(const MessEvent& mesg) const {
+    EventRecord record{};
+    record.time = mesg.getEventStart();
+    record.type = static_cast<std::uint8_t>(mesg.getEventType());
+    record.packet_id = mesg.hasFlit() ? Global::flitPool().get(mesg.getFlit()).getPacketId() : -1;
+    // Only WIRE and CREDIT events are between routers.
+    record.src = mesg.getSrc() == INVALID_ROUTER_ID_ ? -1 : static_cast<std::int32_t>(mesg.getSrc());
+    record.des = mesg.getDes() == INVALID_ROUTER_ID_ ? -1 : static_cast<std::int32_t>(mesg.getDes());
+    record.pc = mesg.getPC();
+    record.vc = mesg.getVC();
+    return record;
+}
+
+void Sim::flushEventTrace() {
+    if (!this->event_trace_) {
+        return;
+    }
+    this->event_trace_->flush();
+    Logger::info("Recorded {} events to {}.", this->event_trace_->getCount(), this->event_trace_->getFname());
+}
+
+void Sim::sampleTelemetry(TimeType time) {
+    if (!this->telemetry_ || time < this->telemetry_next_) {
+        return;
+    }
+    this->recordTelemetry(this->telemetry_next_);
+    if (time >= this->telemetry_next_) {
+        TimeType period = this->config_.getReportPeriod();
+        this->recordTelemetry(this->telemetry_start_ + std::floor((time - this->telemetry_start_) / period) * period);
+    }
+}
+
+void Sim::recordTelemetry(TimeType end) {
+    TelemetryWindow& window = this->telemetry_window_;
+    TimeType length = end - this->telemetry_start_;
+    long port_count = this->config_.getPhysicalPortNumber();
+    for (std::size_t i = 0; i < this->inter_network_.size(); i++) {
+        BaseRouter& router = *this->inter_network_[i];
+        TelemetryTotals& totals = this->telemetry_totals_[i];
+
+        // The power getters return the energy so far, as in `getResults`.
+        double energy = router.getBufferPower();
+        window.buffer_power[i] = (energy - totals.buffer_energy) / length * POWER_NOM_;
+        totals.buffer_energy = energy;
+        energy = router.getCrossbarPower();
+        window.crossbar_power[i] = (energy - totals.crossbar_energy) / length * POWER_NOM_;
+        totals.crossbar_energy = energy;
+        energy = router.getArbiterPower();
+        window.arbiter_power[i] = (energy - totals.arbiter_energy) / length * POWER_NOM_;
+        totals.arbiter_energy = energy;
+        for (long port = 0; port < port_count; port++) {
+            energy = router.getLinkPower(port);
+            window.link_power[i * port_count + port] = (energy - totals.link_energy[port]) / length * POWER_NOM_;
+            totals.link_energy[port] = energy;
+        }
+
+        std::size_t packets = router.getAcceptedPackets() - totals.accepted_packets;
+        window.average_delay[i] = packets > 0 ? (router.getTotalDelay() - totals.total_delay) / packets : 0;
+        window.injected_flits[i] = router.getInjectedFlits() - totals.injected_flits;
+        window.accepted_flits[i] = router.getAcceptedFlits() - totals.accepted_flits;
+        window.accepted_packets[i] = packets;
+        window.input_flits[i] = router.getInputFlits();
+        window.output_flits[i] = router.getOutputFlits();
+        totals.total_delay = router.getTotalDelay();
+        totals.injected_flits = router.getInjectedFlits();
+        totals.accepted_flits = router.getAcceptedFlits();
+        totals.accepted_packets = router.getAcceptedPackets();
     }
+    this->telemetry_->record(this->telemetry_start_, end, window);
+    this->telemetry_start_ = end;
+    this->telemetry_next_ = end + this->config_.getReportPeriod();
 }
 
-void Sim::getResults() {
+void Sim::finishTelemetry() {
+    if (!this->telemetry_) {
+        return;
+    }
+    if (Global::getCurrTime() > this->telemetry_start_) {
+        this->recordTelemetry(Global::getCurrTime());
+    }
+    Logger::info("Recorded {} telemetry windows to {}.", this->telemetry_->getCount(), this->telemetry_->getFname());
+}
+
+void Sim::logTraceSyscalls() const {
+    std::size_t syscalls = Global::inputTrace()->getSyscallCount();
+    Logger::info("Made {} trace system calls, {:.3g} per cycle.",
+        syscalls, syscalls / std::max<TimeType>(Global::getCurrTime(), 1));
+}
+
+SimResults Sim::getResults() {
     double total_delay = 0;
     double total_mem_power = 0;
     double total_crossbar_power = 0;
@@ -373,4 +1052,15 @@ void Sim::getResults() {
         total_link_power * POWER_NOM_,
         total_power * POWER_NOM_
     );
+
+    return SimResults{
+        Global::getTotalFin(),
+        total_delay / Global::getTotalFin(),
+        total_mem_power * POWER_NOM_,
+        total_crossbar_power * POWER_NOM_,
+        total_arbiter_power * POWER_NOM_,
+        total_link_power * POWER_NOM_,
+        total_power * POWER_NOM_,
+        Global::inputTrace()->getSyscallCount()
+    };
 }
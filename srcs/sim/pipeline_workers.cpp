@@ -0,0 +1,103 @@
+# include "sim/pipeline_workers.h"
+# include "global.h"
+# include "global_defines/SStd.h"
+
+PipelineWorkers::PipelineWorkers(std::size_t worker_num)
+:   threads_(),
+    mutex_(),
+    start_cv_(),
+    done_cv_(),
+    task_(nullptr),
+    context_(nullptr),
+    active_(0),
+    pending_(0),
+    round_(0),
+    stop_(false),
+    errors_(worker_num)
+{
+    Sassert(worker_num > 0, "A worker pool needs at least one worker.");
+    for (std::size_t worker = 1; worker < worker_num; worker++) {
+        this->threads_.emplace_back(&PipelineWorkers::loop, this, worker);
+    }
+}
+
+PipelineWorkers::~PipelineWorkers() {
+    {
+        std::lock_guard<std::mutex> lock(this->mutex_);
+        this->stop_ = true;
+    }
+    this->start_cv_.notify_all();
+    for (auto& thread : this->threads_) {
+        thread.join();
+    }
+}
+
+std::size_t PipelineWorkers::size() const {
+    return this->threads_.size() + 1;
+}
+
+void PipelineWorkers::loop(std::size_t worker) {
+    std::size_t seen = 0;
+    while (true) {
+        const std::function<void(std::size_t)>* task = nullptr;
+        {
+            std::unique_lock<std::mutex> lock(this->mutex_);
+            this->start_cv_.wait(lock, [&]() {
+                return this->stop_ || (this->round_ != seen && worker < this->active_);
+            });
+            if (this->stop_) {
+                return;
+            }
+            seen = this->round_;
+            task = this->task_;
+            Global::context = this->context_;
+        }
+        try {
+            (*task)(worker);
+        } catch (...) {
+            this->errors_[worker] = std::current_exception();
+        }
+        {
+            std::lock_guard<std::mutex> lock(this->mutex_);
+            this->pending_ -= 1;
+        }
+        this->done_cv_.notify_one();
+    }
+}
+
+void PipelineWorkers::run(std::size_t worker_num, const std::function<void(std::size_t)>& task) {
+    Sassert(worker_num > 0 && worker_num <= this->size(), "Invalid number of workers.");
+    {
+        std::lock_guard<std::mutex> lock(this->mutex_);
+        this->task_ = &task;
+        this->context_ = Global::context;
+        this->active_ = worker_num;
+        this->pending_ = worker_num - 1;
+        this->round_ += 1;
+    }
+    this->start_cv_.notify_all();
+
+    try {
+        task(0);
+    } catch (...) {
+        this->errors_[0] = std::current_exception();
+    }
+
+    {
+        std::unique_lock<std::mutex> lock(this->mutex_);
+        this->done_cv_.wait(lock, [this]() {
+            return this->pending_ == 0;
+        });
+        this->task_ = nullptr;
+    }
+
+    for (auto& error : this->errors_) {
+        if (error) {
+            std::exception_ptr e = error;
+            for (auto& other : this->errors_) {
+                other = nullptr;
+            }
+            std::rethrow_exception(e);
+        }
+    }
+}
@@ -0,0 +1,238 @@
+# include <atomic>
+# include <chrono>
+# include <fstream>
+# include <optional>
+# include <thread>
+
+# include "sim/sweep.h"
+
+using json = nlohmann::json;
+
+Sweep::Sweep(const std::string& fname)
+:   points_(),
+    thread_num_(std::max(1u, std::thread::hardware_concurrency())),
+    log_fname_(),
+    summary_fname_(),
+    traces_(),
+    topologies_()
+{
+    std::ifstream ifs(fname);
+    if (!ifs) {
+        throw std::runtime_error("Cannot open sweep file: " + fname);
+    }
+    json spec;
+    ifs >> spec;
+
+    if (spec.is_array()) {
+        for (auto& point : spec) {
+            this->points_.push_back(point);
+        }
+    }
+    else if (spec.is_object()) {
+        json swept = spec.value("sweep", json::object());
+        this->points_.push_back(spec.value("base", json::object()));
+        // The swept keys come in alphabetical order, the first one varying slowest.
+        for (auto& [key, values] : swept.items()) {
+            if (!values.is_array() || values.empty()) {
+                throw std::runtime_error("The swept values of " + key + " should be a non-empty array");
+            }
+            std::vector<json> points;
+            for (auto& point : this->points_) {
+                for (auto& value : values) {
+                    points.push_back(point);
+                    points.back()[key] = value;
+                }
+            }
+            this->points_ = std::move(points);
+        }
+        if (spec.contains("threads")) {
+            long threads = spec["threads"].get<long>();
+            if (threads < 1) {
+                throw std::runtime_error("The number of sweep threads should be positive");
+            }
+            this->thread_num_ = threads;
+        }
+        this->log_fname_ = spec.value("log_file", std::string());
+        this->summary_fname_ = spec.value("summary_file", std::string());
+    }
+    else {
+        throw std::runtime_error("A sweep should be a JSON array or object");
+    }
+
+    if (this->log_fname_.empty() || this->summary_fname_.empty()) {
+        std::string prefix = std::string("logs/") + Logger::getCurrentTime() + ".sweep";
+        if (!std::filesystem::exists("logs")) {
+            std::filesystem::create_directories("logs");
+        }
+        if (this->log_fname_.empty()) {
+            this->log_fname_ = prefix + ".log";
+        }
+        if (this->summary_fname_.empty()) {
+            this->summary_fname_ = prefix + ".json";
+        }
+    }
+    this->setDelayFiles();
+}
+
+void Sweep::setDelayFiles() {
+    std::map<std::string, std::size_t> count;
+    for (auto& point : this->points_) {
+        if (point.is_object() && point.contains("delay_file")) {
+            count[point["delay_file"].get<std::string>()] += 1;
+        }
+        for (const char* key : {"event_trace", "telemetry_file"}) {
+            if (point.is_object() && point.contains(key)) {
+                count[point[key].get<std::string>()] += 1;
+            }
+        }
+    }
+    std::filesystem::path log_path(this->log_fname_);
+    for (std::size_t i = 0; i < this->points_.size(); i++) {
+        json& point = this->points_[i];
+        if (!point.is_object()) {
+            continue;
+        }
+        std::string index = std::to_string(i);
+        if (!point.contains("delay_file")) {
+            std::filesystem::path path(log_path);
+            path.replace_extension();
+            point["delay_file"] = path.string() + "." + index + ".delayinfo.txt";
+        }
+        else if (count[point["delay_file"].get<std::string>()] > 1) {
+            std::filesystem::path path(point["delay_file"].get<std::string>());
+            std::filesystem::path ext = path.extension();
+            path.replace_extension();
+            point["delay_file"] = path.string() + "." + index + ext.string();
+        }
+        for (const char* key : {"event_trace", "telemetry_file"}) {
+            if (point.contains(key) && count[point[key].get<std::string>()] > 1) {
+                std::filesystem::path path(point[key].get<std::string>());
+                std::filesystem::path ext = path.extension();
+                path.replace_extension();
+                point[key] = path.string() + "." + index + ext.string();
+            }
+        }
+    }
+}
+
+SimInputs Sweep::readInputs(const Config& config) {
+    if (config.isSyncProtocolEnable()) {
+        throw std::runtime_error("The sync protocol keeps its transactions in the process, "
+            "so it cannot be swept.");
+    }
+    SimInputs inputs;
+    // A trace ending with -1 may still be growing, and a streamed one is never held whole,
+    // so both are read by their own point.
+    if (!config.isEndWithMinus1() && config.getTraceWindow() == 0) {
+        auto key = std::make_tuple(config.getTraceFname(), config.getCubeNumber(), config.getAryNumber());
+        auto& trace = this->traces_[key];
+        if (!trace) {
+            trace = std::make_unique<InputTrace>(config.getTraceFname(), false,
+                std::make_shared<AddressTable>(config.getCubeNumber(), config.getAryNumber()));
+            trace->readTraceFile();
+        }
+        inputs.trace = trace.get();
+    }
+    if (config.getRoutingAlg() == RoutingType::GRAPH_TOPO) {
+        auto& topo = this->topologies_[config.getTopoFilePath()];
+        if (!topo) {
+            topo = std::make_unique<TopoInfo>(config.getTopoFilePath(), config.getRoutingCacheDir());
+        }
+        inputs.topo_info = topo.get();
+    }
+    return inputs;
+}
+
+SimResults Sweep::runPoint(const Config& config, const SimInputs& inputs) {
+    auto context = std::make_unique<Global::Context>();
+    Global::Context* outer = Global::context;
+    Global::context = context.get();
+    Global::CurrTime = 0;
+    try {
+        Sim sim(config, inputs);
+        sim.mainProcess();
+        SimResults results = sim.getResults();
+        Global::context = outer;
+        return results;
+    } catch (...) {
+        Global::context = outer;
+        throw;
+    }
+}
+
+void Sweep::run() {
+    Logger::setLoggerOut(this->log_fname_);
+    Logger::info("Sweeping {} points on {} threads.", this->points_.size(), this->thread_num_);
+
+    // Configurations and inputs are read up front, so that the points only share read-only state.
+    std::size_t point_num = this->points_.size();
+    std::vector<std::unique_ptr<Config>> configs(point_num);
+    std::vector<SimInputs> inputs(point_num);
+    std::vector<std::optional<SimResults>> results(point_num);
+    std::vector<std::string> errors(point_num);
+    std::vector<double> seconds(point_num, 0);
+    for (std::size_t i = 0; i < point_num; i++) {
+        try {
+            configs[i] = std::make_unique<Config>(this->points_[i]);
+            inputs[i] = this->readInputs(*configs[i]);
+        } catch (std::exception& e) {
+            configs[i].reset();
+            errors[i] = e.what();
+        }
+    }
+
+    std::atomic<std::size_t> next(0);
+    std::function<void(std::size_t)> task = [&](std::size_t) {
+        for (std::size_t i = next++; i < point_num; i = next++) {
+            if (!configs[i]) {
+                continue;
+            }
+            auto start = std::chrono::steady_clock::now();
+            try {
+                results[i] = this->runPoint(*configs[i], inputs[i]);
+            } catch (std::exception& e) {
+                errors[i] = e.what();
+            }
+            std::chrono::duration<double> wall_time = std::chrono::steady_clock::now() - start;
+            seconds[i] = wall_time.count();
+        }
+    };
+    std::size_t worker_num = std::max<std::size_t>(1, std::min(this->thread_num_, point_num));
+    PipelineWorkers workers(worker_num);
+    workers.run(worker_num, task);
+
+    json summary = json::array();
+    std::size_t failed = 0;
+    for (std::size_t i = 0; i < point_num; i++) {
+        json entry;
+        entry["config"] = this->points_[i];
+        if (results[i]) {
+            entry["results"] = {
+                {"finished", results[i]->finished},
+                {"average_delay", results[i]->average_delay},
+                {"memory_power", results[i]->memory_power},
+                {"crossbar_power", results[i]->crossbar_power},
+                {"arbiter_power", results[i]->arbiter_power},
+                {"link_power", results[i]->link_power},
+                {"total_power", results[i]->total_power},
+                {"trace_syscalls", results[i]->trace_syscalls}
+            };
+            entry["seconds"] = seconds[i];
+            Logger::info("Point {}: average delay {:.6g}, total power {:.6g}, in {:.3f} s.",
+                i, results[i]->average_delay, results[i]->total_power, seconds[i]);
+        }
+        else {
+            entry["error"] = errors[i];
+            failed++;
+            Logger::error("Point {}: {}", i, errors[i]);
+        }
+        summary.push_back(entry);
+    }
+
+    std::ofstream ofs(this->summary_fname_);
+    if (!ofs) {
+        throw std::runtime_error("Cannot open sweep summary file: " + this->summary_fname_);
+    }
+    ofs << summary.dump(4) << std::endl;
+    Logger::info("Swept {} points, {} failed, summary in {}.", point_num, failed, this->summary_fname_);
+}
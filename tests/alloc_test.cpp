@@ -0,0 +1,167 @@
+/**
+ * @file alloc_test.cpp
+ * @brief Check that the event loop makes no heap allocation once the network is warmed up.
+ * @note The global allocation functions are replaced by counting ones. Only the allocations made
+ *  while the simulated time is within the steady-state window count, so setting up the simulation,
+ *  reading the trace and reporting the results do not.
+ */
+
+# include <atomic>
+# include <cstdlib>
+# include <iostream>
+# include <memory>
+# include <new>
+# include <string>
+
+# include "global.h"
+# include "preprocess/config.h"
+# include "sim/Sim.h"
+
+/**
+ * @brief The steady-state window, the network fills up before it
+ */
+static constexpr TimeType WARM_UP_END = 2000;
+
+static constexpr TimeType SIM_LENGTH = 6000;
+
+static std::atomic<bool> counting(false);
+
+static std::atomic<std::size_t> allocation_count(0);
+
+static std::atomic<std::size_t> allocation_bytes(0);
+
+static void* countedAlloc(std::size_t size) {
+    // `CurrTime` is thread local, so the logger and the delay writer threads, which stay at 0, do not count.
+    if (counting.load(std::memory_order_relaxed)
+        && Global::CurrTime >= WARM_UP_END && Global::CurrTime < SIM_LENGTH
+    ) {
+        allocation_count.fetch_add(1, std::memory_order_relaxed);
+        allocation_bytes.fetch_add(size, std::memory_order_relaxed);
+    }
+    void* ptr = std::malloc(size == 0 ? 1 : size);
+    if (ptr == nullptr) {
+        throw std::bad_alloc();
+    }
+    return ptr;
+}
+
+void* operator new(std::size_t size) {
+    return countedAlloc(size);
+}
+
+void* operator new[](std::size_t size) {
+    return countedAlloc(size);
+}
+
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept {
+    try {
+        return countedAlloc(size);
+    } catch (const std::bad_alloc&) {
+        return nullptr;
+    }
+}
+
+void* operator new[](std::size_t size, const std::nothrow_t&) noexcept {
+    try {
+        return countedAlloc(size);
+    } catch (const std::bad_alloc&) {
+        return nullptr;
+    }
+}
+
+void operator delete(void* ptr) noexcept {
+    std::free(ptr);
+}
+
+void operator delete[](void* ptr) noexcept {
+    std::free(ptr);
+}
+
+void operator delete(void* ptr, std::size_t) noexcept {
+    std::free(ptr);
+}
+
+void operator delete[](void* ptr, std::size_t) noexcept {
+    std::free(ptr);
+}
+
+/**
+ * @brief Run a simulation and count the allocations of its steady state
+ * @param name The name of the run
+ * @param config The configuration, without the files
+ * @return Whether no allocation was counted
+ */
+static bool run(const std::string& name, nlohmann::json config,
+    const std::string& trace_fname, const std::string& work_dir)
+{
+    config["trace_file"] = trace_fname;
+    config["delay_file"] = work_dir + "/" + name + ".delay";
+    config["time"] = SIM_LENGTH;
+
+    Config sim_config(config);
+    // Every run gets its own context, as the points of a sweep do.
+    auto context = std::make_unique<Global::Context>();
+    Global::Context* outer = Global::context;
+    Global::context = context.get();
+    Global::CurrTime = 0;
+
+    SimResults results;
+    {
+        Sim sim(sim_config);
+        allocation_count = 0;
+        allocation_bytes = 0;
+        counting = true;
+        sim.mainProcess();
+        counting = false;
+        results = sim.getResults();
+    }
+    Global::context = outer;
+
+    std::cout << name << ": " << results.finished << " packets finished, "
+        << allocation_count << " allocations (" << allocation_bytes << " bytes) in ["
+        << WARM_UP_END << ", " << SIM_LENGTH << ")" << std::endl;
+    return allocation_count == 0 && results.finished > 0;
+}
+
+int main(int argc, char* argv[]) {
+    if (argc != 3) {
+        std::cerr << "usage: " << argv[0] << " <trace of a 9x9 mesh> <work directory>" << std::endl;
+        return 2;
+    }
+    std::string trace_fname = argv[1];
+    std::string work_dir = argv[2];
+
+    nlohmann::json base = {
+        {"vertices", 9},
+        {"dimension", 2},
+        {"vc_cnt", 4},
+        {"input_buffer", 12},
+        {"output_buffer", 12},
+        {"flit_size", 4},
+        {"link_length", 1000},
+        {"random_seed", 1},
+        {"routing_algorithm", "XY"}
+    };
+
+    bool ok = true;
+    Logger::setLoggerOut(work_dir + "/alloc_test.log");
+    try {
+        ok = run("calendar", base, trace_fname, work_dir) && ok;
+
+        nlohmann::json heap = base;
+        heap["event_queue"] = "HEAP";
+        ok = run("heap", heap, trace_fname, work_dir) && ok;
+
+        nlohmann::json activity = base;
+        activity["power_mode"] = "ACTIVITY";
+        ok = run("activity", activity, trace_fname, work_dir) && ok;
+    } catch (const std::exception& e) {
+        std::cerr << e.what() << std::endl;
+        return 1;
+    }
+    if (!ok) {
+        std::cerr << "The event loop allocated in its steady state." << std::endl;
+        return 1;
+    }
+    return 0;
+}
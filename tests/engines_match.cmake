@@ -0,0 +1,68 @@
+# Run a trace with the pipeline workers and with the partitioned engine, and check that
+# the delays and the summaries (finished packets, average delay, power) are the same.
+#
+# cmake -DPOPNET=<popnet> -DSOURCE_DIR=<repo> -DWORK_DIR=<dir> -P engines_match.cmake
+#
+# The run is cut by the simulation length while packets are still in flight, so that
+# the final time, which the power is divided by, is checked as well.
+
+foreach(var POPNET SOURCE_DIR WORK_DIR)
+    if(NOT DEFINED ${var})
+        message(FATAL_ERROR "${var} is not set.")
+    endif()
+endforeach()
+
+file(MAKE_DIRECTORY ${WORK_DIR})
+
+function(run_popnet name engine_key engine_value)
+    file(WRITE ${WORK_DIR}/${name}.json "{
+    \"vertices\": 9,
+    \"dimension\": 2,
+    \"vc_cnt\": 4,
+    \"input_buffer\": 12,
+    \"output_buffer\": 12,
+    \"flit_size\": 4,
+    \"link_length\": 1000,
+    \"time\": 3000,
+    \"random_seed\": 1,
+    \"routing_algorithm\": \"XY\",
+    \"trace_file\": \"${SOURCE_DIR}/tests/random_trace/bench\",
+    \"log_file\": \"${WORK_DIR}/${name}.log\",
+    \"delay_file\": \"${WORK_DIR}/${name}.delay\",
+    \"${engine_key}\": ${engine_value}
+}
+")
+    file(REMOVE ${WORK_DIR}/${name}.log ${WORK_DIR}/${name}.delay)
+    execute_process(
+        COMMAND ${POPNET} -JSON ${WORK_DIR}/${name}.json
+        RESULT_VARIABLE result
+        OUTPUT_QUIET
+    )
+    if(NOT result EQUAL 0)
+        message(FATAL_ERROR "popnet failed on ${name}.json: ${result}")
+    endif()
+
+    file(STRINGS ${WORK_DIR}/${name}.log summary REGEX "^Total |^Average delay")
+    list(LENGTH summary count)
+    if(count EQUAL 0)
+        message(FATAL_ERROR "No summary in ${name}.log.")
+    endif()
+    # The partitions write the delays of a window in partition order.
+    file(STRINGS ${WORK_DIR}/${name}.delay delays)
+    list(SORT delays)
+    set(${name}_summary "${summary}" PARENT_SCOPE)
+    set(${name}_delays "${delays}" PARENT_SCOPE)
+endfunction()
+
+run_popnet(threads pipeline_threads 4)
+run_popnet(partitions partitions 3)
+
+if(NOT threads_delays STREQUAL partitions_delays)
+    message(FATAL_ERROR "The partitioned engine wrote other delays than the pipeline workers.")
+endif()
+string(REPLACE ";" "\n" threads_summary "${threads_summary}")
+string(REPLACE ";" "\n" partitions_summary "${partitions_summary}")
+if(NOT threads_summary STREQUAL partitions_summary)
+    message(FATAL_ERROR "The summaries differ.\npipeline workers:\n${threads_summary}\npartitions:\n${partitions_summary}")
+endif()
+message(STATUS "The pipeline workers and the partitions agree:\n${threads_summary}")
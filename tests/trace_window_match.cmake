@@ -0,0 +1,65 @@
+# Run a trace read whole and streamed with a small window, and check that the delay files
+# and the summaries are the same.
+#
+# cmake -DPOPNET=<popnet> -DSOURCE_DIR=<repo> -DWORK_DIR=<dir> -P trace_window_match.cmake
+#
+# The window is much shorter than the bursts of the trace, so that routers out of packets
+# read ahead to their next ones.
+
+foreach(var POPNET SOURCE_DIR WORK_DIR)
+    if(NOT DEFINED ${var})
+        message(FATAL_ERROR "${var} is not set.")
+    endif()
+endforeach()
+
+file(MAKE_DIRECTORY ${WORK_DIR})
+
+function(run_popnet name window)
+    file(WRITE ${WORK_DIR}/${name}.json "{
+    \"vertices\": 9,
+    \"dimension\": 2,
+    \"vc_cnt\": 4,
+    \"input_buffer\": 12,
+    \"output_buffer\": 12,
+    \"flit_size\": 4,
+    \"link_length\": 1000,
+    \"time\": 3000,
+    \"random_seed\": 1,
+    \"routing_algorithm\": \"XY\",
+    \"trace_file\": \"${SOURCE_DIR}/tests/random_trace/bench\",
+    \"log_file\": \"${WORK_DIR}/${name}.log\",
+    \"delay_file\": \"${WORK_DIR}/${name}.delay\",
+    \"trace_window\": ${window}
+}
+")
+    file(REMOVE ${WORK_DIR}/${name}.log ${WORK_DIR}/${name}.delay)
+    execute_process(
+        COMMAND ${POPNET} -JSON ${WORK_DIR}/${name}.json
+        RESULT_VARIABLE result
+        OUTPUT_QUIET
+    )
+    if(NOT result EQUAL 0)
+        message(FATAL_ERROR "popnet failed on ${name}.json: ${result}")
+    endif()
+
+    file(STRINGS ${WORK_DIR}/${name}.log summary REGEX "^Total |^Average delay")
+    list(LENGTH summary count)
+    if(count EQUAL 0)
+        message(FATAL_ERROR "No summary in ${name}.log.")
+    endif()
+    file(READ ${WORK_DIR}/${name}.delay delays)
+    string(REPLACE ";" "\n" summary "${summary}")
+    set(${name}_summary "${summary}" PARENT_SCOPE)
+    set(${name}_delays "${delays}" PARENT_SCOPE)
+endfunction()
+
+run_popnet(whole 0)
+run_popnet(window 50)
+
+if(NOT whole_delays STREQUAL window_delays)
+    message(FATAL_ERROR "The streamed trace wrote other delays than the trace read whole.")
+endif()
+if(NOT whole_summary STREQUAL window_summary)
+    message(FATAL_ERROR "The summaries differ.\nread whole:\n${whole_summary}\nstreamed:\n${window_summary}")
+endif()
+message(STATUS "The streamed trace and the trace read whole agree:\n${whole_summary}")
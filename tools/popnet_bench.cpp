@@ -0,0 +1,197 @@
+/**
+ * @file popnet_bench.cpp
+ * @brief Microbenchmarks of the data structures on the hot path of the simulation loop.
+ */
+
+# include <chrono>
+# include <cmath>
+# include <functional>
+# include <iostream>
+# include <list>
+# include <random>
+# include <sstream>
+# include <stdexcept>
+# include <string>
+
+# include "global_defines/message_define.h"
+# include "global_defines/ring_buffer.h"
+
+/**
+ * @brief Time a benchmark, printing the cost of one operation
+ * @param name The name of the benchmark
+ * @param count The number of operations
+ * @param run The benchmark
+ */
+static void benchOps(const std::string& name, std::size_t count, const std::function<void()>& run) {
+    auto start = std::chrono::steady_clock::now();
+    run();
+    std::chrono::duration<double> seconds = std::chrono::steady_clock::now() - start;
+    std::cout << name << ": " << count << " operations in " << seconds.count() << " s, "
+        << seconds.count() * 1e9 / count << " ns/operation" << std::endl;
+}
+
+/**
+ * @brief Get a random time ahead, on the grid of the calendar buckets
+ */
+static TimeType randomDelay(std::mt19937_64& gen, long max_cycles) {
+    return std::uniform_int_distribution<long>(0, max_cycles)(gen) * PIPE_DELAY_;
+}
+
+/**
+ * @brief Fill a queue as a loaded mesh would: the routing clock, flits on the wires, credits and the next packet.
+ */
+static void fillQueue(MessQueue& queue, std::mt19937_64& gen, std::size_t router_num) {
+    queue.addMessage(MessEvent(0, MessType::ROUTER, PIPE_DELAY_));
+    for (std::size_t i = 0; i < router_num; i++) {
+        RouterId id = static_cast<RouterId>(i);
+        queue.addMessage(MessEvent(randomDelay(gen, 4) + WIRE_DELAY_, MessType::WIRE, id, id, 1, 0));
+        queue.addMessage(MessEvent(randomDelay(gen, 4) + CREDIT_DELAY_, MessType::CREDIT, id, id, 1, 0));
+    }
+    queue.addMessage(MessEvent(randomDelay(gen, 100), MessType::EVG));
+}
+
+/**
+ * @brief Compare the event queue engines on the event mix of a mesh
+ * @param router_num The number of routers, each with a flit and a credit in flight
+ * @param event_num The number of events popped
+ * @note Every popped event schedules its successor, so that the queue keeps its size:
+ *  a flit its credit, a credit the next flit, the clock its next cycle and a packet the next packet.
+ *  The lookups by type are those of the fast-forward, which looks for the next packet.
+ */
+static void benchQueue(std::size_t router_num, std::size_t event_num) {
+    for (EventQueueType type : {EventQueueType::HEAP, EventQueueType::CALENDAR}) {
+        std::mt19937_64 gen(1);
+        MessQueue queue;
+        queue.setEngine(type);
+        fillQueue(queue, gen, router_num);
+
+        std::ostringstream name;
+        name << type << ", " << queue.size() << " events";
+        benchOps(name.str() + ", pop and push", event_num, [&]() {
+            for (std::size_t i = 0; i < event_num; i++) {
+                MessEvent event = queue.takeFront();
+                TimeType t = event.getEventStart();
+                switch (event.getEventType()) {
+                    case MessType::WIRE:
+                        queue.addMessage(MessEvent(t + CREDIT_DELAY_, MessType::CREDIT,
+                            event.getDes(), event.getSrc(), event.getPC(), event.getVC()));
+                        break;
+                    case MessType::CREDIT:
+                        queue.addMessage(MessEvent(t + randomDelay(gen, 3) + WIRE_DELAY_, MessType::WIRE,
+                            event.getDes(), event.getSrc(), event.getPC(), event.getVC()));
+                        break;
+                    case MessType::ROUTER:
+                        queue.addMessage(MessEvent(t + event.getRoutingPeriod(), MessType::ROUTER,
+                            event.getRoutingPeriod()));
+                        break;
+                    default:
+                        queue.addMessage(MessEvent(t + randomDelay(gen, 100), MessType::EVG));
+                        break;
+                }
+            }
+        });
+
+        std::size_t lookup_num = event_num / 10;
+        TimeType sum = 0;
+        benchOps(name.str() + ", top by type", lookup_num, [&]() {
+            for (std::size_t i = 0; i < lookup_num; i++) {
+                sum += queue.getTop(MessType::EVG).getEventStart();
+            }
+        });
+        // Keeps the lookups from being optimized out.
+        if (std::isnan(sum)) {
+            std::cout << sum << std::endl;
+        }
+    }
+}
+
+/**
+ * @brief Move flits around a loop of buffers, each hop popping a flit from a buffer and pushing it to the next
+ * @tparam Buffer The buffer type
+ * @param name The name of the buffer type
+ * @param make The factory of an empty buffer
+ * @param buffer_num The number of buffers, as many as the VCs along a path
+ * @param buffer_size The size of a buffer, half of which is filled
+ * @param hop_num The number of hops
+ */
+template<typename Buffer>
+static void benchHops(const std::string& name, const std::function<Buffer()>& make,
+    std::size_t buffer_num, std::size_t buffer_size, std::size_t hop_num)
+{
+    std::vector<Buffer> buffers;
+    buffers.reserve(buffer_num);
+    FlitHandle flit = 0;
+    for (std::size_t i = 0; i < buffer_num; i++) {
+        buffers.push_back(make());
+        for (std::size_t j = 0; j < buffer_size / 2 + 1; j++) {
+            buffers[i].push_back(flit++);
+        }
+    }
+    FlitHandle sum = 0;
+    benchOps(name + ", " + std::to_string(buffer_num) + " buffers of " + std::to_string(buffer_size) + " flits",
+        hop_num, [&]() {
+        std::size_t from = 0;
+        for (std::size_t i = 0; i < hop_num; i++) {
+            std::size_t to = from + 1 == buffer_num ? 0 : from + 1;
+            FlitHandle head = buffers[from].front();
+            buffers[from].pop_front();
+            buffers[to].push_back(head);
+            sum += head;
+            from = to;
+        }
+    });
+    // Keeps the hops from being optimized out.
+    if (sum == INVALID_FLIT_HANDLE_) {
+        std::cout << sum << std::endl;
+    }
+}
+
+/**
+ * @brief Compare the `std::list` formerly used by the router buffers with `RingBuffer`
+ */
+static void benchBuffer(std::size_t buffer_size, std::size_t hop_num) {
+    // A 16x16 mesh has 256 routers of 5 ports with 4 VCs.
+    std::size_t buffer_num = 256 * 5 * 4;
+    benchHops<std::list<FlitHandle>>("std::list", []() {
+        return std::list<FlitHandle>();
+    }, buffer_num, buffer_size, hop_num);
+    benchHops<RingBuffer<FlitHandle>>("RingBuffer", [&]() {
+        return RingBuffer<FlitHandle>(buffer_size);
+    }, buffer_num, buffer_size, hop_num);
+}
+
+int main(int argc, char *argv []) {
+    std::string usage = std::string("usage: ") + argv[0] + " queue [routers] [events]\n"
+        + "  compares the event queue engines, 256 routers and 10000000 events by default\n"
+        + "       " + argv[0] + " buffer [buffer size] [hops]\n"
+        + "  compares the router buffers, 12 flits and 10000000 hops by default\n";
+    std::string command = argc > 1 ? argv[1] : "";
+    bool valid_queue = command == "queue" && argc <= 4;
+    bool valid_buffer = command == "buffer" && argc <= 4;
+    if (!valid_queue && !valid_buffer) {
+        std::cerr << usage;
+        return 1;
+    }
+    try {
+        if (valid_queue) {
+            long routers = argc > 2 ? std::stol(argv[2]) : 256;
+            long events = argc > 3 ? std::stol(argv[3]) : 10000000;
+            if (routers < 1 || events < 1) {
+                throw std::runtime_error("The numbers of routers and events should be positive");
+            }
+            benchQueue(routers, events);
+        }
+        else {
+            long buffer_size = argc > 2 ? std::stol(argv[2]) : 12;
+            long hops = argc > 3 ? std::stol(argv[3]) : 10000000;
+            if (buffer_size < 1 || hops < 1) {
+                throw std::runtime_error("The buffer size and the number of hops should be positive");
+            }
+            benchBuffer(buffer_size, hops);
+        }
+    } catch (std::exception& e) {
+        std::cerr << e.what() << std::endl;
+        return 1;
+    }
+    return 0;
+}
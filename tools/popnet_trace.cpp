@@ -0,0 +1,401 @@
+/**
+ * @file popnet_trace.cpp
+ * @brief Tools for the trace files of the simulator.
+ */
+
+# include <chrono>
+# include <cstring>
+# include <fstream>
+# include <algorithm>
+# include <functional>
+# include <iomanip>
+# include <iostream>
+# include <limits>
+# include <numeric>
+# include <string>
+# include <thread>
+
+# include "global_defines/binary_trace.h"
+# include "global_defines/delay_sink.h"
+# include "global_defines/event_trace.h"
+# include "global_defines/mapped_file.h"
+# include "global_defines/telemetry.h"
+# include "global_defines/trace_parser.h"
+
+static long readDimension(const char* arg) {
+    long dimension = std::stol(arg);
+    if (dimension < 1 || dimension > MAX_DIMENSION_) {
+        throw std::runtime_error("The dimension should be in [1, " + std::to_string(MAX_DIMENSION_) + "]");
+    }
+    return dimension;
+}
+
+/**
+ * @brief Time a parser of a text trace, printing its throughput
+ * @param name The name of the parser
+ * @param parse The parser, returning the number of records
+ */
+static void benchParser(const std::string& name, const std::function<std::size_t()>& parse) {
+    auto start = std::chrono::steady_clock::now();
+    std::size_t count = parse();
+    std::chrono::duration<double> seconds = std::chrono::steady_clock::now() - start;
+    std::cout << name << ": " << count << " lines in " << seconds.count() << " s, "
+        << static_cast<std::size_t>(count / seconds.count()) << " lines/s" << std::endl;
+}
+
+/**
+ * @brief Compare the stream reader formerly used by `InputTrace` with `TextTraceParser`
+ */
+static void bench(const std::string& fname, std::size_t dimension, std::size_t thread_num) {
+    benchParser("ifstream", [&]() {
+        std::ifstream ifs(fname);
+        std::size_t count = 0;
+        TimeType start_time;
+        long value;
+        while (ifs >> start_time && start_time != -1) {
+            for (std::size_t i = 0; i < 2 * dimension + 1; i++) {
+                ifs >> value;
+            }
+            count++;
+        }
+        return count;
+    });
+    for (std::size_t threads : {std::size_t(1), thread_num}) {
+        benchParser("parser, " + std::to_string(threads) + " threads", [&]() {
+            MappedFile file(fname);
+            TraceRecords records;
+            bool end_mark = false;
+            TextTraceParser(dimension, false, threads).parse(file.data(), file.size(), records, end_mark);
+            return records.size();
+        });
+    }
+}
+
+/**
+ * @brief Read a value of a binary delay file or event trace
+ */
+template<typename T>
+static T readValue(const char*& p, const char* end) {
+    T value;
+    if (end - p < static_cast<std::ptrdiff_t>(sizeof(T))) {
+        throw std::runtime_error("Truncated binary file");
+    }
+    std::memcpy(&value, p, sizeof(T));
+    p += sizeof(T);
+    return value;
+}
+
+/**
+ * @brief Print a binary delay file in the text format of the simulator
+ */
+static void printDelays(const std::string& fname) {
+    MappedFile file(fname);
+    const char* p = file.data();
+    const char* end = p + file.size();
+    DelayFileHeader header = readValue<DelayFileHeader>(p, end);
+    if (std::memcmp(header.magic, DELAY_SINK_MAGIC_, sizeof(header.magic)) != 0
+        || header.version != DELAY_SINK_VERSION_
+    ) {
+        throw std::runtime_error("Invalid binary delay file: " + fname);
+    }
+    while (p != end) {
+        DelayRecordKind kind = readValue<DelayRecordKind>(p, end);
+        std::cout << readValue<std::int64_t>(p, end) << ' ';
+        for (std::size_t i = 0; i < 2 * header.dimension; i++) {
+            std::cout << readValue<std::int32_t>(p, end) << ' ';
+        }
+        if (kind == DelayRecordKind::PACKET) {
+            std::cout << readValue<double>(p, end) << '\n';
+            continue;
+        }
+        std::cout << readValue<std::int64_t>(p, end);
+        std::uint32_t count = readValue<std::uint32_t>(p, end);
+        std::cout << ' ' << count;
+        for (std::uint32_t i = 0; i < count; i++) {
+            std::cout << ' ' << readValue<std::int64_t>(p, end);
+        }
+        std::cout << (kind == DelayRecordKind::TRANSACTION_INJECTED ? " -1\n" : "\n");
+    }
+}
+
+/**
+ * @brief Which records of an event trace are printed
+ */
+struct EventFilter {
+
+    /**
+     * @brief Keep the events sent or received by this router, or -1 for all
+     */
+    long router = -1;
+
+    /**
+     * @brief Keep the events carrying a flit of this packet, or -1 for all
+     */
+    long long packet = -1;
+
+    double from = -std::numeric_limits<double>::infinity();
+
+    double to = std::numeric_limits<double>::infinity();
+
+    bool matches(const EventRecord& record) const {
+        return (this->router < 0 || record.src == this->router || record.des == this->router)
+            && (this->packet < 0 || record.packet_id == this->packet)
+            && record.time >= this->from && record.time <= this->to;
+    }
+
+};
+
+static const char* eventTypeName(std::uint8_t type) {
+    static const char* names[] = {"EVG", "ROUTER", "WIRE", "CREDIT", "RECONFIGURATION"};
+    return type < sizeof(names) / sizeof(names[0]) ? names[type] : "UNKNOWN";
+}
+
+/**
+ * @brief Print the records of an event trace in time order, as CSV or as a Chrome trace
+ * @note In a Chrome trace (chrome://tracing, Perfetto), the events of a router are on the thread of
+ *  its index, WIRE and CREDIT events on the receiving router, and the others on a "network" thread.
+ */
+static void printEvents(const std::string& fname, const EventFilter& filter, bool chrome) {
+    MappedFile file(fname);
+    const char* p = file.data();
+    const char* end = p + file.size();
+    EventTraceHeader header = readValue<EventTraceHeader>(p, end);
+    if (std::memcmp(header.magic, EVENT_TRACE_MAGIC_, sizeof(header.magic)) != 0
+        || header.version != EVENT_TRACE_VERSION_ || (end - p) % sizeof(EventRecord) != 0
+    ) {
+        throw std::runtime_error("Invalid event trace: " + fname);
+    }
+    std::vector<EventRecord> records;
+    while (p != end) {
+        EventRecord record = readValue<EventRecord>(p, end);
+        if (filter.matches(record)) {
+            records.push_back(record);
+        }
+    }
+    // The partitioned engine records a time window partition by partition.
+    std::stable_sort(records.begin(), records.end(), [](const EventRecord& a, const EventRecord& b) {
+        return a.time < b.time;
+    });
+
+    std::cout << std::setprecision(15);
+    if (!chrome) {
+        std::cout << "time,type,src,des,pc,vc,packet\n";
+        for (auto& record : records) {
+            std::cout << record.time << ',' << eventTypeName(record.type) << ',' << record.src << ','
+                << record.des << ',' << record.pc << ',' << record.vc << ',' << record.packet_id << '\n';
+        }
+        return;
+    }
+    std::cout << "{\"traceEvents\": [\n";
+    std::cout << "{\"name\": \"thread_name\", \"ph\": \"M\", \"pid\": 0, \"tid\": " << header.router_count
+        << ", \"args\": {\"name\": \"network\"}}";
+    for (auto& record : records) {
+        long tid = record.des >= 0 ? record.des : header.router_count;
+        std::cout << ",\n{\"name\": \"" << eventTypeName(record.type) << "\", \"ph\": \"i\", \"s\": \"t\", "
+            << "\"ts\": " << record.time << ", \"pid\": 0, \"tid\": " << tid << ", \"args\": {"
+            << "\"src\": " << record.src << ", \"pc\": " << record.pc << ", \"vc\": " << record.vc
+            << ", \"packet\": " << record.packet_id << "}}";
+    }
+    std::cout << "\n]}\n";
+}
+
+/**
+ * @brief Read a column of a telemetry window
+ */
+template<typename T>
+static std::vector<T> readColumn(const char*& p, const char* end, std::size_t size) {
+    std::vector<T> column(size);
+    if (static_cast<std::size_t>(end - p) < size * sizeof(T)) {
+        throw std::runtime_error("Truncated binary file");
+    }
+    std::memcpy(column.data(), p, size * sizeof(T));
+    p += size * sizeof(T);
+    return column;
+}
+
+/**
+ * @brief Print a telemetry file as CSV, a row per router and window, or per link and window
+ * @param fname The telemetry file
+ * @param router The router whose rows are printed, or -1 for all
+ * @param links Whether the power of every link is printed instead of the activity of the routers
+ */
+static void printTelemetry(const std::string& fname, long router, bool links) {
+    MappedFile file(fname);
+    const char* p = file.data();
+    const char* end = p + file.size();
+    TelemetryHeader header = readValue<TelemetryHeader>(p, end);
+    if (std::memcmp(header.magic, TELEMETRY_MAGIC_, sizeof(header.magic)) != 0
+        || header.version != TELEMETRY_VERSION_
+    ) {
+        throw std::runtime_error("Invalid telemetry file: " + fname);
+    }
+    std::size_t routers = header.router_count;
+    std::size_t ports = header.port_count;
+
+    std::cout << std::setprecision(15);
+    if (links) {
+        std::cout << "start,end,router,port,link_power\n";
+    }
+    else {
+        std::cout << "start,end,router,buffer_power,crossbar_power,arbiter_power,link_power,average_delay,"
+            << "injected_flits,accepted_flits,accepted_packets,input_flits,output_flits\n";
+    }
+    while (p != end) {
+        TelemetryWindowHeader window = readValue<TelemetryWindowHeader>(p, end);
+        TelemetryWindow columns;
+        columns.buffer_power = readColumn<double>(p, end, routers);
+        columns.crossbar_power = readColumn<double>(p, end, routers);
+        columns.arbiter_power = readColumn<double>(p, end, routers);
+        columns.link_power = readColumn<double>(p, end, routers * ports);
+        columns.average_delay = readColumn<double>(p, end, routers);
+        columns.injected_flits = readColumn<std::uint32_t>(p, end, routers);
+        columns.accepted_flits = readColumn<std::uint32_t>(p, end, routers);
+        columns.accepted_packets = readColumn<std::uint32_t>(p, end, routers);
+        columns.input_flits = readColumn<std::uint32_t>(p, end, routers);
+        columns.output_flits = readColumn<std::uint32_t>(p, end, routers);
+
+        for (std::size_t i = 0; i < routers; i++) {
+            if (router >= 0 && static_cast<std::size_t>(router) != i) {
+                continue;
+            }
+            auto first_link = columns.link_power.begin() + i * ports;
+            if (links) {
+                for (std::size_t port = 1; port < ports; port++) {
+                    std::cout << window.start << ',' << window.end << ',' << i << ',' << port << ','
+                        << first_link[port] << '\n';
+                }
+                continue;
+            }
+            std::cout << window.start << ',' << window.end << ',' << i << ','
+                << columns.buffer_power[i] << ',' << columns.crossbar_power[i] << ','
+                << columns.arbiter_power[i] << ',' << std::accumulate(first_link, first_link + ports, 0.0) << ','
+                << columns.average_delay[i] << ',' << columns.injected_flits[i] << ','
+                << columns.accepted_flits[i] << ',' << columns.accepted_packets[i] << ','
+                << columns.input_flits[i] << ',' << columns.output_flits[i] << '\n';
+        }
+    }
+}
+
+/**
+ * @brief Read the options of the telemetry command
+ * @param argc The number of arguments
+ * @param argv The arguments, the options starting at the fourth
+ * @param router The router whose rows are printed
+ * @param links Whether the links are printed
+ * @return false if the options are invalid
+ */
+static bool readTelemetryOptions(int argc, char *argv [], long& router, bool& links) {
+    try {
+        for (int i = 3; i < argc; i++) {
+            std::string option = argv[i];
+            if (option == "-r" && i + 1 < argc) {
+                router = std::stol(argv[++i]);
+            }
+            else if (option == "-l") {
+                links = true;
+            }
+            else {
+                return false;
+            }
+        }
+    } catch (std::exception&) {
+        return false;
+    }
+    return true;
+}
+
+/**
+ * @brief Read the options of the events command
+ * @param argc The number of arguments
+ * @param argv The arguments, the options starting at the fourth
+ * @param filter The filter
+ * @param chrome Whether a Chrome trace is printed
+ * @return false if the options are invalid
+ */
+static bool readEventOptions(int argc, char *argv [], EventFilter& filter, bool& chrome) {
+    try {
+        for (int i = 3; i < argc; i++) {
+            std::string option = argv[i];
+            if (option == "-r" && i + 1 < argc) {
+                filter.router = std::stol(argv[++i]);
+            }
+            else if (option == "-k" && i + 1 < argc) {
+                filter.packet = std::stoll(argv[++i]);
+            }
+            else if (option == "-t" && i + 2 < argc) {
+                filter.from = std::stod(argv[++i]);
+                filter.to = std::stod(argv[++i]);
+            }
+            else if (option == "-o" && i + 1 < argc) {
+                std::string format = argv[++i];
+                if (format != "csv" && format != "chrome") {
+                    return false;
+                }
+                chrome = format == "chrome";
+            }
+            else {
+                return false;
+            }
+        }
+    } catch (std::exception&) {
+        return false;
+    }
+    return true;
+}
+
+int main(int argc, char *argv []) {
+    std::string usage = std::string("usage: ") + argv[0]
+        + " convert <text trace> <binary trace> <dimension> [-P]\n"
+        + "  -P: the text trace holds the transactions of the sync protocol\n"
+        + "       " + argv[0] + " bench <text trace> <dimension> [threads]\n"
+        + "  threads: the threads of the parallel parser, one per core by default\n"
+        + "       " + argv[0] + " delays <binary delay file>\n"
+        + "  prints a binary delay file as text\n"
+        + "       " + argv[0] + " events <event trace> [-r router] [-k packet] [-t from to] [-o csv|chrome]\n"
+        + "  prints the events of a router, of a packet or within a time window, as CSV by default\n"
+        + "       " + argv[0] + " telemetry <telemetry file> [-r router] [-l]\n"
+        + "  prints the activity of the routers per report period as CSV, or with -l the power of their links\n";
+    std::string command = argc > 1 ? argv[1] : "";
+    bool valid_convert = command == "convert" && (argc == 5 || (argc == 6 && std::string(argv[5]) == "-P"));
+    bool valid_bench = command == "bench" && (argc == 4 || argc == 5);
+    bool valid_delays = command == "delays" && argc == 3;
+    EventFilter filter;
+    bool chrome = false;
+    bool valid_events = command == "events" && argc >= 3 && readEventOptions(argc, argv, filter, chrome);
+    long router = -1;
+    bool links = false;
+    bool valid_telemetry = command == "telemetry" && argc >= 3 && readTelemetryOptions(argc, argv, router, links);
+    if (!valid_convert && !valid_bench && !valid_delays && !valid_events && !valid_telemetry) {
+        std::cerr << usage;
+        return 1;
+    }
+    try {
+        if (valid_convert) {
+            std::size_t count = BinaryTrace::convert(argv[2], argv[3], readDimension(argv[4]), argc == 6);
+            std::cout << "Converted " << count << " packets." << std::endl;
+        }
+        else if (valid_delays) {
+            printDelays(argv[2]);
+        }
+        else if (valid_events) {
+            printEvents(argv[2], filter, chrome);
+        }
+        else if (valid_telemetry) {
+            printTelemetry(argv[2], router, links);
+        }
+        else {
+            long threads = argc == 5 ? std::stol(argv[4]) : 0;
+            if (threads < 0) {
+                throw std::runtime_error("The number of threads should not be negative");
+            }
+            if (threads == 0) {
+                threads = std::max(1u, std::thread::hardware_concurrency());
+            }
+            bench(argv[2], readDimension(argv[3]), threads);
+        }
+    } catch (std::exception& e) {
+        std::cerr << e.what() << std::endl;
+        return 1;
+    }
+    return 0;
+}